@@ -0,0 +1,624 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   fti_bench.c
+ *  @date   October, 2026
+ *  @brief  Checkpoint/restart benchmark for FTI.
+ *
+ *  Drives FTI_Checkpoint and FTI_Recover over a matrix of checkpoint levels,
+ *  I/O modes and dCP on/off for a synthetic set of protected datasets, and
+ *  reports the per-phase timings as CSV or JSON. Every configuration runs in
+ *  its own directory below the base directory (a tmpfs such as /dev/shm is
+ *  recommended to take the storage out of the picture).
+ *
+ *  A restart is emulated in the same process by re-initializing FTI on the
+ *  configuration that the checkpoints have marked as failed, without calling
+ *  FTI_Finalize in between. This exercises the same recovery path as a real
+ *  restart (FTI_RecoverFiles and FTI_Recover) at the cost of leaking the
+ *  state of the first FTI instance.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <ftw.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fti.h>
+#include <iniparser.h>
+
+#define BENCH_MAX_IO    6
+#define BENCH_MAX_SETS  32
+
+/** I/O modes known to the benchmark ('ckpt_io' = index + 1)             */
+static const char* ioNames[BENCH_MAX_IO] = {
+    "posix", "mpiio", "ftiff", "sionlib", "hdf5", "ime"
+};
+
+/** I/O modes that are compiled into the library                         */
+static const int ioAvailable[BENCH_MAX_IO] = {
+    1, 1, 1,
+#ifdef ENABLE_SIONLIB
+    1,
+#else
+    0,
+#endif
+#ifdef ENABLE_HDF5
+    1,
+#else
+    0,
+#endif
+#ifdef ENABLE_IME_NATIVE
+    1,
+#else
+    0,
+#endif
+};
+
+typedef struct benchOpts {
+    int levels[4];              /**< levels to run (1..4)                 */
+    int nbLevels;
+    int ios[BENCH_MAX_IO];      /**< I/O modes to run (index in ioNames)  */
+    int nbIos;
+    int dcps[2];                /**< dCP off/on                           */
+    int nbDcps;
+    int nbVars;                 /**< protected datasets per rank          */
+    int64_t varSize;            /**< bytes per dataset                    */
+    double dirty;               /**< ratio of blocks changed per ckpt     */
+    int iters;                  /**< checkpoints per configuration        */
+    int dcpBlockSize;           /**< dCP block size, also dirty unit      */
+    int nodeSize;               /**< ranks per (emulated) node            */
+    int groupSize;              /**< 0 -> derived from the node count     */
+    int verbosity;              /**< FTI verbosity                        */
+    int recover;                /**< run the restart phase                */
+    int json;                   /**< output format                        */
+    char dir[FTI_BUFS];         /**< base directory                       */
+    char output[FTI_BUFS];      /**< result file, "-" for stdout          */
+    char* sets[BENCH_MAX_SETS]; /**< extra 'Section:key=value' settings   */
+    int nbSets;
+} benchOpts;
+
+typedef struct benchConfig {
+    int io;
+    int level;
+    int dcp;
+    char tag[64];
+    char dir[FTI_BUFS];
+    char cfg[FTI_BUFS];
+} benchConfig;
+
+static int rank, nbProc;
+static FILE* out;
+static int nbRecords;
+
+static void usage(const char* exe) {
+    fprintf(stderr,
+     "usage: mpirun -n <np> %s [options]\n"
+     "  -l, --levels LIST       checkpoint levels (default 1,2,3,4)\n"
+     "  -m, --io LIST           I/O modes: posix,mpiio,ftiff,sionlib,hdf5,ime\n"
+     "                          (default: all modes compiled in)\n"
+     "  -d, --dcp LIST          dCP off/on, e.g. 0,1 (default 0,1)\n"
+     "  -n, --vars N            protected datasets per rank (default 4)\n"
+     "  -s, --size BYTES        bytes per dataset, K/M/G suffix (default 16M)\n"
+     "  -r, --dirty RATIO       ratio of blocks changed between checkpoints\n"
+     "                          (default 0.25)\n"
+     "  -i, --iters N           checkpoints per configuration (default 3)\n"
+     "  -b, --block-size BYTES  dCP block size and dirty unit (default 16384)\n"
+     "  -N, --node-size N       ranks per emulated node (default 1)\n"
+     "  -g, --group-size N      encoding group size (default derived)\n"
+     "  -D, --dir PATH          base directory (default /dev/shm/fti_bench)\n"
+     "  -f, --format csv|json   output format (default csv)\n"
+     "  -o, --output FILE       result file, - for stdout\n"
+     "                          (default fti_bench.csv|json)\n"
+     "  -S, --set SEC:KEY=VAL   additional FTI configuration setting\n"
+     "  -R, --no-recover        skip the restart/recovery phase\n"
+     "  -v, --verbosity N       FTI verbosity (default 3)\n", exe);
+}
+
+static int64_t parseSize(const char* str) {
+    char* end;
+    double val = strtod(str, &end);
+    switch (*end) {
+        case 'g': case 'G': val *= 1024;  // fall through
+        case 'm': case 'M': val *= 1024;  // fall through
+        case 'k': case 'K': val *= 1024; break;
+        case '\0': break;
+        default: return -1;
+    }
+    return (int64_t) val;
+}
+
+static int parseIntList(const char* str, int* list, int max, int lo, int hi) {
+    char buf[FTI_BUFS];
+    snprintf(buf, FTI_BUFS, "%s", str);
+    int n = 0;
+    char* tok = strtok(buf, ",");
+    while (tok && n < max) {
+        int val = atoi(tok);
+        if (val < lo || val > hi) return -1;
+        list[n++] = val;
+        tok = strtok(NULL, ",");
+    }
+    return n;
+}
+
+static int parseIoList(const char* str, int* list) {
+    char buf[FTI_BUFS];
+    snprintf(buf, FTI_BUFS, "%s", str);
+    int n = 0;
+    char* tok = strtok(buf, ",");
+    while (tok && n < BENCH_MAX_IO) {
+        int i;
+        for (i = 0; i < BENCH_MAX_IO; i++) {
+            if (strcmp(tok, ioNames[i]) == 0) break;
+        }
+        if (i == BENCH_MAX_IO) return -1;
+        if (!ioAvailable[i]) {
+            if (rank == 0) {
+                fprintf(stderr, "fti_bench: I/O mode '%s' is not compiled"
+                 " into FTI, skipped.\n", tok);
+            }
+        } else {
+            list[n++] = i;
+        }
+        tok = strtok(NULL, ",");
+    }
+    return n;
+}
+
+static int parseOpts(int argc, char** argv, benchOpts* opts) {
+    static struct option longOpts[] = {
+        {"levels", required_argument, 0, 'l'},
+        {"io", required_argument, 0, 'm'},
+        {"dcp", required_argument, 0, 'd'},
+        {"vars", required_argument, 0, 'n'},
+        {"size", required_argument, 0, 's'},
+        {"dirty", required_argument, 0, 'r'},
+        {"iters", required_argument, 0, 'i'},
+        {"block-size", required_argument, 0, 'b'},
+        {"node-size", required_argument, 0, 'N'},
+        {"group-size", required_argument, 0, 'g'},
+        {"dir", required_argument, 0, 'D'},
+        {"format", required_argument, 0, 'f'},
+        {"output", required_argument, 0, 'o'},
+        {"set", required_argument, 0, 'S'},
+        {"no-recover", no_argument, 0, 'R'},
+        {"verbosity", required_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int i;
+    memset(opts, 0, sizeof(benchOpts));
+    for (i = 0; i < 4; i++) opts->levels[i] = i + 1;
+    opts->nbLevels = 4;
+    for (i = 0; i < BENCH_MAX_IO; i++) {
+        if (ioAvailable[i]) opts->ios[opts->nbIos++] = i;
+    }
+    opts->dcps[0] = 0;
+    opts->dcps[1] = 1;
+    opts->nbDcps = 2;
+    opts->nbVars = 4;
+    opts->varSize = 16 * 1024 * 1024;
+    opts->dirty = 0.25;
+    opts->iters = 3;
+    opts->dcpBlockSize = 16384;
+    opts->nodeSize = 1;
+    opts->verbosity = 3;
+    opts->recover = 1;
+    snprintf(opts->dir, FTI_BUFS, "/dev/shm/fti_bench");
+
+    int c;
+    while ((c = getopt_long(argc, argv, "l:m:d:n:s:r:i:b:N:g:D:f:o:S:Rv:h",
+     longOpts, NULL)) != -1) {
+        switch (c) {
+            case 'l':
+                opts->nbLevels = parseIntList(optarg, opts->levels, 4, 1, 4);
+                if (opts->nbLevels <= 0) return -1;
+                break;
+            case 'm':
+                opts->nbIos = parseIoList(optarg, opts->ios);
+                if (opts->nbIos < 0) return -1;
+                break;
+            case 'd':
+                opts->nbDcps = parseIntList(optarg, opts->dcps, 2, 0, 1);
+                if (opts->nbDcps <= 0) return -1;
+                break;
+            case 'n': opts->nbVars = atoi(optarg); break;
+            case 's': opts->varSize = parseSize(optarg); break;
+            case 'r': opts->dirty = atof(optarg); break;
+            case 'i': opts->iters = atoi(optarg); break;
+            case 'b': opts->dcpBlockSize = (int) parseSize(optarg); break;
+            case 'N': opts->nodeSize = atoi(optarg); break;
+            case 'g': opts->groupSize = atoi(optarg); break;
+            case 'D': snprintf(opts->dir, FTI_BUFS, "%s", optarg); break;
+            case 'f':
+                if (strcmp(optarg, "json") == 0) {
+                    opts->json = 1;
+                } else if (strcmp(optarg, "csv") != 0) {
+                    return -1;
+                }
+                break;
+            case 'o': snprintf(opts->output, FTI_BUFS, "%s", optarg); break;
+            case 'S':
+                if (opts->nbSets == BENCH_MAX_SETS ||
+                 strchr(optarg, '=') == NULL) return -1;
+                opts->sets[opts->nbSets++] = optarg;
+                break;
+            case 'R': opts->recover = 0; break;
+            case 'v': opts->verbosity = atoi(optarg); break;
+            default: return -1;
+        }
+    }
+
+    if (opts->nbVars < 1 || opts->varSize < 1 || opts->iters < 1 ||
+     opts->dirty < 0 || opts->dirty > 1 || opts->dcpBlockSize < 1 ||
+     opts->nodeSize < 1 || (nbProc % opts->nodeSize) != 0) {
+        return -1;
+    }
+    if (opts->output[0] == '\0') {
+        snprintf(opts->output, FTI_BUFS, "fti_bench.%s",
+         (opts->json) ? "json" : "csv");
+    }
+    if (opts->groupSize == 0) {
+        int nbNodes = nbProc / opts->nodeSize;
+        opts->groupSize = (nbNodes % 4 == 0) ? 4 : nbNodes;
+    }
+    return 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/*  Synthetic data                                                         */
+/*-------------------------------------------------------------------------*/
+
+static uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static void fillBlock(unsigned char* ptr, int64_t len, uint64_t seed) {
+    uint64_t val;
+    int64_t i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        val = mix64(seed + i);
+        memcpy(ptr + i, &val, 8);
+    }
+    val = mix64(seed + i);
+    memcpy(ptr + i, &val, len - i);
+}
+
+/** Rewrites a pseudo random subset of the blocks of 'ptr' (ratio 'dirty')  */
+static int64_t touchData(unsigned char* ptr, int64_t size, int var, int iter,
+ double dirty, int blockSize) {
+    int64_t nbBlocks = (size + blockSize - 1) / blockSize;
+    uint64_t limit = (uint64_t) (dirty * 10000.0);
+    int64_t touched = 0, b;
+    uint64_t seed = ((uint64_t) rank << 40) ^ ((uint64_t) var << 32) ^
+     ((uint64_t) iter << 20);
+    for (b = 0; b < nbBlocks; b++) {
+        if (iter > 0 && (mix64(seed ^ b) % 10000) >= limit) continue;
+        int64_t off = b * blockSize;
+        int64_t len = (off + blockSize > size) ? size - off : blockSize;
+        fillBlock(ptr + off, len, seed ^ (uint64_t) off);
+        touched += len;
+    }
+    return touched;
+}
+
+/*-------------------------------------------------------------------------*/
+/*  Configuration handling                                                 */
+/*-------------------------------------------------------------------------*/
+
+static int rmEntry(const char* path, const struct stat* sb, int flag,
+ struct FTW* ftw) {
+    (void) sb; (void) flag; (void) ftw;
+    remove(path);
+    return 0;
+}
+
+static int mkdirs(const char* path) {
+    char buf[FTI_BUFS];
+    snprintf(buf, FTI_BUFS, "%s", path);
+    char* p;
+    for (p = buf + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(buf, 0777) != 0 && errno != EEXIST) return -1;
+        *p = '/';
+    }
+    if (mkdir(buf, 0777) != 0 && errno != EEXIST) return -1;
+    return 0;
+}
+
+static int writeConfig(const benchOpts* opts, const benchConfig* conf) {
+    FILE* fd = fopen(conf->cfg, "w");
+    if (fd == NULL) return -1;
+
+    fprintf(fd, "[basic]\n");
+    fprintf(fd, "head = 0\n");
+    fprintf(fd, "node_size = %d\n", opts->nodeSize);
+    fprintf(fd, "group_size = %d\n", opts->groupSize);
+    fprintf(fd, "ckpt_dir = %s/local\n", conf->dir);
+    fprintf(fd, "glbl_dir = %s/global\n", conf->dir);
+    fprintf(fd, "meta_dir = %s/meta\n", conf->dir);
+    fprintf(fd, "ckpt_l1 = 0\nckpt_l2 = 0\nckpt_l3 = 0\nckpt_l4 = 0\n");
+    fprintf(fd, "dcp_l4 = 0\n");
+    fprintf(fd, "inline_l2 = 1\ninline_l3 = 1\ninline_l4 = 1\n");
+    fprintf(fd, "keep_last_ckpt = 0\nkeep_l4_ckpt = 0\n");
+    fprintf(fd, "ckpt_io = %d\n", conf->io + 1);
+    fprintf(fd, "enable_dcp = %d\n", conf->dcp);
+    fprintf(fd, "dcp_mode = 1\n");
+    fprintf(fd, "dcp_block_size = %d\n", opts->dcpBlockSize);
+    fprintf(fd, "dcp_stack_size = %d\n", opts->iters + 1);
+    fprintf(fd, "enable_staging = 0\n");
+    fprintf(fd, "max_sync_intv = 512\n");
+    fprintf(fd, "verbosity = %d\n", opts->verbosity);
+    fprintf(fd, "\n[restart]\nfailure = 0\nexec_id = NULL\n");
+    fprintf(fd, "\n[injection]\nrank = 0\nnumber = 0\nposition = 0\n"
+     "frequency = 0\n");
+    fprintf(fd, "\n[advanced]\nblock_size = 1024\ntransfer_size = 16\n"
+     "general_tag = 2612\nckpt_tag = 711\nstage_tag = 406\n"
+     "final_tag = 3107\nlocal_test = 1\n");
+    fclose(fd);
+
+    if (opts->nbSets == 0) return 0;
+
+    // apply the user settings on top of the generated file
+    dictionary* ini = iniparser_load(conf->cfg);
+    if (ini == NULL) return -1;
+    int i;
+    for (i = 0; i < opts->nbSets; i++) {
+        char key[FTI_BUFS];
+        snprintf(key, FTI_BUFS, "%s", opts->sets[i]);
+        char* val = strchr(key, '=');
+        *val++ = '\0';
+        char* sec = strchr(key, ':');
+        if (sec != NULL) {
+            *sec = '\0';
+            iniparser_set(ini, key, NULL);
+            *sec = ':';
+        }
+        iniparser_set(ini, key, val);
+    }
+    fd = fopen(conf->cfg, "w");
+    if (fd == NULL) {
+        iniparser_freedict(ini);
+        return -1;
+    }
+    iniparser_dump_ini(ini, fd);
+    fclose(fd);
+    iniparser_freedict(ini);
+    return 0;
+}
+
+/** Returns 1 if FTI supports the combination of level, I/O mode and dCP   */
+static int isValid(const benchOpts* opts, const benchConfig* conf) {
+    if (conf->dcp && (conf->level != 4 ||
+     (strcmp(ioNames[conf->io], "posix") != 0 &&
+      strcmp(ioNames[conf->io], "ftiff") != 0))) {
+        return 0;
+    }
+    if ((conf->level == 2 || conf->level == 3) && opts->groupSize < 2) {
+        if (rank == 0) {
+            fprintf(stderr, "fti_bench: L%d needs at least 2 nodes per group,"
+             " skipped (use -N to emulate nodes).\n", conf->level);
+        }
+        return 0;
+    }
+    return 1;
+}
+
+/*-------------------------------------------------------------------------*/
+/*  Result output                                                          */
+/*-------------------------------------------------------------------------*/
+
+static void report(const benchOpts* opts, const benchConfig* conf, int iter,
+ const char* phase, double local, int64_t bytes, int ok) {
+    double max, sum;
+    MPI_Reduce(&local, &max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&local, &sum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    if (rank != 0) return;
+
+    if (opts->json) {
+        fprintf(out, "%s  {\"io\": \"%s\", \"level\": %d, \"dcp\": %d, "
+         "\"ranks\": %d, \"vars\": %d, \"var_size\": %ld, \"dirty\": %.3f, "
+         "\"iter\": %d, \"phase\": \"%s\", \"max_s\": %.6f, "
+         "\"avg_s\": %.6f, \"bytes\": %ld, \"ok\": %d}",
+         (nbRecords > 0) ? ",\n" : "", ioNames[conf->io], conf->level,
+         conf->dcp, nbProc, opts->nbVars, opts->varSize, opts->dirty, iter,
+         phase, max, sum / nbProc, bytes, ok);
+    } else {
+        fprintf(out, "%s,%d,%d,%d,%d,%ld,%.3f,%d,%s,%.6f,%.6f,%ld,%d\n",
+         ioNames[conf->io], conf->level, conf->dcp, nbProc, opts->nbVars,
+         opts->varSize, opts->dirty, iter, phase, max, sum / nbProc, bytes,
+         ok);
+    }
+    fflush(out);
+    nbRecords++;
+}
+
+/*-------------------------------------------------------------------------*/
+/*  Benchmark                                                              */
+/*-------------------------------------------------------------------------*/
+
+static int protectAll(const benchOpts* opts, unsigned char** data) {
+    int v;
+    for (v = 0; v < opts->nbVars; v++) {
+        if (FTI_Protect(v, data[v], opts->varSize, FTI_CHAR) != FTI_SCES) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int runConfig(const benchOpts* opts, benchConfig* conf,
+ unsigned char** data, unsigned char** ref) {
+    int v, it, ok = 1;
+    int64_t protBytes = (int64_t) opts->nbVars * opts->varSize * nbProc;
+
+    if (rank == 0) {
+        nftw(conf->dir, rmEntry, 16, FTW_DEPTH | FTW_PHYS);
+        if (mkdirs(conf->dir) != 0 || writeConfig(opts, conf) != 0) {
+            fprintf(stderr, "fti_bench: cannot prepare '%s': %s\n",
+             conf->dir, strerror(errno));
+            ok = 0;
+        }
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (!ok) return -1;
+
+    if (FTI_Init(conf->cfg, MPI_COMM_WORLD) != FTI_SCES) return -1;
+    if (protectAll(opts, data) != 0) return -1;
+
+    int level = (conf->dcp) ? FTI_L4_DCP : conf->level;
+    for (it = 0; it < opts->iters; it++) {
+        int64_t dirty = 0, allDirty;
+        for (v = 0; v < opts->nbVars; v++) {
+            dirty += touchData(data[v], opts->varSize, v, it, opts->dirty,
+             opts->dcpBlockSize);
+        }
+        MPI_Allreduce(&dirty, &allDirty, 1, MPI_INT64_T, MPI_SUM,
+         MPI_COMM_WORLD);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t0 = MPI_Wtime();
+        int res = FTI_Checkpoint(it + 1, level);
+        double elapsed = MPI_Wtime() - t0;
+
+        FTIT_timings tm;
+        FTI_GetCkptTimings(&tm);
+        ok = (res == FTI_DONE);
+        report(opts, conf, it, "wait", tm.wait, 0, ok);
+        report(opts, conf, it, "write", tm.write, protBytes, ok);
+        report(opts, conf, it, "hash", tm.hash, protBytes, ok);
+        report(opts, conf, it, "post", tm.post, protBytes, ok);
+        report(opts, conf, it, "flush", tm.flush, protBytes, ok);
+        report(opts, conf, it, "checkpoint", elapsed, allDirty, ok);
+        if (!ok) break;
+    }
+
+    if (ok && opts->recover) {
+        for (v = 0; v < opts->nbVars; v++) {
+            memcpy(ref[v], data[v], opts->varSize);
+            memset(data[v], 0, opts->varSize);
+        }
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t0 = MPI_Wtime();
+        int res = FTI_Init(conf->cfg, MPI_COMM_WORLD);
+        double t1 = MPI_Wtime();
+        if (res == FTI_SCES && protectAll(opts, data) == 0) {
+            res = FTI_Recover();
+        } else {
+            res = FTI_NSCS;
+        }
+        double t2 = MPI_Wtime();
+
+        int valid = (res == FTI_SCES);
+        for (v = 0; valid && v < opts->nbVars; v++) {
+            valid = (memcmp(ref[v], data[v], opts->varSize) == 0);
+        }
+        MPI_Allreduce(&valid, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+        report(opts, conf, -1, "restart", t1 - t0, 0, ok);
+        report(opts, conf, -1, "recover", t2 - t1, protBytes, ok);
+    }
+
+    FTI_Finalize();
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) nftw(conf->dir, rmEntry, 16, FTW_DEPTH | FTW_PHYS);
+    return ok ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nbProc);
+
+    benchOpts opts;
+    if (parseOpts(argc, argv, &opts) != 0) {
+        if (rank == 0) usage(argv[0]);
+        MPI_Finalize();
+        return 1;
+    }
+
+    out = stdout;
+    if (rank == 0 && strcmp(opts.output, "-") != 0) {
+        out = fopen(opts.output, "w");
+        if (out == NULL) {
+            fprintf(stderr, "fti_bench: cannot open '%s'\n", opts.output);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+    if (rank == 0) {
+        if (opts.json) {
+            fprintf(out, "[\n");
+        } else {
+            fprintf(out, "io,level,dcp,ranks,vars,var_size,dirty,iter,phase,"
+             "max_s,avg_s,bytes,ok\n");
+        }
+    }
+
+    unsigned char** data = malloc(opts.nbVars * sizeof(unsigned char*));
+    unsigned char** ref = malloc(opts.nbVars * sizeof(unsigned char*));
+    int v;
+    for (v = 0; v < opts.nbVars; v++) {
+        data[v] = malloc(opts.varSize);
+        ref[v] = malloc(opts.varSize);
+        if (data[v] == NULL || ref[v] == NULL) {
+            fprintf(stderr, "fti_bench: cannot allocate %ld bytes\n",
+             opts.varSize);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+
+    int i, l, d, failed = 0;
+    for (i = 0; i < opts.nbIos; i++) {
+        for (d = 0; d < opts.nbDcps; d++) {
+            for (l = 0; l < opts.nbLevels; l++) {
+                benchConfig conf;
+                conf.io = opts.ios[i];
+                conf.level = opts.levels[l];
+                conf.dcp = opts.dcps[d];
+                if (!isValid(&opts, &conf)) continue;
+                snprintf(conf.tag, sizeof(conf.tag), "%s-l%d%s",
+                 ioNames[conf.io], conf.level, conf.dcp ? "-dcp" : "");
+                snprintf(conf.dir, FTI_BUFS, "%s/%s", opts.dir, conf.tag);
+                snprintf(conf.cfg, FTI_BUFS, "%s/config.fti", conf.dir);
+                if (runConfig(&opts, &conf, data, ref) != 0) {
+                    if (rank == 0) {
+                        fprintf(stderr, "fti_bench: configuration '%s'"
+                         " failed\n", conf.tag);
+                    }
+                    failed++;
+                }
+            }
+        }
+    }
+
+    if (rank == 0) {
+        if (opts.json) fprintf(out, "\n]\n");
+        if (out != stdout) fclose(out);
+        rmdir(opts.dir);
+    }
+
+    for (v = 0; v < opts.nbVars; v++) {
+        free(data[v]);
+        free(ref[v]);
+    }
+    free(data);
+    free(ref);
+
+    MPI_Finalize();
+    return (failed > 0) ? 1 : 0;
+}
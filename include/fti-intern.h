@@ -105,6 +105,8 @@
 #define FTI_IO_SIONLIB 1004
 #endif
 #define FTI_IO_IME 1006
+/** Token for IO mode io_uring.                                            */
+#define FTI_IO_IOURING 1007
 /** Token for IO mode MPI.                                                 */
 
 #define MAX_STACK_SIZE 10
@@ -138,7 +140,7 @@ extern "C" {
 
     typedef struct FTIT_datasetInfo {
         int varID;
-        uint32_t varSize;
+        uint64_t varSize;
     } FTIT_datasetInfo;
 
     typedef struct FTIT_dcpConfigurationPosix {
@@ -154,16 +156,16 @@ extern "C" {
         int nbLayerReco;
         int nbVarReco;
         unsigned int Counter;
-        uint32_t FileSize;
-        uint32_t dataSize;
-        uint32_t dcpSize;
-        uint32_t LayerSize[MAX_STACK_SIZE];
+        uint64_t FileSize;
+        uint64_t dataSize;
+        uint64_t dcpSize;
+        uint64_t LayerSize[MAX_STACK_SIZE];
         FTIT_datasetInfo datasetInfo[MAX_STACK_SIZE][FTI_BUFS];
         char LayerHash[MAX_STACK_SIZE*MD5_DIGEST_STRING_LENGTH];
     } FTIT_dcpExecutionPosix;
 
     typedef struct FTIT_dcpDatasetPosix {
-        uint32_t hashDataSize;
+        uint64_t hashDataSize;
         unsigned char* currentHashArray;
         unsigned char* oldHashArray;
     } FTIT_dcpDatasetPosix;
@@ -214,6 +216,78 @@ extern "C" {
         void *fd;
     } FTIT_iCPInfo;
 
+    /** @typedef    FTIT_timings
+     *  @brief      Phase durations (seconds) of the last checkpoint.
+     *
+     *  Filled by the application process that took the checkpoint. If the
+     *  post-processing is offloaded to the heads, 'post' and 'flush' stay 0.
+     */
+    typedef struct FTIT_timings {
+        double wait;                 /**< waiting for previous async. ckpt    */
+        double write;                /**< writing the checkpoint data         */
+        double hash;                 /**< checksums and metadata creation     */
+        double post;                 /**< L1/L2/L3 post-processing            */
+        double flush;                /**< L4 flush to the PFS                 */
+        double total;                /**< whole FTI_Checkpoint call           */
+        int level;                   /**< level of the checkpoint             */
+    } FTIT_timings;
+
+    /** @typedef    FTIT_schedule
+     *  @brief      Checkpoint intervals used by FTI_Snapshot, per level.
+     *
+     *  The entries are indexed by level (1 to 4), entry 0 is unused. The
+     *  costs are measured only when the scheduler is enabled.
+     */
+    typedef struct FTIT_schedule {
+        int interval[5];             /**< interval in minutes (-1 = off)      */
+        double cost[5];              /**< smoothed checkpoint cost (sec.)     */
+        double mtbf[5];              /**< MTBF of the level (min., 0 = none)  */
+    } FTIT_schedule;
+
+    /** Number of bins of the latency histograms                            */
+#define FTI_METRICS_BINS 16
+
+    /** @typedef    FTIT_histogram
+     *  @brief      Distribution of the durations of a phase.
+     *
+     *  Bin 0 counts the durations below 1 ms, bin i the ones in
+     *  [2^(i-1), 2^i) ms. The last bin also counts the longer ones.
+     */
+    typedef struct FTIT_histogram {
+        uint64_t bins[FTI_METRICS_BINS]; /**< number of durations per bin */
+        uint64_t count;              /**< number of durations             */
+        double sum;                  /**< sum of the durations (sec.)     */
+        double max;                  /**< longest duration (sec.)         */
+    } FTIT_histogram;
+
+    /** @typedef    FTIT_metrics
+     *  @brief      Counters of the checkpoints taken since FTI_Init.
+     *
+     *  The level entries are indexed by level (1 to 4), entry 0 is unused.
+     *  'dcpRatio' is the dirty share of the last dCP checkpoint, averaged
+     *  over the processes for the node and global metrics. The flush and
+     *  head queue entries are measured by the processes doing the
+     *  post-processing, i.e. by the heads if there are any.
+     */
+    typedef struct FTIT_metrics {
+        int nbProcs;                 /**< processes aggregated            */
+        double uptime;               /**< seconds since FTI_Init          */
+        uint64_t ckpts[5];           /**< checkpoints taken per level     */
+        uint64_t failed;             /**< checkpoints failed              */
+        uint64_t bytes[5];           /**< bytes written per level         */
+        uint64_t dcpCkpts;           /**< dCP checkpoints taken           */
+        uint64_t dcpBytes;           /**< data protected by the dCPs      */
+        uint64_t dcpDirty;           /**< data written by the dCPs        */
+        double dcpRatio;             /**< dirty share of the last dCP     */
+        FTIT_histogram write;        /**< checkpoint write durations      */
+        FTIT_histogram post[5];      /**< post-processing durations       */
+        uint64_t flushBytes;         /**< bytes flushed to the PFS        */
+        double flushTime;            /**< time spent flushing (sec.)      */
+        int headQueue;               /**< staging requests pending        */
+        int headQueueMax;            /**< most staging requests pending   */
+        FTIT_histogram recover;      /**< recovery durations              */
+    } FTIT_metrics;
+
     /** @typedef    FTIFF_metaInfo
      *  @brief      Meta Information about file.
      *
@@ -236,6 +310,8 @@ extern "C" {
         size_t ptFs;          /**< partner copy file size                    */
         uint64_t timestamp;   /**< time (ns) cp was created (CLOCK_REALTIME) */
         size_t dcpSize;       /**< how much actually written by rank         */
+        uint32_t version;     /**< FTI-FF format version of the file         */
+        int l3Code;           /**< L3 code of the RS files (0 if unknown)    */
     } FTIFF_metaInfo;
 
     /** @typedef    FTIT_DataDiffHash
@@ -273,8 +349,8 @@ extern "C" {
         bool hasCkpt;         /**< indicates if container is stored in ckpt   */
         uintptr_t dptr;       /**< data pointer offset                        */
         uintptr_t fptr;       /**< file pointer offset                        */
-        int32_t chunksize;    /**< chunk size of variable in this block       */
-        int32_t containersize;/**< cont size stored of variable in this block */
+        int64_t chunksize;    /**< chunk size of variable in this block       */
+        int64_t containersize;/**< cont size stored of variable in this block */
         unsigned char hash[MD5_DIGEST_LENGTH];  /**< hash of variable chunk   */
         unsigned char myhash[MD5_DIGEST_LENGTH];/**< hash of this structure   */
         bool update;    /**< TRUE if struct needs to be updated in ckpt file  */
@@ -291,7 +367,7 @@ extern "C" {
      */
     typedef struct FTIFF_db {
         int numvars;          /**< number of protected variables in datablock */
-        int32_t dbsize;       /**< size of metadata + data for block in bytes */
+        int64_t dbsize;       /**< size of metadata + data for block in bytes */
         unsigned char myhash[MD5_DIGEST_LENGTH]; /**< hash of variable chunk  */
         bool update;     /**< TRUE if struct needs to be updated in ckpt file */
         bool finalized;             /**< TRUE if block is stored in cp file   */
@@ -428,11 +504,13 @@ extern "C" {
     typedef enum {
         FTI_ATTRIBUTE_NAME = 1 << 0,
         FTI_ATTRIBUTE_DIM  = 1 << 1,
+        FTI_ATTRIBUTE_CODEC = 1 << 2,
     } FTIT_attributeFlag;
 
     typedef struct FTIT_attribute {
         FTIT_dimension dim;
         char name[FTI_BUFS];
+        int codec;                         /**< FTI_CODEC_* of the dataset   */
     } FTIT_attribute;
 
     /** @typedef    FTIT_dataset
@@ -447,10 +525,11 @@ extern "C" {
         int dimLength[32];                 /**< Lenght of each dimention     */
         bool recovered;                    /**< True if metadata restored    */
         bool isDevicePtr;                  /**< True if on device memory     */
-        int32_t count;                     /**< nb of elements in dataset    */
-        int32_t size;                      /**< size of the data             */
-        int32_t sizeStored;                /**< size of the data in last CP  */
+        int64_t count;                     /**< nb of elements in dataset    */
+        int64_t size;                      /**< size of the data             */
+        int64_t sizeStored;                /**< size of the data in last CP  */
         size_t filePos;                    /**< offset of buffer in CP file  */
+        int codec;                         /**< codec of the data in last CP */
         FTIT_attribute attribute;
         FTIT_sharedData sharedData;        /**< Info if dataset is subset    */
         FTIT_dcpDatasetPosix dcpInfoPosix; /**< dCP info for posix I/O       */
@@ -471,9 +550,10 @@ extern "C" {
         int level;                            /**< checkpoint level           */
         int ckptId;                           /**< Current Ckpt ID            */
         int ckptIdL4;                         /**< Current L4 Ckpt ID         */
-        int32_t maxFs;                        /**< Maximum file size.         */
-        int32_t fs;                           /**< File size.                 */
-        int32_t pfs;                          /**< Partner file size.         */
+        int64_t maxFs;                        /**< Maximum file size.         */
+        int64_t fs;                           /**< File size.                 */
+        int64_t pfs;                          /**< Partner file size.         */
+        int l3Code;                           /**< L3 code (0 if unknown)     */
         char ckptFile[FTI_BUFS];              /**< Ckpt file name. [FTI_BUFS] */
     } FTIT_metadata;
 
@@ -495,6 +575,29 @@ extern "C" {
         int verbosity;                    /**< Verbosity level.               */
         int blockSize;                    /**< Communication block size.      */
         int transferSize;                 /**< Transfer size local to PFS     */
+        bool transferZeroCopy;            /**< In-kernel local/PFS copies     */
+        bool transferFadvise;             /**< Access hints on copied files   */
+        int transferThreads;              /**< Files copied concurrently      */
+        int metaFormat;                   /**< Format of the metadata files   */
+        int writeThreads;                 /**< Writer threads (0 = serial)    */
+        int writeQueueDepth;              /**< Chunks in flight in pipeline   */
+        size_t writeChunkSize;            /**< Pipeline chunk size in bytes   */
+        int codec;                        /**< Default codec of the datasets  */
+        int zlibLevel;                    /**< Compression level of zlib      */
+        int compressThreads;              /**< Threads encoding the datasets  */
+        int readThreads;                  /**< Threads reading at recovery    */
+        int uringDepth;                   /**< Writes in flight (io_uring)    */
+        size_t uringBufferSize;           /**< Staging buffer size (io_uring) */
+        bool uringDirect;                 /**< O_DIRECT files (io_uring)      */
+        bool asyncL1;                     /**< L1 written in background       */
+        int64_t asyncPoolSize;            /**< Staging pool (0 = data size)   */
+        bool l2FromMemory;                /**< L2 copy sent from the datasets */
+        bool ckptScheduler;               /**< Intervals from measured costs  */
+        char traceDir[FTI_BUFS];          /**< Trace files (empty = off)      */
+        char metricsDir[FTI_BUFS];        /**< Metrics files (empty = off)    */
+        int metricsIntv;                  /**< Seconds between metrics dumps  */
+        bool dedup;                       /**< Equal L2/L4 blocks sent once   */
+        size_t dedupBlockSize;            /**< Dedup block size in bytes      */
         int maxVarId;
 #ifdef LUSTRE
         int stripeUnit;                    /**< Striping Unit for Lustre FS   */
@@ -505,8 +608,12 @@ extern "C" {
         int stageTag;                      /**< MPI tag for staging comm.     */
         int finalTag;                      /**< MPI tag for finalize comm.    */
         int generalTag;                    /**< MPI tag for general comm.     */
+        int headIdleSleep;                 /**< Max. idle head back-off (us)  */
+        bool headStageThread;              /**< TRUE to stage in a thread     */
         int test;                          /**< TRUE if local test.           */
         int l3WordSize;                    /**< RS encoding word size.        */
+        int l3Code;                        /**< L3 code family.               */
+        int l3Threads;                     /**< Threads for RS encoding.      */
         int ioMode;                        /**< IO mode for L4 ckpt.          */
         bool h5SingleFileEnable;           /**< TRUE if VPR enabled           */
         bool h5SingleFileKeep;             /**< TRUE if VPR files to keep     */
@@ -575,6 +682,8 @@ extern "C" {
         int ckptCnt;                /**< Checkpoint counter.                  */
         int ckptDcpIntv;            /**< Checkpoint interval.                 */
         int ckptDcpCnt;             /**< Checkpoint counter.                  */
+        double ckptCost;            /**< Measured ckpt. cost (sec.)           */
+        double mtbf;                /**< MTBF of the level (min.)             */
         bool localReplica;          /**< True if rank has local replica of CP */
     } FTIT_checkpoint;
 
@@ -617,6 +726,11 @@ extern "C" {
         int(*finCKPT)   (void *fileDesc);
         size_t(*getPos) (void *fileDesc);
         void(*finIntegrity) (unsigned char *, void*);
+        /** Optional hooks for the pipelined writer (NULL if unsupported) */
+        int(*setPos)    (size_t pos, void *fileDesc);
+        int(*WriteAt)   (void *src, size_t size, size_t offset,
+                void *fileDesc);
+        void(*updIntegrity) (void *src, size_t size, void *fileDesc);
     }FTIT_IO;
 
     typedef struct FTIT_mqueue FTIT_mqueue;
@@ -675,7 +789,8 @@ extern "C" {
         unsigned int ckptId;                /**< Checkpoint ID.               */
         unsigned int ckptNext;              /**< Iteration for next CP.       */
         unsigned int ckptLast;              /**< Iteration for last CP.       */
-        int32_t ckptSize;                   /**< Checkpoint size.             */
+        int64_t ckptSize;                   /**< Checkpoint size.             */
+        int64_t encodedSize;                /**< File size if encoded, or 0   */
         unsigned int nbVar;                 /**< nb of protected variables    */
         unsigned int nbVarStored;           /**< nb prot. var. stored in CP   */
         int nbGroup;                        /**< Number of protected groups.  */
@@ -693,6 +808,10 @@ extern "C" {
         FTIT_globalDataset* globalDatasets; /**< ptr to first global dataset  */
         FTIT_StageInfo* stageInfo;          /**< root of staging requests     */
         FTIT_iCPInfo iCPInfo;               /**< meta info iCP                */
+        FTIT_timings timings;               /**< phases of the last ckpt.     */
+        FTIT_metrics metrics;               /**< counters since FTI_Init      */
+        double metricsStart;                /**< time of FTI_Init             */
+        double metricsDump;                 /**< time of the last dump        */
         MPI_Comm globalComm;                /**< Global communicator.         */
         MPI_Comm groupComm;                 /**< Group communicator.          */
         MPI_Comm nodeComm;
@@ -37,6 +37,22 @@
 /** status 'not initialized' for stage requests                            */
 #define FTI_SI_NINI 0x0
 
+/** codec 'use the default of the configuration' for dataset attributes    */
+#define FTI_CODEC_DEFAULT -1
+/** codec 'none', the dataset is stored as is                              */
+#define FTI_CODEC_NONE 0x0
+/** codec 'zlib', the dataset is deflated                                  */
+#define FTI_CODEC_ZLIB 0x1
+/** codec 'shuffle', the bytes of the elements are grouped by significance */
+#define FTI_CODEC_SHUFFLE 0x2
+
+/** metrics 'of the calling process' for FTI_GetMetrics                    */
+#define FTI_METRICS_LOCAL 0
+/** metrics 'of the application processes of the node' for FTI_GetMetrics  */
+#define FTI_METRICS_NODE 1
+/** metrics 'of all the application processes' for FTI_GetMetrics         */
+#define FTI_METRICS_GLOBAL 2
+
 /** Identifier abstraction for FTI internal objects                        */
 typedef int fti_id_t;
 /** FTI v1.4 and backwards data type handling compatibility                */
@@ -86,7 +102,7 @@ extern "C" {
   int FTI_Status();
   int FTI_InitGroup(FTIT_H5Group* h5group, char* name, FTIT_H5Group* parent);
   int FTI_RenameGroup(FTIT_H5Group* h5group, char* name);
-  int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid);
+  int FTI_Protect(int id, void* ptr, int64_t count, fti_id_t tid);
   int FTI_SetAttribute(int id, FTIT_attribute attribute,
           FTIT_attributeFlag flag);
   int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
@@ -101,10 +117,14 @@ extern "C" {
   int FTI_UpdateGlobalDataset(int id, int rank, FTIT_hsize_t* dimLength);
   int FTI_UpdateSubset(int id, int rank, FTIT_hsize_t* offset,
    FTIT_hsize_t* count, int did);
-  int32_t FTI_GetStoredSize(int id);
+  int64_t FTI_GetStoredSize(int id);
   void* FTI_Realloc(int id, void* ptr);
   int FTI_BitFlip(int datasetID);
   int FTI_Checkpoint(int id, int level);
+  int FTI_GetCkptTimings(FTIT_timings* timings);
+  int FTI_GetCkptSchedule(FTIT_schedule* schedule);
+  int FTI_SetMtbf(int level, double mtbf);
+  int FTI_GetMetrics(FTIT_metrics* metrics, int scope);
   int FTI_GetStageDir(char* stageDir, int maxLen);
   int FTI_GetStageStatus(int ID);
   int FTI_SendFile(char* lpath, char *rpath);
@@ -0,0 +1,123 @@
+# This module reads FTI's group metadata
+# files (sector<s>-group<g>.fti) in both
+# the INI and the binary format
+
+import configparser
+import struct
+import sys
+import zlib
+
+# Binary format (see src/meta-bin.h)
+META_MAGIC = b'FTIMETA\x00'
+META_VERSION = 1
+HEADER = struct.Struct('<8sQQIIIIiIII')
+RANK = struct.Struct('<QQIIII40s40s')
+VAR = struct.Struct('<QQiiiIIIII')
+LAYER = struct.Struct('<Q40s')
+DIM = struct.Struct('<Q')
+
+# Error codes
+# 2006: 'Corrupted binary meta file'
+
+
+# This function tells if the given meta
+# file is in the binary format
+def is_binary(meta_file):
+    with open(meta_file, 'rb') as f:
+        return f.read(len(META_MAGIC)) == META_MAGIC
+
+
+# This function returns the string
+# starting at offset in the strings of a rank
+def get_string(strings, offset):
+    end = strings.index(b'\x00', offset)
+    return strings[offset:end].decode()
+
+
+# This function returns the C string
+# stored in a fixed size field
+def get_field(field):
+    return field.split(b'\x00', 1)[0].decode()
+
+
+# This function reads a binary meta file
+# and returns it with the same sections
+# and keys as the INI meta file
+def read_binary(meta_file):
+    config = configparser.ConfigParser(interpolation=None)
+    with open(meta_file, 'rb') as f:
+        raw = f.read()
+
+    (magic, max_fs, size, version, group_size, nb_var, nb_layer,
+     ckpt_id, is_dcp, crc, _) = HEADER.unpack_from(raw, 0)
+    if version > META_VERSION:
+        print("Unsupported binary meta file version", version)
+        sys.exit(2006)
+    table_end = HEADER.size + RANK.size * group_size
+    header = bytearray(raw[:HEADER.size])
+    header[HEADER.size - 8:HEADER.size - 4] = b'\x00' * 4
+    if zlib.crc32(bytes(header) + raw[HEADER.size:table_end]) != crc:
+        print("Corrupted binary meta file (rank table)")
+        sys.exit(2006)
+
+    config['ckpt_info'] = {
+        'ckpt_type': 'dcp' if is_dcp else 'full',
+        'ckpt_id': str(ckpt_id)}
+
+    for i in range(group_size):
+        (fs, offset, nb_dims, str_size, file_name, sec_crc,
+         checksum, rs_checksum) = RANK.unpack_from(
+             raw, HEADER.size + i * RANK.size)
+        sec_size = (VAR.size * nb_var + LAYER.size * nb_layer +
+                    DIM.size * nb_dims + str_size)
+        section = raw[offset:offset + sec_size]
+        if zlib.crc32(section) != sec_crc:
+            print("Corrupted binary meta file (rank "+str(i)+")")
+            sys.exit(2006)
+        layers_at = VAR.size * nb_var
+        dims_at = layers_at + LAYER.size * nb_layer
+        strings = section[dims_at + DIM.size * nb_dims:]
+
+        rank = {
+            'ckpt_file_name': get_string(strings, file_name),
+            'ckpt_file_size': str(fs),
+            'ckpt_file_maxs': str(max_fs),
+            'ckpt_checksum': get_field(checksum)}
+        if get_field(rs_checksum):
+            rank['rsed_checksum'] = get_field(rs_checksum)
+        for j in range(nb_var):
+            (var_size, pos, var_id, type_id, type_size, ndims, dims, name,
+             id_char, _) = VAR.unpack_from(section, j * VAR.size)
+            var = 'var'+str(j)
+            rank[var+'_id'] = str(var_id)
+            rank[var+'_typeid'] = str(type_id)
+            rank[var+'_typesize'] = str(type_size)
+            rank[var+'_size'] = str(var_size)
+            rank[var+'_pos'] = str(pos)
+            rank[var+'_name'] = get_string(strings, name)
+            rank[var+'_idchar'] = get_string(strings, id_char)
+            rank[var+'_ndims'] = str(ndims)
+            for r in range(ndims):
+                dim, = DIM.unpack_from(section,
+                                       dims_at + (dims + r) * DIM.size)
+                rank[var+'_dim'+str(r)] = str(dim)
+        for k in range(nb_layer):
+            layer_size, layer_hash = LAYER.unpack_from(
+                section, layers_at + k * LAYER.size)
+            layer = 'dcp_layer'+str(k)
+            rank[layer+'_size'] = str(layer_size)
+            rank[layer+'_hash'] = get_field(layer_hash)
+        config[str(i)] = rank
+
+    return config
+
+
+# This function reads the given meta file
+# whatever its format and returns a
+# ConfigParser with its content
+def read_meta_file(meta_file):
+    if is_binary(meta_file):
+        return read_binary(meta_file)
+    config = configparser.ConfigParser()
+    config.read(meta_file)
+    return config
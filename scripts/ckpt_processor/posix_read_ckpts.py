@@ -14,6 +14,7 @@ from itertools import zip_longest
 import numpy as np
 import pandas as pd
 import h5py
+import fti_meta
 
 # Error codes
 # 1001: 'Unknown level'
@@ -65,8 +66,7 @@ def read_meta(meta_file, ckpt_file, group_size, level):
     var_pattern = re.compile(regex)
     # parse and get value by key
     print("reading meta file:", meta_file)
-    config = configparser.ConfigParser()
-    config.read(meta_file)
+    config = fti_meta.read_meta_file(meta_file)
 
     # get nbVars
     global nbVars
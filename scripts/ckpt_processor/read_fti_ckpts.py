@@ -8,6 +8,7 @@ import time
 from fnmatch import fnmatch
 import configparser
 import posix_read_ckpts
+import fti_meta
 import subprocess
 import sys
 
@@ -175,8 +176,7 @@ def recover_mpiio_l4(rank_id, PFSfile):
                 break
 
     # processing the meta file for the size
-    config = configparser.ConfigParser()
-    config.read(meta_file)
+    config = fti_meta.read_meta_file(meta_file)
     fileSize = config['0']['ckpt_file_size']
 
     os.chdir(executable_path)
@@ -225,8 +225,7 @@ def find_meta_file(ckpt_file):
                 file = meta_abs_path+'/'+execution_id+level_dir+file
                 
                 if os.path.isfile(file) is True:
-                    config = configparser.ConfigParser()
-                    config.read(file)
+                    config = fti_meta.read_meta_file(file)
 
                     ckpt = ckpt_file.rsplit('/', 1)[1]
                     for section in config.sections():
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# This script merges the trace files written
+# by FTI ('Advanced:trace_dir') into a single
+# Chrome trace, that can be opened in
+# chrome://tracing or https://ui.perfetto.dev
+#
+# usage: fti_trace_merge.py <dir|files...> -o <output>
+
+import argparse
+import glob
+import json
+import os
+import sys
+
+
+# This function returns the trace files of
+# the given directories and files
+def trace_files(paths):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            files.extend(glob.glob(os.path.join(path, 'fti-trace-*.json')))
+        else:
+            files.append(path)
+    return sorted(files)
+
+
+# This function merges the events of the
+# trace files, ranks are kept as processes
+def merge(files):
+    events = []
+    dropped = 0
+    for fn in files:
+        with open(fn) as f:
+            trace = json.load(f)
+        events.extend(trace['traceEvents'])
+        dropped += trace.get('otherData', {}).get('dropped', 0)
+    # metadata first, then spans in time order
+    events.sort(key=lambda e: (e['ph'] != 'M', e.get('ts', 0)))
+    return {'traceEvents': events, 'displayTimeUnit': 'ms',
+            'otherData': {'ranks': len(files), 'dropped': dropped}}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Merge the FTI trace files of all ranks.')
+    parser.add_argument('paths', nargs='+',
+                        help='trace directory or fti-trace-<rank>.json files')
+    parser.add_argument('-o', '--output', default='fti-trace.json',
+                        help='merged trace (default: fti-trace.json)')
+    args = parser.parse_args()
+
+    files = trace_files(args.paths)
+    if not files:
+        sys.exit('No FTI trace file found')
+    trace = merge(files)
+    with open(args.output, 'w') as f:
+        json.dump(trace, f)
+    print('%d ranks, %d events merged in %s' % (
+        len(files), len(trace['traceEvents']), args.output))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,495 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   codec.c
+ *  @date   October, 2026
+ *  @brief  Per-dataset encoding of the checkpoint data.
+ *
+ *  The codec of a dataset is a combination of filters applied before the
+ *  data is handed to the backend:
+ *
+ *  - FTI_CODEC_SHUFFLE groups the bytes of the elements by significance,
+ *    which exposes the redundancy of floating-point fields to zlib,
+ *  - FTI_CODEC_ZLIB deflates the data with 'zlib_level'.
+ *
+ *  An encoded dataset is a sequence of frames of at most
+ *  FTI_CODEC_FRAME_SIZE raw bytes, each one preceded by a FTIT_codecFrame
+ *  header. A frame that does not shrink is stored without deflating it
+ *  (size == rawSize). Frames are independent, so 'compress_threads' threads
+ *  encode them concurrently.
+ */
+
+#include "../interface.h"
+#include "codec.h"
+
+#ifndef FTI_NOZLIB
+#include "zlib.h"
+#endif
+
+/** Number of elements shuffled per tile **/
+#define FTI_CODEC_TILE 4096
+
+/** Encoding of the frames of a dataset **/
+typedef struct FTIT_codecJob {
+    FTIT_dataset*   data;       /**< Dataset to encode                    */
+    int             codec;      /**< Filters to apply                     */
+    int             level;      /**< Compression level of zlib            */
+    size_t          frameSize;  /**< Raw bytes per frame                  */
+    size_t          slotSize;   /**< Output bytes reserved per frame      */
+    char*           out;        /**< One slot per frame                   */
+    size_t*         sizes;      /**< Encoded size per frame, 0 on failure */
+} FTIT_codecJob;
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Groups the bytes of the elements by significance.
+  @param      src             Elements to shuffle.
+  @param      dst             Shuffled bytes.
+  @param      nbEle           Number of elements.
+  @param      eleSize         Size of an element.
+
+  The elements are processed by tiles, so the strided reads stay in the
+  cache while the bytes of the tile are distributed.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_CodecShuffle(const unsigned char* src, unsigned char* dst,
+ size_t nbEle, size_t eleSize) {
+    size_t t, i, b;
+    for (t = 0; t < nbEle; t += FTI_CODEC_TILE) {
+        size_t end = (t + FTI_CODEC_TILE < nbEle) ? t + FTI_CODEC_TILE : nbEle;
+        for (b = 0; b < eleSize; b++) {
+            unsigned char* out = dst + b * nbEle;
+            for (i = t; i < end; i++) {
+                out[i] = src[i * eleSize + b];
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reverts FTI_CodecShuffle.
+  @param      src             Shuffled bytes.
+  @param      dst             Restored elements.
+  @param      nbEle           Number of elements.
+  @param      eleSize         Size of an element.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_CodecUnshuffle(const unsigned char* src, unsigned char* dst,
+ size_t nbEle, size_t eleSize) {
+    size_t t, i, b;
+    for (t = 0; t < nbEle; t += FTI_CODEC_TILE) {
+        size_t end = (t + FTI_CODEC_TILE < nbEle) ? t + FTI_CODEC_TILE : nbEle;
+        for (b = 0; b < eleSize; b++) {
+            const unsigned char* in = src + b * nbEle;
+            for (i = t; i < end; i++) {
+                dst[i * eleSize + b] = in[i];
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Encodes one frame of a dataset into its output slot.
+  @param      arg             The FTIT_codecJob.
+  @param      idx             Index of the frame.
+
+  Has the signature of FTIT_task to be executed by the thread pool.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_CodecEncodeTask(void* arg, int idx) {
+    FTIT_codecJob* job = (FTIT_codecJob*) arg;
+    size_t offset = (size_t) idx * job->frameSize;
+    size_t len = job->data->size - offset;
+    if (len > job->frameSize) len = job->frameSize;
+
+    unsigned char* raw = (unsigned char*) job->data->ptr + offset;
+    char* slot = job->out + (size_t) idx * job->slotSize;
+    unsigned char* payload = (unsigned char*) slot + sizeof(FTIT_codecFrame);
+    unsigned char* src = raw;
+    unsigned char* tmp = NULL;
+
+    job->sizes[idx] = 0;
+    if (job->codec & FTI_CODEC_SHUFFLE) {
+        if (job->codec & FTI_CODEC_ZLIB) {
+            tmp = (unsigned char*) malloc(len);
+            if (tmp == NULL) return;
+            src = tmp;
+        } else {
+            src = payload;
+        }
+        FTI_CodecShuffle(raw, src, len / job->data->eleSize,
+         job->data->eleSize);
+    }
+
+    FTIT_codecFrame hdr;
+    hdr.rawSize = len;
+    hdr.size = len;
+#ifndef FTI_NOZLIB
+    if (job->codec & FTI_CODEC_ZLIB) {
+        uLongf dlen = job->slotSize - sizeof(FTIT_codecFrame);
+        if (compress2(payload, &dlen, src, len, job->level) == Z_OK &&
+         dlen < len) {
+            hdr.size = dlen;
+        }
+    }
+#endif
+    if (hdr.size == len && src != payload) {
+        memcpy(payload, src, len);
+    }
+    memcpy(slot, &hdr, sizeof(FTIT_codecFrame));
+    job->sizes[idx] = sizeof(FTIT_codecFrame) + hdr.size;
+    free(tmp);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Encodes a dataset.
+  @param      pool            Thread pool encoding the frames.
+  @param      data            Dataset to encode.
+  @param      codec           Filters to apply.
+  @param      level           Compression level of zlib.
+  @param      buf             Encoded image of the dataset.
+  @return     integer         FTI_SCES if successful.
+
+  The frames are encoded in slots large enough for the worst case and
+  compacted afterwards, so the frames are encoded in any order.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_CodecEncodeDataset(FTIT_threadpool* pool, FTIT_dataset* data,
+ int codec, int level, FTIT_codecBuffer* buf) {
+    char str[FTI_BUFS];
+    FTIT_codecJob job;
+    job.data = data;
+    job.codec = codec;
+    job.level = level;
+    job.frameSize = FTI_CODEC_FRAME_SIZE;
+    if (codec & FTI_CODEC_SHUFFLE) {
+        // frames must hold whole elements to be shuffled independently
+        job.frameSize -= job.frameSize % data->eleSize;
+    }
+    job.slotSize = sizeof(FTIT_codecFrame) + job.frameSize;
+#ifndef FTI_NOZLIB
+    if (codec & FTI_CODEC_ZLIB) {
+        job.slotSize = sizeof(FTIT_codecFrame) + compressBound(job.frameSize);
+    }
+#endif
+
+    int64_t nbFrames = (data->size + job.frameSize - 1) / job.frameSize;
+    job.out = (char*) malloc(nbFrames * job.slotSize);
+    job.sizes = talloc(size_t, nbFrames);
+    if (job.out == NULL || job.sizes == NULL) {
+        snprintf(str, FTI_BUFS, "Unable to allocate the encoding buffer of"
+         " dataset #%d.", data->id);
+        FTI_Print(str, FTI_EROR);
+        free(job.out);
+        free(job.sizes);
+        return FTI_NSCS;
+    }
+
+    FTI_ThreadPoolRun(pool, nbFrames, FTI_CodecEncodeTask, &job);
+
+    int64_t i, size = 0;
+    for (i = 0; i < nbFrames; i++) {
+        if (job.sizes[i] == 0) {
+            snprintf(str, FTI_BUFS, "Unable to encode dataset #%d.", data->id);
+            FTI_Print(str, FTI_EROR);
+            free(job.out);
+            free(job.sizes);
+            return FTI_NSCS;
+        }
+        memmove(job.out + size, job.out + i * job.slotSize, job.sizes[i]);
+        size += job.sizes[i];
+    }
+    free(job.sizes);
+
+    char* out = (char*) realloc(job.out, size);
+    buf->ptr = (out != NULL) ? out : job.out;
+    buf->size = size;
+
+    snprintf(str, FTI_BUFS, "Dataset #%d encoded (codec: %d) from %ld to %ld"
+     " bytes.", data->id, codec, data->size, size);
+    FTI_Print(str, FTI_DBUG);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the codec applied to a dataset.
+  @param      FTI_Conf        Configuration metadata.
+  @param      data            Dataset to checkpoint.
+  @return     integer         Combination of FTI_CODEC_* flags.
+
+  The codec set with FTI_ATTRIBUTE_CODEC takes precedence over the one of
+  the configuration. Filters that do not apply to the dataset are dropped.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_CodecSelect(FTIT_configuration* FTI_Conf, FTIT_dataset* data) {
+    int codec = (data->attribute.codec == FTI_CODEC_DEFAULT) ?
+     FTI_Conf->codec : data->attribute.codec;
+
+    // device data is streamed by the backends without a host copy
+    if (data->isDevicePtr || data->ptr == NULL || data->size == 0) {
+        return FTI_CODEC_NONE;
+    }
+    if (data->eleSize <= 1 || data->eleSize > FTI_CODEC_FRAME_SIZE) {
+        codec &= ~FTI_CODEC_SHUFFLE;
+    }
+#ifdef FTI_NOZLIB
+    codec &= ~FTI_CODEC_ZLIB;
+#endif
+    return codec & (FTI_CODEC_ZLIB | FTI_CODEC_SHUFFLE);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Marks all the datasets as stored raw.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Data        Dataset metadata.
+  @return     integer         FTI_SCES if successful.
+
+  Called before checkpoints written without the codec stage.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_CodecReset(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data) {
+    FTIT_dataset* data;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
+
+    int i;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        data[i].codec = FTI_CODEC_NONE;
+    }
+    FTI_Exec->encodedSize = 0;
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Encodes the protected datasets of a checkpoint.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      bufs            Encoded images, indexed like the datasets.
+  @return     integer         FTI_SCES if successful.
+
+  Sets the codec of each dataset and the resulting file size in
+  'encodedSize'. '*bufs' is left NULL if no dataset is encoded, otherwise
+  it has to be released with FTI_CodecFree. The codec stage is only
+  available for the POSIX, MPI-IO and IME backends, and not for dCP.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_CodecEncode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_checkpoint* FTI_Ckpt, FTIT_keymap* FTI_Data, FTIT_codecBuffer** bufs) {
+    *bufs = NULL;
+    if (FTI_CodecReset(FTI_Exec, FTI_Data) != FTI_SCES) return FTI_NSCS;
+
+    if ((FTI_Conf->ioMode != FTI_IO_POSIX && FTI_Conf->ioMode != FTI_IO_MPI &&
+     FTI_Conf->ioMode != FTI_IO_IME && FTI_Conf->ioMode != FTI_IO_IOURING) ||
+     (FTI_Conf->dcpPosix && FTI_Ckpt[4].isDcp)) {
+        return FTI_SCES;
+    }
+
+    FTIT_dataset* data;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
+
+    int i, nbEncoded = 0;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        data[i].codec = FTI_CodecSelect(FTI_Conf, &data[i]);
+        nbEncoded += (data[i].codec != FTI_CODEC_NONE);
+    }
+    if (nbEncoded == 0) return FTI_SCES;
+
+    FTIT_codecBuffer* enc = (FTIT_codecBuffer*) calloc(FTI_Exec->nbVar,
+     sizeof(FTIT_codecBuffer));
+    if (enc == NULL) {
+        FTI_Print("Unable to allocate the encoding buffers.", FTI_EROR);
+        FTI_CodecReset(FTI_Exec, FTI_Data);
+        return FTI_NSCS;
+    }
+
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, FTI_Conf->compressThreads);
+
+    int res = FTI_SCES;
+    int64_t size = 0;
+    for (i = 0; i < FTI_Exec->nbVar && res == FTI_SCES; i++) {
+        if (data[i].codec != FTI_CODEC_NONE) {
+            res = FTI_CodecEncodeDataset(&pool, &data[i], data[i].codec,
+             FTI_Conf->zlibLevel, &enc[i]);
+            size += enc[i].size;
+        } else {
+            size += data[i].size;
+        }
+    }
+    FTI_ThreadPoolFinalize(&pool);
+
+    if (res != FTI_SCES) {
+        FTI_CodecFree(enc, FTI_Exec->nbVar);
+        FTI_CodecReset(FTI_Exec, FTI_Data);
+        return FTI_NSCS;
+    }
+
+    FTI_Exec->encodedSize = size;
+    *bufs = enc;
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Releases the encoded images of the datasets.
+  @param      bufs            Encoded images from FTI_CodecEncode.
+  @param      nbVar           Number of datasets.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_CodecFree(FTIT_codecBuffer* bufs, int nbVar) {
+    if (bufs == NULL) return;
+
+    int i;
+    for (i = 0; i < nbVar; i++) {
+        free(bufs[i].ptr);
+    }
+    free(bufs);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads and decodes a dataset from a checkpoint file.
+  @param      data            Dataset to recover.
+  @param      fd              Checkpoint file.
+  @param      pos             Offset of the dataset in the file.
+  @return     integer         FTI_SCES if successful.
+
+  Reads 'sizeStored' bytes into the buffer of the dataset, decoding the
+  frames according to the codec found in the metadata. The file offset
+  is not used, several datasets can be read concurrently.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_CodecRead(FTIT_dataset* data, int fd, int64_t pos) {
+    char str[FTI_BUFS];
+
+    if (data->codec == FTI_CODEC_NONE) {
+        if (FTI_ReadAt(fd, data->ptr, data->sizeStored, pos) != FTI_SCES) {
+            FTI_Print("Could not read FTI checkpoint file.", FTI_EROR);
+            return FTI_NSCS;
+        }
+        return FTI_SCES;
+    }
+
+#ifdef FTI_NOZLIB
+    if (data->codec & FTI_CODEC_ZLIB) {
+        snprintf(str, FTI_BUFS, "Dataset #%d is deflated but FTI was built"
+         " without zlib.", data->id);
+        FTI_Print(str, FTI_EROR);
+        return FTI_NSCS;
+    }
+#endif
+    if (data->isDevicePtr) {
+        snprintf(str, FTI_BUFS, "Dataset #%d is encoded and cannot be"
+         " recovered to device memory.", data->id);
+        FTI_Print(str, FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    bool shuffled = (data->codec & FTI_CODEC_SHUFFLE);
+    unsigned char* in = talloc(unsigned char, FTI_CODEC_FRAME_SIZE);
+    unsigned char* tmp = shuffled ?
+     talloc(unsigned char, FTI_CODEC_FRAME_SIZE) : NULL;
+    if (in == NULL || (shuffled && tmp == NULL)) {
+        FTI_Print("Unable to allocate the decoding buffers.", FTI_EROR);
+        free(in);
+        free(tmp);
+        return FTI_NSCS;
+    }
+
+    int res = FTI_SCES;
+    int64_t done = 0;
+    while (done < data->sizeStored && res == FTI_SCES) {
+        FTIT_codecFrame hdr;
+        if (FTI_ReadAt(fd, &hdr, sizeof(FTIT_codecFrame), pos) != FTI_SCES ||
+         hdr.rawSize == 0 || hdr.rawSize > FTI_CODEC_FRAME_SIZE ||
+         hdr.rawSize > data->sizeStored - done || hdr.size > hdr.rawSize ||
+         (shuffled && hdr.rawSize % data->eleSize != 0)) {
+            res = FTI_NSCS;
+            break;
+        }
+        pos += sizeof(FTIT_codecFrame);
+
+        unsigned char* dst = (unsigned char*) data->ptr + done;
+        unsigned char* out = shuffled ? tmp : dst;
+        if (hdr.size < hdr.rawSize) {
+            if (FTI_ReadAt(fd, in, hdr.size, pos) != FTI_SCES) {
+                res = FTI_NSCS;
+                break;
+            }
+#ifndef FTI_NOZLIB
+            uLongf len = hdr.rawSize;
+            if (uncompress(out, &len, in, hdr.size) != Z_OK ||
+             len != hdr.rawSize) {
+                res = FTI_NSCS;
+                break;
+            }
+#endif
+        } else if (FTI_ReadAt(fd, out, hdr.rawSize, pos) != FTI_SCES) {
+            res = FTI_NSCS;
+            break;
+        }
+        if (shuffled) {
+            FTI_CodecUnshuffle(tmp, dst, hdr.rawSize / data->eleSize,
+             data->eleSize);
+        }
+        pos += hdr.size;
+        done += hdr.rawSize;
+    }
+    free(in);
+    free(tmp);
+
+    if (res != FTI_SCES) {
+        snprintf(str, FTI_BUFS, "Could not decode dataset #%d from the"
+         " checkpoint file.", data->id);
+        FTI_Print(str, FTI_EROR);
+    }
+    return res;
+}
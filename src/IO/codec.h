@@ -0,0 +1,40 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   codec.h
+ */
+
+#ifndef FTI_SRC_IO_CODEC_H_
+#define FTI_SRC_IO_CODEC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of raw bytes encoded in one frame **/
+#define FTI_CODEC_FRAME_SIZE (4 * 1024 * 1024)
+
+/** Header of an encoded frame **/
+typedef struct FTIT_codecFrame {
+    uint32_t    rawSize;        /**< Size of the decoded frame            */
+    uint32_t    size;           /**< Size of the payload in the file      */
+} FTIT_codecFrame;
+
+/** Encoded image of a dataset **/
+typedef struct FTIT_codecBuffer {
+    void*       ptr;            /**< Encoded data, NULL if stored raw     */
+    int64_t     size;           /**< Size of the encoded data             */
+} FTIT_codecBuffer;
+
+int FTI_CodecReset(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data);
+int FTI_CodecSelect(FTIT_configuration* FTI_Conf, FTIT_dataset* data);
+int FTI_CodecEncode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_checkpoint* FTI_Ckpt, FTIT_keymap* FTI_Data, FTIT_codecBuffer** bufs);
+void FTI_CodecFree(FTIT_codecBuffer* bufs, int nbVar);
+int FTI_CodecRead(FTIT_dataset* data, int fd, int64_t pos);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // FTI_SRC_IO_CODEC_H_
@@ -601,13 +601,13 @@ int MD5GPU(FTIT_dataset *data){
  **/
 /*-------------------------------------------------------------------------*/
 int MD5CPU(FTIT_dataset *data){
-    uint32_t dataSize = data->size;
+    uint64_t dataSize = data->size;
     unsigned char block[md5ChunkSize];
     size_t i;
     unsigned char *ptr = (unsigned char *) data->ptr;
     for ( i = 0 ; i < data->size; i+=md5ChunkSize){
         unsigned int blockId = i/md5ChunkSize;
-        unsigned int hashIdx = blockId*16;
+        size_t hashIdx = (size_t) blockId*16;
         unsigned int chunkSize = ( (dataSize-i) < md5ChunkSize ) ? dataSize-i: md5ChunkSize;
         if( chunkSize < md5ChunkSize ) {
             memset( block, 0x0, md5ChunkSize );
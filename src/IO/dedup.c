@@ -0,0 +1,886 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  @file   dedup.c
+ *  @date   October, 2026
+ *  @brief  Deduplication of the blocks of the L2 and L4 copies.
+ *
+ *  The checkpoint files are cut into 'dedup_block_size' blocks and each
+ *  full block is fingerprinted with MD5, as the dCP does for the blocks
+ *  of the datasets. Equal fingerprints are taken as equal blocks.
+ *
+ *  - L4: the files of a node are flushed together. A block already
+ *    present earlier in the files of the node is left as a hole in the
+ *    copy, and the '.ddp' map next to the file records where it is
+ *    stored. The recovery rebuilds the blocks from the map.
+ *  - L2: the partner tells which blocks its own checkpoint file holds,
+ *    these are not sent but copied from that file on the partner side.
+ *    The partner copy is thus complete and needs no map.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../interface.h"
+#include "dedup.h"
+
+/** Identification of the maps **/
+#define FTI_DEDUP_MAGIC 0x50444446
+#define FTI_DEDUP_VERSION 1
+
+/** Fingerprint of a full block of a checkpoint file **/
+typedef struct FTIT_dedupBlock {
+    unsigned char   digest[MD5_DIGEST_LENGTH];  /**< MD5 of the block     */
+    int64_t         block;      /**< Index of the block in the file       */
+    int32_t         file;       /**< Index of the file in the node        */
+    int32_t         reserved;
+} FTIT_dedupBlock;
+
+/** Block of a file stored in another file, or earlier in the same **/
+typedef struct FTIT_dedupRef {
+    int64_t         block;      /**< Index of the block in the file       */
+    int64_t         ownerBlock; /**< Index of the block in the owner      */
+    int32_t         owner;      /**< Index of the owner in the map        */
+    int32_t         reserved;
+} FTIT_dedupRef;
+
+/** Header of a map, followed by the owner names and the references **/
+typedef struct FTIT_dedupHeader {
+    uint32_t        magic;
+    uint32_t        version;
+    uint64_t        blockSize;  /**< Size of the blocks                   */
+    uint64_t        fs;         /**< Size of the file                     */
+    uint32_t        nbOwners;   /**< Number of names of owner files       */
+    uint32_t        nbRefs;     /**< Number of references                 */
+} FTIT_dedupHeader;
+
+/** Files fingerprinted by one FTI_DedupFlush call **/
+typedef struct FTIT_dedupBatch {
+    FTIT_transfer*      jobs;
+    size_t              blockSize;
+    int32_t             first;      /**< Index of the first job in node   */
+    FTIT_dedupBlock*    blocks;     /**< Fingerprints of all the jobs     */
+    int64_t*            offset;     /**< First fingerprint of each job    */
+    int*                status;
+} FTIT_dedupBatch;
+
+/* Reads 'count' bytes at 'pos', FTI_SCES if all could be read. */
+static int FTI_DedupRead(int fd, void* buf, size_t count, off_t pos) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t bytes = pread(fd, (char*) buf + done, count - done,
+         pos + done);
+        if (bytes == -1 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return FTI_NSCS;
+        }
+        done += bytes;
+    }
+    return FTI_SCES;
+}
+
+/* Writes 'count' bytes at 'pos', FTI_SCES if all could be written. */
+static int FTI_DedupWrite(int fd, const void* buf, size_t count, off_t pos) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t bytes = pwrite(fd, (const char*) buf + done, count - done,
+         pos + done);
+        if (bytes == -1 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return FTI_NSCS;
+        }
+        done += bytes;
+    }
+    return FTI_SCES;
+}
+
+/* Size of a block, only the last one of a file may be shorter. */
+static size_t FTI_DedupBlockLen(int64_t block, int64_t fs, size_t bs) {
+    int64_t left = fs - block * (int64_t) bs;
+    return (left < (int64_t) bs) ? (size_t) left : bs;
+}
+
+/* Orders the fingerprints by digest, then by position in the node. */
+static int FTI_DedupBlockCmp(const void* a, const void* b) {
+    const FTIT_dedupBlock* x = (const FTIT_dedupBlock*) a;
+    const FTIT_dedupBlock* y = (const FTIT_dedupBlock*) b;
+    int cmp = memcmp(x->digest, y->digest, MD5_DIGEST_LENGTH);
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (x->file != y->file) {
+        return (x->file < y->file) ? -1 : 1;
+    }
+    return (x->block > y->block) - (x->block < y->block);
+}
+
+static int FTI_DedupDigestCmp(const void* a, const void* b) {
+    return memcmp(((const FTIT_dedupBlock*) a)->digest,
+     ((const FTIT_dedupBlock*) b)->digest, MD5_DIGEST_LENGTH);
+}
+
+static int FTI_DedupRefCmp(const void* a, const void* b) {
+    const FTIT_dedupRef* x = (const FTIT_dedupRef*) a;
+    const FTIT_dedupRef* y = (const FTIT_dedupRef*) b;
+    return (x->block > y->block) - (x->block < y->block);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Fingerprints the full blocks of a file.
+  @param      fd              File descriptor of the file.
+  @param      fs              Size of the file.
+  @param      bs              Size of the blocks.
+  @param      file            Index of the file in the node.
+  @param      blocks          The fs / bs fingerprints to fill.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_DedupHashFile(int fd, int64_t fs, size_t bs, int32_t file,
+        FTIT_dedupBlock* blocks) {
+    int64_t nbBlocks = fs / bs;
+    posix_fadvise(fd, 0, fs, POSIX_FADV_SEQUENTIAL);
+    unsigned char* buf = talloc(unsigned char, FTI_DEDUP_CHUNK_BLOCKS * bs);
+    int res = FTI_SCES;
+    int64_t i = 0;
+    while (i < nbBlocks) {
+        int64_t n = (nbBlocks - i < FTI_DEDUP_CHUNK_BLOCKS) ? nbBlocks - i :
+         FTI_DEDUP_CHUNK_BLOCKS;
+        if (FTI_DedupRead(fd, buf, n * bs, i * bs) != FTI_SCES) {
+            res = FTI_NSCS;
+            break;
+        }
+        int64_t j;
+        for (j = 0; j < n; j++) {
+            // not MD5(), whose scratch buffer is shared between threads
+            MD5_CTX ctx;
+            MD5_Init(&ctx);
+            MD5_Update(&ctx, buf + j * bs, bs);
+            MD5_Final(blocks[i + j].digest, &ctx);
+            blocks[i + j].block = i + j;
+            blocks[i + j].file = file;
+            blocks[i + j].reserved = 0;
+        }
+        i += n;
+    }
+    free(buf);
+    return res;
+}
+
+static void FTI_DedupHashTask(void* arg, int idx) {
+    FTIT_dedupBatch* batch = (FTIT_dedupBatch*) arg;
+    FTIT_transfer* job = &batch->jobs[idx];
+    batch->status[idx] = FTI_NSCS;
+    int fd = open(job->src, O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    batch->status[idx] = FTI_DedupHashFile(fd, job->fs, batch->blockSize,
+     batch->first + idx, batch->blocks + batch->offset[idx]);
+    close(fd);
+}
+
+/* Path of a file named in the map of 'fn', in the same directory. */
+static void FTI_DedupPath(char* fn, char* name, char* path) {
+    char* sep = strrchr(fn, '/');
+    int len = (sep != NULL) ? (int) (sep - fn) + 1 : 0;
+    snprintf(path, FTI_BUFS, "%.*s%s", len, fn, name);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes the map of a flushed file.
+  @param      fn              Path of the flushed file.
+  @param      header          Header of the map.
+  @param      names           Names of the owner files.
+  @param      refs            References, sorted by block.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_DedupWriteMap(char* fn, FTIT_dedupHeader* header,
+        char (*names)[FTI_BUFS], FTIT_dedupRef* refs) {
+    char map[FTI_BUFS + sizeof(FTI_DEDUP_SUFFIX)];
+    snprintf(map, sizeof(map), "%s%s", fn, FTI_DEDUP_SUFFIX);
+    FILE* fd = fopen(map, "wb");
+    if (fd == NULL) {
+        return FTI_NSCS;
+    }
+    int res = FTI_SCES;
+    if (fwrite(header, sizeof(FTIT_dedupHeader), 1, fd) != 1 ||
+     fwrite(names, FTI_BUFS, header->nbOwners, fd) != header->nbOwners ||
+     fwrite(refs, sizeof(FTIT_dedupRef), header->nbRefs, fd) !=
+     header->nbRefs) {
+        res = FTI_NSCS;
+    }
+    if (fclose(fd) != 0) {
+        res = FTI_NSCS;
+    }
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads the map of a flushed file.
+  @param      fn              Path of the flushed file.
+  @param      header          Header of the map.
+  @param      names           Names of the owner files, to free.
+  @param      refs            References, to free.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_DedupReadMap(char* fn, FTIT_dedupHeader* header,
+        char (**names)[FTI_BUFS], FTIT_dedupRef** refs) {
+    char map[FTI_BUFS + sizeof(FTI_DEDUP_SUFFIX)], str[FTI_BUFS];
+    snprintf(map, sizeof(map), "%s%s", fn, FTI_DEDUP_SUFFIX);
+    *names = NULL;
+    *refs = NULL;
+    FILE* fd = fopen(map, "rb");
+    if (fd == NULL) {
+        snprintf(str, FTI_BUFS, "unable to open dedup map '%s'.", map);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+    int res = FTI_NSCS;
+    if (fread(header, sizeof(FTIT_dedupHeader), 1, fd) != 1 ||
+     header->magic != FTI_DEDUP_MAGIC ||
+     header->version != FTI_DEDUP_VERSION || header->blockSize == 0) {
+        goto end;
+    }
+    *names = talloc(char[FTI_BUFS], header->nbOwners + 1);
+    *refs = talloc(FTIT_dedupRef, header->nbRefs + 1);
+    if (fread(*names, FTI_BUFS, header->nbOwners, fd) != header->nbOwners ||
+     fread(*refs, sizeof(FTIT_dedupRef), header->nbRefs, fd) !=
+     header->nbRefs) {
+        goto end;
+    }
+    uint32_t i;
+    for (i = 0; i < header->nbOwners; i++) {
+        (*names)[i][FTI_BUFS - 1] = '\0';
+    }
+    for (i = 0; i < header->nbRefs; i++) {
+        FTIT_dedupRef* ref = &(*refs)[i];
+        if (ref->owner < 0 || ref->owner >= (int32_t) header->nbOwners ||
+         ref->block < 0 || ref->ownerBlock < 0 ||
+         (ref->block + 1) * header->blockSize > header->fs) {
+            goto end;
+        }
+    }
+    res = FTI_SCES;
+
+end:
+    fclose(fd);
+    if (res != FTI_SCES) {
+        snprintf(str, FTI_BUFS, "dedup map '%s' is corrupted.", map);
+        FTI_Print(str, FTI_WARN);
+        free(*names);
+        free(*refs);
+        *names = NULL;
+        *refs = NULL;
+    }
+    return res;
+}
+
+/* Opens the owner files of a map, FTI_SCES if all could be opened. */
+static int FTI_DedupOpenOwners(char* fn, FTIT_dedupHeader* header,
+        char (*names)[FTI_BUFS], int* fds) {
+    char path[FTI_BUFS], str[FTI_BUFS];
+    int res = FTI_SCES;
+    uint32_t i;
+    for (i = 0; i < header->nbOwners; i++) {
+        FTI_DedupPath(fn, names[i], path);
+        fds[i] = open(path, O_RDONLY);
+        if (fds[i] == -1) {
+            snprintf(str, FTI_BUFS, "Missing dedup owner file: \"%s\"", path);
+            FTI_Print(str, FTI_WARN);
+            res = FTI_NSCS;
+        }
+    }
+    return res;
+}
+
+static void FTI_DedupCloseOwners(FTIT_dedupHeader* header, int* fds) {
+    uint32_t i;
+    for (i = 0; i < header->nbOwners; i++) {
+        if (fds[i] != -1) {
+            close(fds[i]);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Flushes the files of the node, storing equal blocks once.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      jobs            Copies to perform.
+  @param      nbJobs          Number of copies.
+  @return     integer         FTI_SCES if all copies succeeded.
+
+  The heads flush all the files of the node at once, the application
+  processes exchange the fingerprints of their file with the other
+  processes of the node. The first occurrence of a block, in the order
+  of the ranks, is copied, the other ones are left as holes and listed
+  in the map of their file. A file that cannot be fingerprinted is
+  copied entirely and is not referenced.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_DedupFlush(FTIT_configuration* FTI_Conf, FTIT_topology* FTI_Topo,
+        FTIT_transfer* jobs, int nbJobs) {
+    size_t bs = FTI_Conf->dedupBlockSize;
+    char str[FTI_BUFS];
+
+    FTIT_dedupBatch batch;
+    batch.jobs = jobs;
+    batch.blockSize = bs;
+    batch.first = 0;
+    batch.offset = talloc(int64_t, nbJobs + 1);
+    batch.status = talloc(int, nbJobs);
+    int i;
+    batch.offset[0] = 0;
+    for (i = 0; i < nbJobs; i++) {
+        batch.offset[i + 1] = batch.offset[i] + jobs[i].fs / bs;
+    }
+    MPI_Comm nodeComm = MPI_COMM_NULL;
+    int nbFiles = nbJobs;
+    if (!FTI_Topo->amIaHead) {
+        MPI_Comm_split(FTI_COMM_WORLD, FTI_Topo->nodeID, FTI_Topo->myRank,
+         &nodeComm);
+        MPI_Comm_rank(nodeComm, &batch.first);
+        MPI_Comm_size(nodeComm, &nbFiles);
+    }
+    batch.blocks = talloc(FTIT_dedupBlock, batch.offset[nbJobs] + 1);
+
+    int nbThreads = (FTI_Conf->transferThreads < nbJobs) ?
+     FTI_Conf->transferThreads : nbJobs;
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, nbThreads);
+    FTI_ThreadPoolRun(&pool, nbJobs, FTI_DedupHashTask, &batch);
+    FTI_ThreadPoolFinalize(&pool);
+
+    // The fingerprints of the files that could not be read are dropped
+    int64_t nbLocal = 0;
+    for (i = 0; i < nbJobs; i++) {
+        if (batch.status[i] == FTI_SCES) {
+            int64_t n = batch.offset[i + 1] - batch.offset[i];
+            memmove(batch.blocks + nbLocal, batch.blocks + batch.offset[i],
+             n * sizeof(FTIT_dedupBlock));
+            nbLocal += n;
+        }
+    }
+
+    FTIT_dedupBlock* all = batch.blocks;
+    int64_t nbAll = nbLocal;
+    char (*names)[FTI_BUFS] = talloc(char[FTI_BUFS], nbFiles);
+    memset(names, 0, (size_t) nbFiles * FTI_BUFS);
+    char name[FTI_BUFS] = { 0 };
+    if (nodeComm == MPI_COMM_NULL) {
+        for (i = 0; i < nbJobs; i++) {
+            char* sep = strrchr(jobs[i].dst, '/');
+            strncpy(names[i], (sep != NULL) ? sep + 1 : jobs[i].dst,
+             FTI_BUFS - 1);
+        }
+    } else {
+        char* sep = strrchr(jobs[0].dst, '/');
+        strncpy(name, (sep != NULL) ? sep + 1 : jobs[0].dst, FTI_BUFS - 1);
+        MPI_Allgather(name, FTI_BUFS, MPI_CHAR, names, FTI_BUFS, MPI_CHAR,
+         nodeComm);
+        int bytes = nbLocal * sizeof(FTIT_dedupBlock);
+        int* counts = talloc(int, nbFiles);
+        int* displs = talloc(int, nbFiles);
+        MPI_Allgather(&bytes, 1, MPI_INT, counts, 1, MPI_INT, nodeComm);
+        int64_t total = 0;
+        for (i = 0; i < nbFiles; i++) {
+            displs[i] = total;
+            total += counts[i];
+        }
+        nbAll = total / sizeof(FTIT_dedupBlock);
+        all = talloc(FTIT_dedupBlock, nbAll + 1);
+        MPI_Allgatherv(batch.blocks, bytes, MPI_BYTE, all, counts, displs,
+         MPI_BYTE, nodeComm);
+        free(counts);
+        free(displs);
+        MPI_Comm_free(&nodeComm);
+    }
+    qsort(all, nbAll, sizeof(FTIT_dedupBlock), FTI_DedupBlockCmp);
+
+    // The first block of a run of equal blocks is the one stored
+    int64_t* nbRefs = calloc(nbJobs, sizeof(int64_t));
+    FTIT_dedupRef** refs = calloc(nbJobs, sizeof(FTIT_dedupRef*));
+    int pass;
+    for (pass = 0; pass < 2; pass++) {
+        int64_t j, k = 0;
+        for (j = 1; j < nbAll; j++) {
+            if (memcmp(all[j].digest, all[k].digest, MD5_DIGEST_LENGTH)) {
+                k = j;
+                continue;
+            }
+            int job = all[j].file - batch.first;
+            if (job < 0 || job >= nbJobs) {
+                continue;
+            }
+            if (pass == 0) {
+                nbRefs[job]++;
+            } else {
+                FTIT_dedupRef* ref = &refs[job][nbRefs[job]++];
+                ref->block = all[j].block;
+                ref->ownerBlock = all[k].block;
+                ref->owner = all[k].file;
+                ref->reserved = 0;
+            }
+        }
+        for (i = 0; i < nbJobs && pass == 0; i++) {
+            refs[i] = talloc(FTIT_dedupRef, nbRefs[i] + 1);
+            nbRefs[i] = 0;
+        }
+    }
+
+    uint8_t** skip = calloc(nbJobs, sizeof(uint8_t*));
+    for (i = 0; i < nbJobs; i++) {
+        jobs[i].skip = NULL;
+        jobs[i].blockSize = bs;
+        jobs[i].skipped = nbRefs[i] * bs;
+        if (nbRefs[i] > 0) {
+            qsort(refs[i], nbRefs[i], sizeof(FTIT_dedupRef), FTI_DedupRefCmp);
+            skip[i] = calloc((jobs[i].fs + bs - 1) / bs, sizeof(uint8_t));
+            int64_t j;
+            for (j = 0; j < nbRefs[i]; j++) {
+                skip[i][refs[i][j].block] = 1;
+            }
+            jobs[i].skip = skip[i];
+        }
+        snprintf(str, FTI_BUFS, "L4 dedup: %ld of %ld blocks of '%s' stored"
+         " in other blocks.", nbRefs[i], (long) (jobs[i].fs / bs),
+         jobs[i].src);
+        FTI_Print(str, FTI_DBUG);
+    }
+
+    int res = FTI_TransferFiles(FTI_Conf, jobs, nbJobs);
+    for (i = 0; i < nbJobs; i++) {
+        if (jobs[i].status != FTI_SCES || nbRefs[i] == 0) {
+            continue;
+        }
+        FTIT_dedupHeader header;
+        header.magic = FTI_DEDUP_MAGIC;
+        header.version = FTI_DEDUP_VERSION;
+        header.blockSize = bs;
+        header.fs = jobs[i].fs;
+        header.nbOwners = nbFiles;
+        header.nbRefs = nbRefs[i];
+        if (FTI_DedupWriteMap(jobs[i].dst, &header, names, refs[i]) !=
+         FTI_SCES) {
+            snprintf(str, FTI_BUFS, "unable to write the dedup map of '%s'.",
+             jobs[i].dst);
+            FTI_Print(str, FTI_WARN);
+            res = FTI_NSCS;
+        }
+    }
+
+    for (i = 0; i < nbJobs; i++) {
+        free(refs[i]);
+        free(skip[i]);
+        jobs[i].skip = NULL;
+    }
+    free(refs);
+    free(skip);
+    free(nbRefs);
+    free(names);
+    if (all != batch.blocks) {
+        free(all);
+    }
+    free(batch.blocks);
+    free(batch.offset);
+    free(batch.status);
+    return res;
+}
+
+/* Returns the size of the next L2 message, made of the blocks from 'cur'
+   that are not referenced, and moves 'cur' past the blocks it covers. */
+static int FTI_DedupChunk(int64_t* ref, int64_t nbBlocks, int64_t fs,
+        size_t bs, int64_t* cur) {
+    int64_t len = 0;
+    int n = 0;
+    while (*cur < nbBlocks) {
+        if (ref[*cur] < 0) {
+            if (n == FTI_DEDUP_CHUNK_BLOCKS) {
+                break;
+            }
+            len += FTI_DedupBlockLen(*cur, fs, bs);
+            n++;
+        }
+        (*cur)++;
+    }
+    return (int) len;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Exchanges the checkpoint files with the partners.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      lfn             Checkpoint file sent to the destination.
+  @param      pfn             Partner file received from the source.
+  @param      destination     destination group rank
+  @param      source          source group rank
+  @return     integer         FTI_SCES if successful.
+
+  Each process sends the fingerprints of its file to the source, which
+  then only sends the blocks the process does not hold yet and the
+  references of the others. Both directions run at the same time, as
+  the copy of FTI_ExchangePtner. On a local error, the protocol is
+  completed, so that the partners do not block, and the error is
+  returned.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_DedupExchange(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+        char* lfn, char* pfn, int destination, int source) {
+    size_t bs = FTI_Conf->dedupBlockSize;
+    int64_t fs = FTI_Exec->ckptMeta.fs;
+    int64_t pfs = FTI_Exec->ckptMeta.pfs;
+    int64_t nbFull = fs / bs;
+    int64_t nbBlocks = (fs + bs - 1) / bs;
+    int64_t nbSrc = (pfs + bs - 1) / bs;
+    MPI_Comm comm = FTI_Exec->groupComm;
+    int tag = FTI_Conf->generalTag;
+    char str[FTI_BUFS];
+
+    int res = FTI_SCES;
+    int in = open(lfn, O_RDONLY);
+    if (in == -1) {
+        FTI_Print("FTI failed to open L2 Ckpt. file.", FTI_DBUG);
+        res = FTI_NSCS;
+    }
+    int out = open(pfn, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (out == -1) {
+        FTI_Print("FTI failed to open L2 ptner file.", FTI_DBUG);
+        res = FTI_NSCS;
+    }
+
+    // The destination tells which blocks it holds already
+    FTIT_dedupBlock* own = talloc(FTIT_dedupBlock, nbFull + 1);
+    if (res == FTI_SCES &&
+     FTI_DedupHashFile(in, fs, bs, 0, own) != FTI_SCES) {
+        FTI_Print("FTI failed to read L2 Ckpt. file.", FTI_EROR);
+        res = FTI_NSCS;
+    }
+    int nbOwn = (res == FTI_SCES) ? nbFull : 0;
+    int nbDest;
+    MPI_Sendrecv(&nbOwn, 1, MPI_INT, source, tag, &nbDest, 1, MPI_INT,
+     destination, tag, comm, MPI_STATUS_IGNORE);
+    FTIT_dedupBlock* dest = talloc(FTIT_dedupBlock, nbDest + 1);
+    MPI_Sendrecv(own, nbOwn * sizeof(FTIT_dedupBlock), MPI_BYTE, source, tag,
+     dest, nbDest * sizeof(FTIT_dedupBlock), MPI_BYTE, destination, tag,
+     comm, MPI_STATUS_IGNORE);
+    qsort(dest, nbDest, sizeof(FTIT_dedupBlock), FTI_DedupBlockCmp);
+
+    int64_t* ref = talloc(int64_t, nbBlocks + 1);
+    int64_t b, nbRefs = 0;
+    for (b = 0; b < nbBlocks; b++) {
+        ref[b] = -1;
+        if (b < nbFull && res == FTI_SCES) {
+            FTIT_dedupBlock* found = bsearch(&own[b], dest, nbDest,
+             sizeof(FTIT_dedupBlock), FTI_DedupDigestCmp);
+            if (found != NULL) {
+                ref[b] = found->block;
+                nbRefs++;
+            }
+        }
+    }
+    int64_t* srcRef = talloc(int64_t, nbSrc + 1);
+    MPI_Sendrecv(ref, nbBlocks, MPI_INT64_T, destination, tag, srcRef, nbSrc,
+     MPI_INT64_T, source, tag, comm, MPI_STATUS_IGNORE);
+    for (b = 0; b < nbSrc && res == FTI_SCES; b++) {
+        if (srcRef[b] < -1 || srcRef[b] >= nbOwn ||
+         (srcRef[b] >= 0 && FTI_DedupBlockLen(b, pfs, bs) != bs)) {
+            FTI_Print("L2 received invalid dedup references.", FTI_EROR);
+            res = FTI_NSCS;
+        }
+    }
+    snprintf(str, FTI_BUFS, "L2 dedup: %ld of %ld blocks not sent.",
+     nbRefs, nbBlocks);
+    FTI_Print(str, FTI_DBUG);
+
+    char* sendBuf = talloc(char, FTI_DEDUP_CHUNK_BLOCKS * bs);
+    char* recvBuf = talloc(char, FTI_DEDUP_CHUNK_BLOCKS * bs);
+    char* block = talloc(char, bs);
+    int64_t sent = 0, recvd = 0;  // next blocks to send and to receive
+    while (sent < nbBlocks || recvd < nbSrc) {
+        MPI_Request req[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+        int64_t first = recvd;
+        if (recvd < nbSrc) {
+            int size = FTI_DedupChunk(srcRef, nbSrc, pfs, bs, &recvd);
+            MPI_Irecv(recvBuf, size, MPI_CHAR, source, tag, comm, &req[0]);
+        }
+        if (sent < nbBlocks) {
+            int64_t from = sent;
+            int size = FTI_DedupChunk(ref, nbBlocks, fs, bs, &sent);
+            int64_t pos = 0;
+            for (b = from; b < sent && res == FTI_SCES; b++) {
+                if (ref[b] >= 0) {
+                    continue;
+                }
+                size_t len = FTI_DedupBlockLen(b, fs, bs);
+                if (FTI_DedupRead(in, sendBuf + pos, len, b * bs) !=
+                 FTI_SCES) {
+                    FTI_Print("FTI failed to read L2 Ckpt. file.", FTI_EROR);
+                    res = FTI_NSCS;
+                }
+                pos += len;
+            }
+            MPI_Isend(sendBuf, size, MPI_CHAR, destination, tag, comm,
+             &req[1]);
+        }
+        MPI_Wait(&req[0], MPI_STATUS_IGNORE);
+        // The referenced blocks are copied from the local file
+        int64_t pos = 0;
+        for (b = first; b < recvd && res == FTI_SCES; b++) {
+            size_t len = FTI_DedupBlockLen(b, pfs, bs);
+            char* data = recvBuf + pos;
+            if (srcRef[b] >= 0) {
+                data = block;
+                if (FTI_DedupRead(in, data, bs, srcRef[b] * bs) != FTI_SCES) {
+                    FTI_Print("FTI failed to read L2 Ckpt. file.", FTI_EROR);
+                    res = FTI_NSCS;
+                    break;
+                }
+            } else {
+                pos += len;
+            }
+            if (FTI_DedupWrite(out, data, len, b * bs) != FTI_SCES) {
+                FTI_Print("FTI failed to write L2 ptner file.", FTI_EROR);
+                res = FTI_NSCS;
+            }
+        }
+        MPI_Wait(&req[1], MPI_STATUS_IGNORE);
+    }
+
+    free(sendBuf);
+    free(recvBuf);
+    free(block);
+    free(own);
+    free(dest);
+    free(ref);
+    free(srcRef);
+    if (in != -1) {
+        close(in);
+    }
+    if (out != -1 && close(out) == -1) {
+        res = FTI_NSCS;
+    }
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Tells if some blocks of a flushed file are stored elsewhere.
+  @param      fn              Path of the flushed file.
+  @return     bool            TRUE if the file has a map.
+ **/
+/*-------------------------------------------------------------------------*/
+bool FTI_DedupMapped(char* fn) {
+    char map[FTI_BUFS + sizeof(FTI_DEDUP_SUFFIX)];
+    snprintf(map, sizeof(map), "%s%s", fn, FTI_DEDUP_SUFFIX);
+    return access(map, F_OK) == 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Checks a flushed file, including the blocks stored elsewhere.
+  @param      fn              Path of the flushed file.
+  @param      fs              Expected size of the file.
+  @param      checksum        Expected checksum, empty to skip it.
+  @return     integer         0 if the file is valid, 1 otherwise.
+
+  Same as FTI_CheckFile for a file without map. Otherwise the owner files
+  must exist and the checksum is computed as if the referenced blocks
+  were in the file.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_DedupCheckFile(char* fn, int64_t fs, char* checksum) {
+    if (!FTI_DedupMapped(fn)) {
+        return FTI_CheckFile(fn, fs, checksum);
+    }
+    char str[FTI_BUFS];
+    struct stat st;
+    FTIT_dedupHeader header;
+    char (*names)[FTI_BUFS];
+    FTIT_dedupRef* refs;
+    if (stat(fn, &st) != 0 || st.st_size != fs ||
+     FTI_DedupReadMap(fn, &header, &names, &refs) != FTI_SCES) {
+        snprintf(str, sizeof(str), "Missing file: \"%s\"", fn);
+        FTI_Print(str, FTI_WARN);
+        return 1;
+    }
+    int* owners = talloc(int, header.nbOwners + 1);
+    int res = FTI_DedupOpenOwners(fn, &header, names, owners);
+    int fd = open(fn, O_RDONLY);
+    if (header.fs != (uint64_t) fs || fd == -1) {
+        res = FTI_NSCS;
+    }
+
+    if (res == FTI_SCES && strlen(checksum)) {
+        size_t bs = header.blockSize;
+        int64_t nbBlocks = (fs + bs - 1) / bs;
+        unsigned char* buf = talloc(unsigned char, bs);
+        MD5_CTX ctx;
+        MD5_Init(&ctx);
+        uint32_t next = 0;
+        int64_t b;
+        for (b = 0; b < nbBlocks && res == FTI_SCES; b++) {
+            size_t len = FTI_DedupBlockLen(b, fs, bs);
+            if (next < header.nbRefs && refs[next].block == b) {
+                res = FTI_DedupRead(owners[refs[next].owner], buf, len,
+                 refs[next].ownerBlock * bs);
+                next++;
+            } else {
+                res = FTI_DedupRead(fd, buf, len, b * bs);
+            }
+            MD5_Update(&ctx, buf, len);
+        }
+        unsigned char hash[MD5_DIGEST_LENGTH];
+        MD5_Final(hash, &ctx);
+        free(buf);
+
+        char sum[MD5_DIGEST_STRING_LENGTH];
+        int i;
+        for (i = 0; i < MD5_DIGEST_LENGTH; i++) {
+            snprintf(&sum[2 * i], MD5_DIGEST_STRING_LENGTH - 2 * i, "%02x",
+             hash[i]);
+        }
+        if (res == FTI_SCES && strcmp(sum, checksum) != 0) {
+            snprintf(str, sizeof(str), "Checksum do not match. \"%s\" file is"
+             " corrupted. %s != %s", fn, sum, checksum);
+            FTI_Print(str, FTI_WARN);
+            res = FTI_NSCS;
+        }
+    }
+
+    if (fd != -1) {
+        close(fd);
+    }
+    FTI_DedupCloseOwners(&header, owners);
+    free(owners);
+    free(names);
+    free(refs);
+    if (res != FTI_SCES) {
+        snprintf(str, sizeof(str), "Missing file: \"%s\"", fn);
+        FTI_Print(str, FTI_WARN);
+        return 1;
+    }
+    return 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Rebuilds the blocks of a recovered file stored elsewhere.
+  @param      gfn             Path of the flushed file.
+  @param      lfn             Path of the copy to complete.
+  @return     integer         FTI_SCES if successful.
+
+  The referenced blocks are read from the owner files, next to the
+  flushed file. Nothing is done for a file without map.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_DedupRestore(char* gfn, char* lfn) {
+    if (!FTI_DedupMapped(gfn)) {
+        return FTI_SCES;
+    }
+    FTIT_dedupHeader header;
+    char (*names)[FTI_BUFS];
+    FTIT_dedupRef* refs;
+    if (FTI_DedupReadMap(gfn, &header, &names, &refs) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    int* owners = talloc(int, header.nbOwners + 1);
+    int res = FTI_DedupOpenOwners(gfn, &header, names, owners);
+    int fd = open(lfn, O_WRONLY);
+    if (fd == -1) {
+        res = FTI_NSCS;
+    }
+    size_t bs = header.blockSize;
+    char* buf = talloc(char, bs);
+    uint32_t i;
+    for (i = 0; i < header.nbRefs && res == FTI_SCES; i++) {
+        if (FTI_DedupRead(owners[refs[i].owner], buf, bs,
+         refs[i].ownerBlock * bs) != FTI_SCES ||
+         FTI_DedupWrite(fd, buf, bs, refs[i].block * bs) != FTI_SCES) {
+            res = FTI_NSCS;
+        }
+    }
+    if (fd != -1 && close(fd) == -1) {
+        res = FTI_NSCS;
+    }
+    char str[FTI_BUFS];
+    if (res == FTI_SCES) {
+        snprintf(str, FTI_BUFS, "rebuilt %u deduplicated blocks of '%s'.",
+         header.nbRefs, lfn);
+        FTI_Print(str, FTI_DBUG);
+    } else {
+        snprintf(str, FTI_BUFS, "unable to rebuild the deduplicated blocks"
+         " of '%s'.", lfn);
+        FTI_Print(str, FTI_WARN);
+    }
+
+    free(buf);
+    FTI_DedupCloseOwners(&header, owners);
+    free(owners);
+    free(names);
+    free(refs);
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Moves the map of a flushed file along with the file.
+  @param      from            Former path of the flushed file.
+  @param      to              New path of the flushed file.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_DedupRename(char* from, char* to) {
+    if (!FTI_DedupMapped(from)) {
+        return FTI_SCES;
+    }
+    char mapFrom[FTI_BUFS + sizeof(FTI_DEDUP_SUFFIX)];
+    char mapTo[FTI_BUFS + sizeof(FTI_DEDUP_SUFFIX)];
+    snprintf(mapFrom, sizeof(mapFrom), "%s%s", from, FTI_DEDUP_SUFFIX);
+    snprintf(mapTo, sizeof(mapTo), "%s%s", to, FTI_DEDUP_SUFFIX);
+    RENAME(mapFrom, mapTo);
+    return FTI_SCES;
+}
@@ -0,0 +1,33 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   dedup.h
+ */
+
+#ifndef FTI_SRC_IO_DEDUP_H_
+#define FTI_SRC_IO_DEDUP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Suffix of the map of the blocks stored in other files **/
+#define FTI_DEDUP_SUFFIX ".ddp"
+
+/** Blocks per message of the deduplicated L2 copy **/
+#define FTI_DEDUP_CHUNK_BLOCKS 64
+
+int FTI_DedupFlush(FTIT_configuration* FTI_Conf, FTIT_topology* FTI_Topo,
+ FTIT_transfer* jobs, int nbJobs);
+int FTI_DedupExchange(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ char* lfn, char* pfn, int destination, int source);
+bool FTI_DedupMapped(char* fn);
+int FTI_DedupCheckFile(char* fn, int64_t fs, char* checksum);
+int FTI_DedupRestore(char* gfn, char* lfn);
+int FTI_DedupRename(char* from, char* to);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // FTI_SRC_IO_DEDUP_H_
@@ -489,7 +489,7 @@ When the checkpoint will terminate the current hash will be freed, whereas the n
 will be used as current. Keep in mind that the next has the correct size
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_CollapseBlockHashArray(FTIT_DataDiffHash* hashes, int32_t chunkSize) {
+int FTI_CollapseBlockHashArray(FTIT_DataDiffHash* hashes, int64_t chunkSize) {
     if (!dcpEnabled)
         return FTI_SCES;
 
@@ -554,7 +554,7 @@ When the checkpoint will terminate the current hash will be freed, whereas the n
 will be used as current. Keep in mind that the next has the correct size
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_ExpandBlockHashArray(FTIT_DataDiffHash* dataHash, int32_t chunkSize) {
+int FTI_ExpandBlockHashArray(FTIT_DataDiffHash* dataHash, int64_t chunkSize) {
     if (!dcpEnabled)
         return FTI_SCES;
 
@@ -615,7 +615,7 @@ int FTI_ExpandBlockHashArray(FTIT_DataDiffHash* dataHash, int32_t chunkSize) {
   block size corresponding to chunkSize.
  **/
 /*-------------------------------------------------------------------------*/
-int32_t FTI_CalcNumHashes(int32_t chunkSize) {
+int32_t FTI_CalcNumHashes(int64_t chunkSize) {
     if ((chunkSize%((uint32_t)DCP_BLOCK_SIZE)) == 0) {
         return chunkSize/DCP_BLOCK_SIZE;
     } else {
@@ -623,7 +623,7 @@ int32_t FTI_CalcNumHashes(int32_t chunkSize) {
     }
 }
 
-void PrintDataHashInfo(FTIT_DataDiffHash* dataHash, int32_t chunkSize, int id) {
+void PrintDataHashInfo(FTIT_DataDiffHash* dataHash, int64_t chunkSize, int id) {
     char str[FTI_BUFS];
     FTI_Print("+++++++++++++++ INFO IS  +++++++++++++++", FTI_INFO);
     snprintf(str, sizeof(str), "I want to access index of the following id %d",
@@ -658,7 +658,7 @@ void PrintDataHashInfo(FTIT_DataDiffHash* dataHash, int32_t chunkSize, int id) {
      dataHash->blockSize[dataHash->nbHashes-1]);
     FTI_Print(str, FTI_INFO);
     snprintf(str, sizeof(str),
-     "Total Block size is %d, Computed Block Size is %d", chunkSize,
+     "Total Block size is %ld, Computed Block Size is %d", chunkSize,
       (dataHash->nbHashes-1)*FTI_GetDiffBlockSize() +
       dataHash->blockSize[dataHash->nbHashes-1]);
     FTI_Print(str, FTI_INFO);
@@ -107,7 +107,7 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
         return FTI_NSCS;
     }
 
-    uint32_t fs = st.st_size;
+    int64_t fs = st.st_size;
 
     // open checkpoint file for read only
     int fd = open(fn, O_RDONLY, 0);
@@ -134,14 +134,22 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
     // file is mapped, we can close it.
     close(fd);
 
-    // determine location of file meta data in mapping
-    FTI_ADDRPTR seek_ptr = fmmap + (FTI_ADDRVAL) (fs - FTI_filemetastructsize);
+    // determine format version and location of file meta data in mapping
+    FTIFF_layout layout;
+    if (FTIFF_GetLayout(&layout,
+     FTIFF_GetFormatVersion((char*) fmmap + fs)) != FTI_SCES) {
+        FTI_Print("FTI-FF: ReadDbFTIFF - unknown format version", FTI_EROR);
+        munmap(fmmap, fs);
+        errno = 0;
+        return FTI_NSCS;
+    }
+    FTI_ADDRPTR seek_ptr = fmmap + (FTI_ADDRVAL) (fs - layout.filemetasize);
 
     // set end of file to last byte of metadata without file metadata
     FTI_ADDRPTR seek_end = seek_ptr - 1;
 
     if (FTIFF_DeserializeFileMeta(&(FTI_Exec->FTIFFMeta),
-     seek_ptr) != FTI_SCES) {
+     seek_ptr, &layout) != FTI_SCES) {
         FTI_Print("FTI-FF: ReadDbFTIFF - failed to deserialize"
         " 'FTI_Exec->FTIFFMeta'", FTI_EROR);
         munmap(fmmap, fs);
@@ -173,7 +181,8 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
 
     do {
         isnextdb = 0;
-        if (FTIFF_DeserializeDbMeta(currentdb, seek_ptr) != FTI_SCES) {
+        if (FTIFF_DeserializeDbMeta(currentdb, seek_ptr,
+         &layout) != FTI_SCES) {
             FTI_Print("FTI-FF: ReadDbFTIFF - failed to deserialize "
                 "'currentdb'", FTI_EROR);
             munmap(fmmap, fs);
@@ -187,10 +196,10 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
         // prevent seg faults in case of corruption.
 
         // advance meta data offset
-        seek_ptr += (FTI_ADDRVAL) FTI_dbstructsize;
+        seek_ptr += (FTI_ADDRVAL) layout.dbsize;
 
         snprintf(str, FTI_BUFS, "FTI-FF: Updatedb - dataBlock:%i, dbsize:"
-            " %d, numvars: %i.", dbcounter, currentdb->dbsize,
+            " %ld, numvars: %i.", dbcounter, currentdb->dbsize,
              currentdb->numvars);
         FTI_Print(str, FTI_DBUG);
 
@@ -211,7 +220,7 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
 
             // get dbvar meta data
             if (FTIFF_DeserializeDbVarMeta(currentdbvar,
-             seek_ptr) != FTI_SCES) {
+             seek_ptr, &layout) != FTI_SCES) {
                 FTI_Print("FTI-FF: ReadDbFTIFF - failed to deserialize"
                 " 'dbvar'", FTI_EROR);
                 munmap(fmmap, fs);
@@ -233,12 +242,12 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
             }
 
             // advance meta data offset
-            seek_ptr += (FTI_ADDRVAL) FTI_dbvarstructsize;
+            seek_ptr += (FTI_ADDRVAL) layout.dbvarsize;
 
             currentdbvar->hasCkpt = true;
 
             FTIT_dataset* data;
-            if (FTI_Data->get(&data, currentdbvar->id) != FTI_SCES)
+            if (FTI_Data->get(FTI_Data, &data, currentdbvar->id) != FTI_SCES)
                 return FTI_NSCS;
 
             if (!data) {
@@ -246,7 +255,7 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
                 FTI_InitDataset(FTI_Exec, &dataNew, currentdbvar->id);
                 dataNew.sizeStored = currentdbvar->chunksize;
                 dataNew.recovered = true;
-                FTI_Data->push_back(&dataNew, currentdbvar->id);
+                FTI_Data->push_back(FTI_Data, &dataNew, currentdbvar->id);
             } else {
                 data->sizeStored += currentdbvar->chunksize;
             }
@@ -270,7 +279,7 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
             // debug information
             snprintf(str, FTI_BUFS, "FTI-FF: Updatedb -  dataBlock:%i/"
                 "dataBlockVar%i id: %i, destptr: %ld, fptr: %ld, "
-                "chunksize: %d.", dbcounter, dbvar_idx,
+                "chunksize: %ld.", dbcounter, dbvar_idx,
                     currentdbvar->id, currentdbvar->dptr,
                     currentdbvar->fptr, currentdbvar->chunksize);
             FTI_Print(str, FTI_DBUG);
@@ -328,6 +337,12 @@ int FTIFF_ReadDbFTIFF(FTIT_configuration *FTI_Conf, FTIT_execution *FTI_Exec,
 /*-------------------------------------------------------------------------*/
 int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
     char strerr[FTI_BUFS];
+    FTIFF_layout layout;
+    if (FTIFF_GetLayout(&layout, FTIFFMeta->version) != FTI_SCES) {
+        FTI_Print("FTI-FF: GetFileChecksum - unknown format version",
+         FTI_EROR);
+        return FTI_NSCS;
+    }
     unsigned char hash[MD5_DIGEST_LENGTH];
     MD5_CTX ctx;
     MD5_Init(&ctx);
@@ -348,7 +363,7 @@ int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
 
     // set end of file to last byte of metadata without file metadata
     FTI_ADDRPTR seek_end = fmmap + (FTI_ADDRVAL) FTIFFMeta->ckptSize -
-     (FTI_ADDRVAL) FTI_filemetastructsize;
+     (FTI_ADDRVAL) layout.filemetasize;
 
     FTIFF_db *db = talloc(FTIFF_db, 1);
     if (db == NULL) {
@@ -361,7 +376,7 @@ int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
     }
 
     do {
-        if (FTIFF_DeserializeDbMeta(db, seek_ptr) != FTI_SCES) {
+        if (FTIFF_DeserializeDbMeta(db, seek_ptr, &layout) != FTI_SCES) {
             FTI_Print("FTI-FF: ReadDbFTIFF - failed to deserialize 'db'",
              FTI_EROR);
             munmap(fmmap, FTIFFMeta->ckptSize);
@@ -369,7 +384,7 @@ int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
             return FTI_NSCS;
         }
 
-        seek_ptr += (FTI_ADDRVAL) FTI_dbstructsize;
+        seek_ptr += (FTI_ADDRVAL) layout.dbsize;
 
         FTIFF_dbvar *dbvars = talloc(FTIFF_dbvar, db->numvars);
         if (dbvars == NULL) {
@@ -386,7 +401,8 @@ int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
             FTIFF_dbvar *dbvar = &(dbvars[dbvar_idx]);
 
             // get dbvar meta data
-            if (FTIFF_DeserializeDbVarMeta(dbvar, seek_ptr) != FTI_SCES) {
+            if (FTIFF_DeserializeDbVarMeta(dbvar, seek_ptr,
+             &layout) != FTI_SCES) {
                 FTI_Print("FTI-FF: ReadDbFTIFF - failed to deserialize "
                     "'dbvar'", FTI_EROR);
                 munmap(fmmap, FTIFFMeta->ckptSize);
@@ -395,7 +411,7 @@ int FTIFF_GetFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd, char *checksum) {
             }
 
             // advance meta data offset
-            seek_ptr += (FTI_ADDRVAL) FTI_dbvarstructsize;
+            seek_ptr += (FTI_ADDRVAL) layout.dbvarsize;
 
             // compute hash of chunk and file hash
             // (Note: we create the file hash from the chunk hashes due to ICP)
@@ -517,7 +533,7 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
         int editflags = 0;
         bool idFound = false;
         int isnextdb;
-        int32_t offset = 0;
+        int64_t offset = 0;
 
         /*
          *  - check if protected variable is in file info
@@ -527,11 +543,11 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
         FTI_Exec->lastdb = FTI_Exec->firstdb;
 
         int nbContainers = 0;
-        int32_t containerSizesAccu = 0;
+        int64_t containerSizesAccu = 0;
 
         // init overflow with the datasizes and validBlock with true.
         bool validBlock = true;
-        int32_t overflow = data->size;
+        int64_t overflow = data->size;
 
         // iterate though datablock list. Current datablock is 'lastdb'.
         // At the beginning of the loop 'lastdb = firstdb'
@@ -568,7 +584,7 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
                     // set chunksize to containersize and ensure that
                     // 'hascontent = true'.
                     if (overflow > dbvar->containersize) {
-                        int32_t chunksizeOld = dbvar->chunksize;
+                        int64_t chunksizeOld = dbvar->chunksize;
                         dbvar->chunksize = dbvar->containersize;
                         dbvar->cptr = data->ptr + dbvar->dptr;
                         if (!dbvar->hascontent) {
@@ -598,7 +614,7 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
                     // afterwards overflow to 0 and
                     // ensure that 'hascontent = true'.
                     if (overflow <= dbvar->containersize) {
-                        int32_t chunksizeOld = dbvar->chunksize;
+                        int64_t chunksizeOld = dbvar->chunksize;
                         dbvar->chunksize = overflow;
                         dbvar->cptr = data->ptr + dbvar->dptr;
                         if (!dbvar->hascontent) {
@@ -674,7 +690,7 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
             }
 
             int evar_idx = dblock->numvars;
-            int32_t dbsize = dblock->dbsize;
+            int64_t dbsize = dblock->dbsize;
             switch (editflags) {
                 case 1:
                     // add new protected variable in next datablock
@@ -761,7 +777,7 @@ int FTIFF_UpdateDatastructVarFTIFF(FTIT_execution* FTI_Exec,
 /*-------------------------------------------------------------------------*/
 int FTI_WriteMemFTIFFChunk(FTIT_execution *FTI_Exec, FTIFF_dbvar *currentdbvar,
         unsigned char *dptr, size_t currentOffset, size_t fetchedBytes,
-        int32_t *dcpSize, WriteFTIFFInfo_t *fd) {
+        int64_t *dcpSize, WriteFTIFFInfo_t *fd) {
     unsigned char *chunk_addr = NULL;
     size_t chunk_size, chunk_offset;
     size_t remainingBytes = fetchedBytes;
@@ -769,7 +785,7 @@ int FTI_WriteMemFTIFFChunk(FTIT_execution *FTI_Exec, FTIFF_dbvar *currentdbvar,
     chunk_offset = 0;
 
     int32_t membs = 1024*1024*16;  // 16 MB
-    int32_t cpybuf, cpynow, cpycnt;  //, fptr;
+    int64_t cpybuf, cpynow, cpycnt;  //, fptr;
 
     uintptr_t fptr = currentdbvar-> fptr + currentOffset;
     uintptr_t fptrTemp = fptr;
@@ -820,7 +836,7 @@ int FTI_WriteMemFTIFFChunk(FTIT_execution *FTI_Exec, FTIFF_dbvar *currentdbvar,
 /*-------------------------------------------------------------------------*/
 int FTI_ProcessDBVar(FTIT_execution *FTI_Exec, FTIT_configuration *FTI_Conf,
     FTIFF_dbvar *currentdbvar, FTIT_dataset *data, unsigned char *hashchk,
-     WriteFTIFFInfo_t *fd, int32_t *dcpSize, unsigned char **dptr) {
+     WriteFTIFFInfo_t *fd, int64_t *dcpSize, unsigned char **dptr) {
     bool hascontent = currentdbvar->hascontent;
     unsigned char *cbasePtr = NULL;
     errno = 0;
@@ -1024,9 +1040,9 @@ int FTI_WriteFtiffData(FTIT_dataset* data, void *fd) {
     unsigned char *dptr;
     int dbvar_idx, dbcounter = 0;
     int isnextdb;
-    int32_t dcpSize = 0;
-    int32_t dataSize = 0;
-    int32_t pureDataSize = 0;
+    int64_t dcpSize = 0;
+    int64_t dataSize = 0;
+    int64_t pureDataSize = 0;
 
     FTIFF_UpdateDatastructVarFTIFF(write_info->FTI_Exec, data,
      write_info->FTI_Conf);
@@ -1201,7 +1217,7 @@ int FTIFF_finalizeDatastructFTIFF(FTIT_execution* FTI_Exec) {
         return FTI_NSCS;
     }
 
-    uint32_t metaSize = FTI_filemetastructsize;
+    uint64_t metaSize = FTI_filemetastructsize;
 
     do {
         db->finalized = true;
@@ -1272,6 +1288,7 @@ int FTIFF_writeMetaDataFTIFF(FTIT_execution* FTI_Exec, WriteFTIFFInfo_t *fd) {
     }
 
     // compute and set hash of file meta data
+    FTI_Exec->FTIFFMeta.version = FTIFF_VERSION;
     FTIFF_GetHashMetaInfo(FTI_Exec->FTIFFMeta.myHash, &(FTI_Exec->FTIFFMeta));
     FTIFF_SerializeFileMeta(&FTI_Exec->FTIFFMeta, (FTI_ADDRPTR) mbuf_pos);
 
@@ -1308,14 +1325,15 @@ int FTIFF_CreateMetadata(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
 
     FTI_Exec->ckptSize = FTI_Exec->FTIFFMeta.metaSize +
      FTI_Exec->FTIFFMeta.dataSize;
-    int32_t fs = FTI_Exec->ckptSize;
+    int64_t fs = FTI_Exec->ckptSize;
     FTI_Exec->FTIFFMeta.ckptSize = fs;
     FTI_Exec->FTIFFMeta.fs = fs;
+    FTI_Exec->FTIFFMeta.l3Code = FTI_L3Code(FTI_Conf);
 
     // allgather not needed for L1 checkpoint
     if ((FTI_Exec->ckptMeta.level == 2) || (FTI_Exec->ckptMeta.level == 3)) {
-        int32_t fileSizes[FTI_BUFS], mfs = 0;
-        MPI_Allgather(&fs, 1, MPI_INT32_T, fileSizes, 1, MPI_INT32_T,
+        int64_t fileSizes[FTI_BUFS], mfs = 0;
+        MPI_Allgather(&fs, 1, MPI_INT64_T, fileSizes, 1, MPI_INT64_T,
          FTI_Exec->groupComm);
         int ptnerGroupRank, i;
         switch (FTI_Exec->ckptMeta.level) {
@@ -1341,6 +1359,10 @@ int FTIFF_CreateMetadata(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
                 // file gets lost
                 // [Important for FTI_RSenc after file truncation to maxFs]
                 mfs += sizeof(off_t);
+                // the L3 codes work on words or units of packets, the
+                // encoded files must not end in the middle of one
+                int64_t ws = FTI_L3Alignment(FTI_Conf);
+                mfs = ((mfs + ws - 1) / ws) * ws;
 
                 FTI_Exec->FTIFFMeta.maxFs = mfs;
                 FTI_Exec->FTIFFMeta.ptFs = -1;
@@ -1411,12 +1433,13 @@ int FTIFF_Recover(FTIT_execution *FTI_Exec, FTIT_keymap *FTI_Data,
 
     // Check if sizes of protected variables matches
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
 
     int i = 0; for (; i < FTI_Exec->nbVar; i++) {
         if (data[i].size != data[i].sizeStored) {
-            snprintf(str, FTI_BUFS, "Cannot recover %d bytes to protected"
-                    " variable (ID %d) size: %d",
+            snprintf(str, FTI_BUFS, "Cannot recover %ld bytes to protected"
+                    " variable (ID %d) size: %ld",
                     data[i].sizeStored, data[i].id,
                     data[i].size);
             FTI_Print(str, FTI_WARN);
@@ -1453,7 +1476,7 @@ int FTIFF_Recover(FTIT_execution *FTI_Exec, FTIT_keymap *FTI_Data,
 
     // block size for memcpy of pointer.
     int32_t membs = 1024*1024*16;  // 16 MB
-    int32_t cpybuf, cpynow, cpycnt;
+    int64_t cpybuf, cpynow, cpycnt;
 
     // open checkpoint file for read only
     int fd = open(fn, O_RDONLY, 0);
@@ -1496,7 +1519,7 @@ int FTIFF_Recover(FTIT_execution *FTI_Exec, FTIT_keymap *FTI_Data,
         for (dbvar_idx = 0; dbvar_idx < currentdb->numvars; dbvar_idx++) {
             currentdbvar = &(currentdb->dbvars[dbvar_idx]);
 
-            if (FTI_Data->get(&data, currentdbvar->id) != FTI_SCES)
+            if (FTI_Data->get(FTI_Data, &data, currentdbvar->id) != FTI_SCES)
                 return FTI_NSCS;
 
             if (!data) {
@@ -1549,7 +1572,7 @@ int FTIFF_Recover(FTIT_execution *FTI_Exec, FTIT_keymap *FTI_Data,
             // debug information
             snprintf(str, FTI_BUFS, "FTI-FF: FTIFF_Recover -  "
                     "dataBlock:%i/dataBlockVar%i id: %i"
-                    ", destptr: %ld, fptr: %ld, chunksize: %d, "
+                    ", destptr: %ld, fptr: %ld, chunksize: %ld, "
                     "base_ptr: 0x%" PRIxPTR " ptr_pos: 0x%" PRIxPTR ".",
                     dbcounter, dbvar_idx,
                     currentdbvar->id, currentdbvar->dptr,
@@ -1668,7 +1691,7 @@ int FTIFF_RecoverVar(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     // block size for memcpy of pointer.
     int32_t membs = 1024*1024*16;  // 16 MB
-    int32_t cpybuf, cpynow, cpycnt;
+    int64_t cpybuf, cpynow, cpycnt;
 
     // MD5 context for checksum of data chunks
     MD5_CTX mdContext;
@@ -1690,7 +1713,8 @@ int FTIFF_RecoverVar(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
                 FTIT_dataset* data;
 
-                if (FTI_Data->get(&data, id) != FTI_SCES) return FTI_NSCS;
+                if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES)
+                    return FTI_NSCS;
 
                 if (!data) {
                     snprintf(str, FTI_BUFS, "id '%d' does not exist!", id);
@@ -1698,8 +1722,8 @@ int FTIFF_RecoverVar(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                     return FTI_NSCS;
                 }
                 if (data->size != data->sizeStored) {
-                    snprintf(str, sizeof(str), "Cannot recover %d bytes to "
-                        "protected variable (ID %d) size: %d",
+                    snprintf(str, sizeof(str), "Cannot recover %ld bytes to "
+                        "protected variable (ID %d) size: %ld",
                         data->sizeStored, data->id, data->size);
                     FTI_Print(str, FTI_WARN);
                     return FTI_NREC;
@@ -1723,7 +1747,7 @@ int FTIFF_RecoverVar(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 // debug information
                 snprintf(str, FTI_BUFS, "FTIFF: FTIFF_RecoverVar -"
                         "  dataBlock:%i/dataBlockVar%i id: %i"
-                        ", destptr: %ld, fptr: %ld, chunksize: %d, "
+                        ", destptr: %ld, fptr: %ld, chunksize: %ld, "
                         "base_ptr: 0x%" PRIxPTR " ptr_pos: 0x%" PRIxPTR ".",
                         dbcounter, dbvar_idx,
                         currentdbvar->id, currentdbvar->dptr,
@@ -1852,21 +1876,38 @@ int FTIFF_RequestFileName(char* dir, int rank, int level, int dcp,
  **/
 /*-------------------------------------------------------------------------*/
 int FTIFF_LoadFileMeta(int fd, FTIFF_metaInfo* fm) {
-    if (lseek(fd, -FTI_filemetastructsize, SEEK_END) == -1) {
+    char trailer[FTIFF_TRAILER_SIZE];
+    if (lseek(fd, -((off_t) FTIFF_TRAILER_SIZE), SEEK_END) == -1) {
         FTI_Print("unable to seek in file.", FTI_EROR);
         return FTI_NSCS;
     }
-    void* buffer = malloc(FTI_filemetastructsize);
+    if (read(fd, trailer, FTIFF_TRAILER_SIZE) != FTIFF_TRAILER_SIZE) {
+        FTI_Print("unable to read in file.", FTI_EROR);
+        return FTI_NSCS;
+    }
+    FTIFF_layout layout;
+    if (FTIFF_GetLayout(&layout,
+     FTIFF_GetFormatVersion(trailer + FTIFF_TRAILER_SIZE)) != FTI_SCES) {
+        FTI_Print("unknown FTI-FF format version.", FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    if (lseek(fd, -layout.filemetasize, SEEK_END) == -1) {
+        FTI_Print("unable to seek in file.", FTI_EROR);
+        return FTI_NSCS;
+    }
+    void* buffer = malloc(layout.filemetasize);
     if (buffer == NULL) {
         FTI_Print("unable to allocate memory.", FTI_EROR);
         return FTI_NSCS;
     }
-    if (read(fd, buffer, FTI_filemetastructsize) == -1) {
+    if (read(fd, buffer, layout.filemetasize) == -1) {
         FTI_Print("unable to read in file.", FTI_EROR);
+        free(buffer);
         return FTI_NSCS;
     }
 
-    int res = FTIFF_DeserializeFileMeta(fm, buffer);
+    int res = FTIFF_DeserializeFileMeta(fm, buffer, &layout);
     free(buffer);
     return res;
 }
@@ -1965,7 +2006,7 @@ int FTIFF_LoadMetaPostprocessing(FTIT_execution* FTI_Exec,
 /*-------------------------------------------------------------------------*/
 int FTIFF_GetEncodedFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd,
  char *checksum) {
-    int32_t rcount = 0, toRead, diff;
+    int64_t rcount = 0, toRead, diff;
     int rbuffer;
     char buffer[CHUNK_SIZE], strerr[FTI_BUFS];
     MD5_CTX mdContext;
@@ -1983,7 +2024,7 @@ int FTIFF_GetEncodedFileChecksum(FTIFF_metaInfo *FTIFFMeta, int fd,
         rbuffer = read(fd, buffer, toRead);
         if (rbuffer == -1) {
             snprintf(strerr, FTI_BUFS, "FTI-FF: L3RecoveryInit - Failed to"
-            " read %d bytes from file", toRead);
+            " read %ld bytes from file", toRead);
             FTI_Print(strerr, FTI_EROR);
             errno = 0;
             return FTI_NSCS;
@@ -2075,6 +2116,7 @@ int FTIFF_RequestRecoveryInfo(FTIFF_RecoveryInfo* info, char* dir, int rank,
             }
             info->ckptId = FTIFFMeta->ckptId;
             info->maxFs = FTIFFMeta->maxFs;
+            info->l3Code = FTIFFMeta->l3Code;
         }  else {
             char str[FTI_BUFS];
             snprintf(str, FTI_BUFS, "Checksum do not match. \"%s\" file is"
@@ -2236,7 +2278,7 @@ int FTIFF_CheckL2RecoverInit(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
         }
     }
     snprintf(dbgstr, FTI_BUFS, "FTI-FF: L2-Recovery - rank: %i, left: %i,"
-        " right: %i, fs: %d, pfs: %d, ckptId: %i",
+        " right: %i, fs: %ld, pfs: %ld, ckptId: %i",
             FTI_Topo->myRank, leftIdx, rightIdx, FTI_Exec->ckptMeta.fs,
              FTI_Exec->ckptMeta.pfs, FTI_Exec->ckptId);
     FTI_Print(dbgstr, FTI_DBUG);
@@ -2290,7 +2332,7 @@ int FTIFF_CheckL3RecoverInit(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
 
     // check if recovery possible
     int i, saneCkptID = 0, saneMaxFs = 0, erasures = 0;
-    int32_t maxFs = 0;
+    int64_t maxFs = 0;
     ckptId = 0;
     for (i = 0; i < FTI_Topo->groupSize; i++) {
         erased[i]=!groupInfo[i].FileExists;
@@ -2313,13 +2355,21 @@ int FTIFF_CheckL3RecoverInit(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
     }
     // for the case that all (and only) the encoded files are deleted
     if (saneMaxFs == 0 && !(erasures > FTI_Topo->groupSize)) {
-        MPI_Allreduce(&(info.maxFs), &FTI_Exec->ckptMeta.maxFs, 1, MPI_INT32_T,
+        MPI_Allreduce(&(info.maxFs), &FTI_Exec->ckptMeta.maxFs, 1, MPI_INT64_T,
          MPI_SUM, FTI_Exec->groupComm);
         FTI_Exec->ckptMeta.maxFs /= FTI_Topo->groupSize;
     }
 
     FTI_Exec->ckptMeta.fs = (info.FileExists) ? info.fs : 0;
 
+    // the code of the L3 files, from any surviving file of the group
+    FTI_Exec->ckptMeta.l3Code = 0;
+    for (i = 0; i < FTI_Topo->groupSize; i++) {
+        if (groupInfo[i].l3Code > FTI_Exec->ckptMeta.l3Code) {
+            FTI_Exec->ckptMeta.l3Code = groupInfo[i].l3Code;
+        }
+    }
+
     snprintf(FTI_Exec->ckptMeta.ckptFile, FTI_BUFS, "Ckpt%d-Rank%d.fti",
      FTI_Exec->ckptId, FTI_Topo->myRank);
 
@@ -2380,7 +2430,7 @@ void FTIFF_SetHashChunk(FTIFF_dbvar *dbvar, FTIT_keymap* FTI_Data) {
     if (dbvar->hascontent) {
         FTIT_dataset* data;
 
-        if (FTI_Data->get(&data, dbvar->id) != FTI_SCES) return;
+        if (FTI_Data->get(FTI_Data, &data, dbvar->id) != FTI_SCES) return;
 
         if (!data) {
             char str[FTI_BUFS];
@@ -2390,7 +2440,7 @@ void FTIFF_SetHashChunk(FTIFF_dbvar *dbvar, FTIT_keymap* FTI_Data) {
         }
 
         void * ptr = data->ptr + dbvar->dptr;
-        uint32_t size = dbvar->chunksize;
+        size_t size = dbvar->chunksize;
         MD5(ptr, size, dbvar->hash);
     }
 }
@@ -2403,16 +2453,19 @@ void FTIFF_SetHashChunk(FTIFF_dbvar *dbvar, FTIT_keymap* FTI_Data) {
  **/
 /*-------------------------------------------------------------------------*/
 void FTIFF_GetHashMetaInfo(unsigned char *hash, FTIFF_metaInfo *FTIFFMeta) {
+    // version 1 files hashed the lower 32 bits of the sizes
+    size_t width = (FTIFFMeta->version == FTIFF_VERSION_LEGACY) ?
+     sizeof(int32_t) : sizeof(int64_t);
     MD5_CTX md5Ctx;
     MD5_Init(&md5Ctx);
     MD5_Update(&md5Ctx, FTIFFMeta->checksum, MD5_DIGEST_STRING_LENGTH);
-    MD5_Update(&md5Ctx, &(FTIFFMeta->timestamp), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->ckptSize), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->metaSize), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->dataSize), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->fs), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->ptFs), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(FTIFFMeta->maxFs), sizeof(int32_t));
+    MD5_Update(&md5Ctx, &(FTIFFMeta->timestamp), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->ckptSize), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->metaSize), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->dataSize), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->fs), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->ptFs), width);
+    MD5_Update(&md5Ctx, &(FTIFFMeta->maxFs), width);
     MD5_Final(hash, &md5Ctx);
 }
 
@@ -2427,7 +2480,7 @@ void FTIFF_GetHashdb(unsigned char *hash, FTIFF_db *db) {
     MD5_CTX md5Ctx;
     MD5_Init(&md5Ctx);
     MD5_Update(&md5Ctx, &(db->numvars), sizeof(int));
-    MD5_Update(&md5Ctx, &(db->dbsize), sizeof(int32_t));
+    MD5_Update(&md5Ctx, &(db->dbsize), sizeof(int64_t));
     MD5_Final(hash, &md5Ctx);
 }
 
@@ -2447,8 +2500,8 @@ void FTIFF_GetHashdbvar(unsigned char *hash, FTIFF_dbvar *dbvar)  {
     MD5_Update(&md5Ctx, &(dbvar->hasCkpt), sizeof(bool));
     MD5_Update(&md5Ctx, &(dbvar->dptr), sizeof(uintptr_t));
     MD5_Update(&md5Ctx, &(dbvar->fptr), sizeof(uintptr_t));
-    MD5_Update(&md5Ctx, &(dbvar->chunksize), sizeof(int32_t));
-    MD5_Update(&md5Ctx, &(dbvar->containersize), sizeof(int32_t));
+    MD5_Update(&md5Ctx, &(dbvar->chunksize), sizeof(int64_t));
+    MD5_Update(&md5Ctx, &(dbvar->containersize), sizeof(int64_t));
     MD5_Update(&md5Ctx, dbvar->hash, MD5_DIGEST_LENGTH);
     MD5_Final(hash, &md5Ctx);
 }
@@ -2468,7 +2521,7 @@ void FTIFF_InitMpiTypes() {
     MBR_CNT(headInfo) =  7;
     MBR_BLK_LEN(headInfo) = { 1, 1, FTI_BUFS, 1, 1, 1, 1 };
     MBR_TYPES(headInfo) = { MPI_INT, MPI_INT, MPI_CHAR,
-     MPI_INT32_T, MPI_INT32_T, MPI_INT32_T, MPI_INT };
+     MPI_INT64_T, MPI_INT64_T, MPI_INT64_T, MPI_INT };
     MBR_DISP(headInfo) = {
         offsetof(FTIFF_headInfo, exists),
         offsetof(FTIFF_headInfo, nbVar),
@@ -2484,15 +2537,16 @@ void FTIFF_InitMpiTypes() {
     MPITypeInfo[FTIFF_HEAD_INFO].mbrDisp = headInfo_mbrDisp;
 
     // L2Info
-    MBR_CNT(RecoInfo) = 6;
-    MBR_BLK_LEN(RecoInfo) = { 1, 1, 1, 1, 1, 1 };
+    MBR_CNT(RecoInfo) = 7;
+    MBR_BLK_LEN(RecoInfo) = { 1, 1, 1, 1, 1, 1, 1 };
     MBR_TYPES(RecoInfo) = { MPI_INT, MPI_INT, MPI_INT,
-     MPI_INT, MPI_INT32_T, MPI_INT32_T };
+     MPI_INT, MPI_INT, MPI_INT64_T, MPI_INT64_T };
     MBR_DISP(RecoInfo) = {
         offsetof(FTIFF_RecoveryInfo, FileExists),
         offsetof(FTIFF_RecoveryInfo, BackupExists),
         offsetof(FTIFF_RecoveryInfo, ckptId),
         offsetof(FTIFF_RecoveryInfo, rightIdx),
+        offsetof(FTIFF_RecoveryInfo, l3Code),
         offsetof(FTIFF_RecoveryInfo, fs),
         offsetof(FTIFF_RecoveryInfo, bfs),
     };
@@ -2523,19 +2577,102 @@ void FTIFF_InitMpiTypes() {
     }
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Sets the sizes of the FTI-FF meta data for a format version
+  @param    layout        sizes of the meta data in file.
+  @param    version       FTI-FF format version.
+  @return   integer       FTI_SCES if the version is known.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTIFF_GetLayout(FTIFF_layout* layout, uint32_t version) {
+    size_t width;
+    switch (version) {
+        case FTIFF_VERSION_LEGACY:
+            width = sizeof(int32_t);
+            break;
+        case FTIFF_VERSION:
+            width = sizeof(int64_t);
+            break;
+        default:
+            return FTI_NSCS;
+    }
+
+    layout->version = version;
+    layout->sizeWidth = width;
+
+    layout->filemetasize
+        = MD5_DIGEST_STRING_LENGTH
+        + MD5_DIGEST_LENGTH
+        + 7*width
+        + sizeof(int);
+
+    // TODO(leobago) RS L3 only works for even file sizes.
+    // This accounts for many but clearly not all cases.
+    // This is to fix.
+    layout->filemetasize += 2 - layout->filemetasize%2;
+
+    if (version != FTIFF_VERSION_LEGACY) {
+        layout->filemetasize += FTIFF_TRAILER_SIZE;
+    }
+
+    layout->dbsize
+        = sizeof(int)               /* numvars */
+        + width;                    /* dbsize */
+
+    layout->dbvarsize
+        = 2*sizeof(int)             /* numvars */
+        + 2*sizeof(bool)
+        + 2*sizeof(uintptr_t)
+        + 2*width
+        + MD5_DIGEST_LENGTH;
+
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Determines the format version of a FTI-FF checkpoint file
+  @param    end           end of the file meta data (end of file).
+  @return   uint32_t      format version (FTIFF_VERSION_LEGACY if no trailer).
+ **/
+/*-------------------------------------------------------------------------*/
+uint32_t FTIFF_GetFormatVersion(char* end) {
+    uint32_t version = FTIFF_VERSION_LEGACY;
+    if (memcmp(end - 4, FTIFF_MAGIC, 4) == 0) {
+        memcpy(&version, end - FTIFF_TRAILER_SIZE, sizeof(uint32_t));
+    }
+    return version;
+}
+
+/* reads a size or offset stored on 'width' bytes */
+static uint64_t FTIFF_GetSerializedSize(char* buffer_ser, size_t width) {
+    if (width == sizeof(int32_t)) {
+        uint32_t size;
+        memcpy(&size, buffer_ser, sizeof(uint32_t));
+        return size;
+    }
+    uint64_t size;
+    memcpy(&size, buffer_ser, sizeof(uint64_t));
+    return size;
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief    deserializes FTI-FF file meta data   
   @param    meta          FTI-FF file meta data.
   @param    buffer_ser    serialized file meta data.
+  @param    layout        sizes of the meta data in file.
  **/
 /*-------------------------------------------------------------------------*/
-int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser) {
+int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser,
+ FTIFF_layout* layout) {
     if ((buffer_ser == NULL) || (meta == NULL)) {
         FTI_Print("nullptr passed to 'FTIFF_DeserializeFilemeta!", FTI_WARN);
         return FTI_NSCS;
     }
 
+    size_t width = layout->sizeWidth;
     int pos = 0;
     memcpy(meta->checksum        , buffer_ser + pos, MD5_DIGEST_STRING_LENGTH);
     pos += MD5_DIGEST_STRING_LENGTH;
@@ -2543,19 +2680,27 @@ int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser) {
     pos += MD5_DIGEST_LENGTH;
     memcpy(&(meta->ckptId)       , buffer_ser + pos, sizeof(int));
     pos += sizeof(int);
-    memcpy(&(meta->ckptSize)     , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->metaSize)     , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->dataSize)     , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->fs)           , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->maxFs)        , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->ptFs)         , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(meta->timestamp)    , buffer_ser + pos, sizeof(int32_t));
+    meta->ckptSize  = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->metaSize  = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->dataSize  = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->fs        = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->maxFs     = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->ptFs      = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->timestamp = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    meta->version   = layout->version;
+    // the L3 code is stored in the padding byte of the current version
+    meta->l3Code    = 0;
+    if (layout->version != FTIFF_VERSION_LEGACY &&
+     pos < layout->filemetasize - FTIFF_TRAILER_SIZE) {
+        meta->l3Code = (unsigned char) buffer_ser[pos];
+    }
 
     return FTI_SCES;
 }
@@ -2565,9 +2710,11 @@ int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser) {
   @brief    deserializes FTI-FF file data block meta data   
   @param    db            FTI-FF file data block meta data.
   @param    buffer_ser    serialized file data block meta data.
+  @param    layout        sizes of the meta data in file.
  **/
 /*-------------------------------------------------------------------------*/
-int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser) {
+int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser,
+ FTIFF_layout* layout) {
     if ((buffer_ser == NULL) || (db == NULL)) {
         FTI_Print("nullptr passed to 'FTIFF_DeserializeFileMeta!", FTI_WARN);
         return FTI_NSCS;
@@ -2576,7 +2723,7 @@ int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser) {
     int pos = 0;
     memcpy(&(db->numvars)    , buffer_ser + pos, sizeof(int));
     pos += sizeof(int);
-    memcpy(&(db->dbsize)     , buffer_ser + pos, sizeof(int32_t));
+    db->dbsize = FTIFF_GetSerializedSize(buffer_ser + pos, layout->sizeWidth);
 
     return FTI_SCES;
 }
@@ -2586,14 +2733,17 @@ int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser) {
   @brief    deserializes FTI-FF data chunk meta data   
   @param    dbvar         FTI-FF data chunk meta data.
   @param    buffer_ser    serialized data chunk meta data.
+  @param    layout        sizes of the meta data in file.
  **/
 /*-------------------------------------------------------------------------*/
-int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser) {
+int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser,
+ FTIFF_layout* layout) {
     if ((buffer_ser == NULL) || (dbvar == NULL)) {
         FTI_Print("nullptr passed to 'FTIFF_DeserializeFileMeta!", FTI_WARN);
         return FTI_NSCS;
     }
 
+    size_t width = layout->sizeWidth;
     int pos = 0;
     memcpy(&(dbvar->id)              , buffer_ser + pos, sizeof(int));
     pos += sizeof(int);
@@ -2607,10 +2757,10 @@ int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser) {
     pos += sizeof(uintptr_t);
     memcpy(&(dbvar->fptr)            , buffer_ser + pos, sizeof(uintptr_t));
     pos += sizeof(uintptr_t);
-    memcpy(&(dbvar->chunksize)       , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(&(dbvar->containersize)   , buffer_ser + pos, sizeof(int32_t));
-    pos += sizeof(int32_t);
+    dbvar->chunksize = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
+    dbvar->containersize = FTIFF_GetSerializedSize(buffer_ser + pos, width);
+    pos += width;
     memcpy(dbvar->hash               , buffer_ser + pos, MD5_DIGEST_LENGTH);
 
     return FTI_SCES;
@@ -2621,6 +2771,9 @@ int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser) {
   @brief    serializes FTI-FF file meta data   
   @param    meta          FTI-FF file meta data.
   @param    buffer_ser    serialized file meta data.
+
+  The meta data is always written in the current format version
+  (FTIFF_VERSION) and ends with the version trailer.
  **/
 /*-------------------------------------------------------------------------*/
 int FTIFF_SerializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser) {
@@ -2636,19 +2789,30 @@ int FTIFF_SerializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser) {
     pos += MD5_DIGEST_LENGTH;
     memcpy(buffer_ser + pos, &(meta->ckptId)       , sizeof(int));
     pos += sizeof(int);
-    memcpy(buffer_ser + pos, &(meta->ckptSize)     , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->metaSize)     , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->dataSize)     , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->fs)           , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->maxFs)        , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->ptFs)         , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(meta->timestamp)    , sizeof(int32_t));
+    memcpy(buffer_ser + pos, &(meta->ckptSize)     , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->metaSize)     , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->dataSize)     , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->fs)           , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->maxFs)        , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->ptFs)         , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(meta->timestamp)    , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memset(buffer_ser + pos, 0x0, FTI_filemetastructsize - pos);
+    if (pos < FTI_filemetastructsize - FTIFF_TRAILER_SIZE) {
+        buffer_ser[pos] = (char) meta->l3Code;
+    }
+
+    uint32_t version = FTIFF_VERSION;
+    pos = FTI_filemetastructsize - FTIFF_TRAILER_SIZE;
+    memcpy(buffer_ser + pos, &version              , sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    memcpy(buffer_ser + pos, FTIFF_MAGIC           , 4);
 
     return FTI_SCES;
 }
@@ -2669,7 +2833,7 @@ int FTIFF_SerializeDbMeta(FTIFF_db* db, char* buffer_ser) {
     int pos = 0;
     memcpy(buffer_ser + pos, &(db->numvars)    , sizeof(int));
     pos += sizeof(int);
-    memcpy(buffer_ser + pos, &(db->dbsize)     , sizeof(int32_t));
+    memcpy(buffer_ser + pos, &(db->dbsize)     , sizeof(int64_t));
 
     return FTI_SCES;
 }
@@ -2700,10 +2864,10 @@ int FTIFF_SerializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser) {
     pos += sizeof(uintptr_t);
     memcpy(buffer_ser + pos, &(dbvar->fptr)            , sizeof(uintptr_t));
     pos += sizeof(uintptr_t);
-    memcpy(buffer_ser + pos, &(dbvar->chunksize)       , sizeof(int32_t));
-    pos += sizeof(int32_t);
-    memcpy(buffer_ser + pos, &(dbvar->containersize)   , sizeof(int32_t));
-    pos += sizeof(int32_t);
+    memcpy(buffer_ser + pos, &(dbvar->chunksize)       , sizeof(int64_t));
+    pos += sizeof(int64_t);
+    memcpy(buffer_ser + pos, &(dbvar->containersize)   , sizeof(int64_t));
+    pos += sizeof(int64_t);
     memcpy(buffer_ser + pos, dbvar->hash               , MD5_DIGEST_LENGTH);
 
     return FTI_SCES;
@@ -2740,7 +2904,7 @@ void FTIFF_PrintDataStructure(int rank, FTIT_execution* FTI_Exec) {
         " [%d]----------------\n\n", rank);
         do {
             printf("    DataBase-id: %d\n", dbcnt);
-            printf("                 dbsize: %d\n", dbgdb->dbsize);
+            printf("                 dbsize: %ld\n", dbgdb->dbsize);
             printf("                 metasize (offset: %d): %d\n\n",
              FTI_filemetastructsize,
              FTI_dbstructsize+dbgdb->numvars*FTI_dbvarstructsize);
@@ -2754,8 +2918,8 @@ void FTIFF_PrintDataStructure(int rank, FTIT_execution* FTI_Exec) {
                         "                 hasCkpt: %s\n"
                         "                 dptr: %lu\n"
                         "                 fptr: %lu\n"
-                        "                 chunksize: %u\n"
-                        "                 containersize: %u\n\n",
+                        "                 chunksize: %ld\n"
+                        "                 containersize: %ld\n\n",
                         /*
                          "                 nbHashes: %lu\n"
                          "                 diffBlockSize: %d\n"
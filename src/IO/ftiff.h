@@ -61,6 +61,14 @@
 #define CKPT_FN_FORMAT(level, backup) ((backup) ? ((level == 2) ? \
         "Ckpt%d-Pcof%d.fti" : "Ckpt%d-RSed%d.fti") : "Ckpt%d-Rank%d.fti")
 
+/** FTI-FF format versions, 1 stores sizes and offsets on 32 bits        **/
+#define FTIFF_VERSION_LEGACY 1
+#define FTIFF_VERSION 2
+
+/** Trailer of the file meta data (version, magic), absent in version 1  **/
+#define FTIFF_MAGIC "FTFF"
+#define FTIFF_TRAILER_SIZE (sizeof(uint32_t) + 4)
+
 extern int FTI_filemetastructsize; /**< size of FTIFF_metaInfo in file */
 extern int FTI_dbstructsize;       /**< size of FTIFF_db in file       */
 extern int FTI_dbvarstructsize;    /**< size of FTIFF_dbvar in file    */
@@ -96,9 +104,9 @@ typedef struct FTIFF_headInfo {
     int exists;
     int nbVar;
     char ckptFile[FTI_BUFS];
-    int32_t maxFs;
-    int32_t fs;
-    int32_t pfs;
+    int64_t maxFs;
+    int64_t fs;
+    int64_t pfs;
     int isDcp;
 } FTIFF_headInfo;
 
@@ -113,11 +121,26 @@ typedef struct FTIFF_RecoveryInfo {
     int BackupExists;
     int ckptId;
     int rightIdx;
-    int32_t maxFs;
-    int32_t fs;
-    int32_t bfs;
+    int l3Code;
+    int64_t maxFs;
+    int64_t fs;
+    int64_t bfs;
 } FTIFF_RecoveryInfo;
 
+/** @typedef    FTIFF_layout
+ *  @brief      Sizes of the FTI-FF meta data in file for a format version.
+ *
+ *  Allows to read checkpoint files written by an older FTI-FF version.
+ *
+ */
+typedef struct FTIFF_layout {
+    uint32_t version;
+    size_t sizeWidth;       /**< bytes of a serialized size or offset   */
+    int filemetasize;       /**< size of FTIFF_metaInfo in file         */
+    int dbsize;             /**< size of FTIFF_db in file               */
+    int dbvarsize;          /**< size of FTIFF_dbvar in file            */
+} FTIFF_layout;
+
 /**
 
   +-------------------------------------------------------------------------+
@@ -158,9 +181,14 @@ void* FTI_InitFtiff(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
         FTIT_keymap* FTI_Data);
 void FTIFF_InitMpiTypes();
-int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser);
-int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser);
-int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser);
+int FTIFF_GetLayout(FTIFF_layout* layout, uint32_t version);
+uint32_t FTIFF_GetFormatVersion(char* end);
+int FTIFF_DeserializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser,
+ FTIFF_layout* layout);
+int FTIFF_DeserializeDbMeta(FTIFF_db* db, char* buffer_ser,
+ FTIFF_layout* layout);
+int FTIFF_DeserializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser,
+ FTIFF_layout* layout);
 int FTIFF_SerializeFileMeta(FTIFF_metaInfo* meta, char* buffer_ser);
 int FTIFF_SerializeDbMeta(FTIFF_db* db, char* buffer_ser);
 int FTIFF_SerializeDbVarMeta(FTIFF_dbvar* dbvar, char* buffer_ser);
@@ -206,7 +234,7 @@ void FTIFF_SetHashChunk(FTIFF_dbvar *dbvar, FTIT_keymap* FTI_Data);
 void FTIFF_PrintDataStructure(int rank, FTIT_execution* FTI_Exec);
 int FTI_ProcessDBVar(FTIT_execution *FTI_Exec, FTIT_configuration *FTI_Conf,
  FTIFF_dbvar *currentdbvar,  FTIT_dataset *data, unsigned char *hashchk,
- WriteFTIFFInfo_t *fd, int32_t *dcpSize, unsigned char **dptr);
+ WriteFTIFFInfo_t *fd, int64_t *dcpSize, unsigned char **dptr);
 int FTIFF_RecoverVarInit(char* fn);
 int FTIFF_RecoverVarFinalize();
 #endif  // FTI_SRC_IO_FTIFF_H_
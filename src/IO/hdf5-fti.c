@@ -492,7 +492,7 @@ int FTI_CommitDataType(FTIT_execution *FTI_Exec, FTIT_dataset *data) {
 
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_CheckHDF5File(char* fn, int32_t fs, char* checksum) {
+int FTI_CheckHDF5File(char* fn, int64_t fs, char* checksum) {
     char str[FTI_BUFS];
     if (access(fn, F_OK) == 0) {
         struct stat fileStatus;
@@ -1115,7 +1115,7 @@ int  FTI_HDF5Close(void *fileDesc) {
     FTIT_keymap* FTI_Data = fd->FTI_Data;
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, fd->FTI_Exec->nbVar) != FTI_SCES)
+    if (FTI_Data->data(FTI_Data, &data, fd->FTI_Exec->nbVar) != FTI_SCES)
         return FTI_NSCS;
 
     for (i = 0; i < fd->FTI_Exec->nbVar; i++) {
@@ -1231,7 +1231,8 @@ void *FTI_InitHDF5(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     if (FTI_Exec->h5SingleFile) {
         FTIT_dataset* data;
-        if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return NULL;
+        if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+            return NULL;
         for (i = 0; i < FTI_Exec->nbVar; i++) {
             FTI_CommitDataType(FTI_Exec, &data[i]);
         }
@@ -1263,7 +1264,8 @@ int FTI_WriteHDF5(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     WriteHDF5Info_t *fd = FTI_InitHDF5(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
      FTI_Data);
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
     int i= 0; for (; i < FTI_Exec->nbVar; i++) {
         FTI_WriteHDF5Data(&data[i], fd);
     }
@@ -1327,7 +1329,8 @@ int FTI_RecoverHDF5(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     FTIT_dataset* data;
 
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
 
     for (i = 0; i < FTI_Exec->nbVar; i++) {
         FTI_CreateComplexType(data[i].type);
@@ -1445,7 +1448,8 @@ int FTI_RecoverVarFinalizeHDF5(FTIT_configuration* FTI_Conf,
     int i;
     FTIT_dataset* data;
 
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
 
     for (i = 0; i < FTI_Exec->nbVar; i++) {
         FTI_CloseComplexType(data[i].type);
@@ -1482,7 +1486,7 @@ int FTI_RecoverVarHDF5(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     FTIT_dataset* data;
     char str[FTI_BUFS], fn[FTI_BUFS];
 
-    if (FTI_Data->get(&data, id) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) return FTI_NSCS;
 
     if (!data) {
         FTI_Print("could not find ID!", FTI_WARN);
@@ -1505,8 +1509,8 @@ int FTI_RecoverVarHDF5(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
          FTI_Conf->h5SingleFilePrefix, FTI_Exec->ckptId);
     } else {
         if (data->size != data->sizeStored) {
-            snprintf(str, sizeof(str), "Cannot recover %d bytes to "
-                "protected variable (ID %d) size: %d",
+            snprintf(str, sizeof(str), "Cannot recover %ld bytes to "
+                "protected variable (ID %d) size: %ld",
                     data->sizeStored, data->id,
                     data->size);
             FTI_Print(str, FTI_WARN);
@@ -1845,7 +1849,7 @@ int FTI_CheckDimensions(FTIT_keymap * FTI_Data, FTIT_execution * FTI_Exec) {
         for (i = 0; i < dataset->numSubSets; ++i) {
             FTIT_dataset* data;
 
-            if (FTI_Data->get(&data, dataset->varId[i]) != FTI_SCES)
+            if (FTI_Data->get(FTI_Data, &data, dataset->varId[i]) != FTI_SCES)
                 return FTI_NSCS;
 
             if (!data) {
@@ -1996,7 +2000,8 @@ void FTI_FreeVPRMem(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data) {
     }
 
     FTIT_dataset* data;
-    if ((FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) || !data) return;
+    if ((FTI_Data->data(FTI_Data, &data,
+     FTI_Exec->nbVar) != FTI_SCES) || !data) return;
 
     int i = 0; for (; i < FTI_Exec->nbVar; i++) {
         if (data[i].sharedData.offset) {
@@ -0,0 +1,635 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   iouring.c
+ *  @date   October, 2026
+ *  @brief  Checkpoint writes through io_uring.
+ *
+ *  The checkpoint file has the POSIX layout, only the way it is written
+ *  differs. The data is copied into aligned staging buffers which are
+ *  registered to the ring, each full buffer is submitted as one write and
+ *  up to 'Advanced:uring_depth' writes are kept in flight. With
+ *  'Advanced:uring_direct' the file is opened with O_DIRECT. The rings
+ *  are set up with the raw system calls, liburing is not required. When
+ *  the ring cannot be created, the buffers are written with pwrite.
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "../interface.h"
+
+static int FTI_UringSetup(unsigned entries, struct io_uring_params* p) {
+    return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int FTI_UringEnter(int fd, unsigned toSubmit, unsigned minComplete,
+ unsigned flags) {
+    return (int) syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+     flags, NULL, 0);
+}
+
+static int FTI_UringRegister(int fd, unsigned opcode, void* arg,
+ unsigned nbArgs) {
+    return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nbArgs);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Unmaps the rings and closes the ring descriptor.
+  @param      ring            The ring.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_UringExit(FTIT_uring* ring) {
+    if (ring->sqes) munmap(ring->sqes, ring->sqesSize);
+    if (ring->cqRing && ring->cqRing != ring->sqRing) {
+        munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing) munmap(ring->sqRing, ring->sqRingSize);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(FTIT_uring));
+    ring->fd = -1;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Creates a ring and maps its queues.
+  @param      ring            The ring to initialize.
+  @param      entries         Number of submission entries.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringInit(FTIT_uring* ring, unsigned entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(ring, 0, sizeof(FTIT_uring));
+
+    ring->fd = FTI_UringSetup(entries, &p);
+    if (ring->fd < 0) {
+        ring->fd = -1;
+        return FTI_NSCS;
+    }
+
+    ring->sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = p.cq_off.cqes +
+     p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cqRingSize > ring->sqRingSize) {
+            ring->sqRingSize = ring->cqRingSize;
+        }
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE,
+     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED) {
+        ring->sqRing = NULL;
+        FTI_UringExit(ring);
+        return FTI_NSCS;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cqRing = ring->sqRing;
+    } else {
+        ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE,
+         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED) {
+            ring->cqRing = NULL;
+            FTI_UringExit(ring);
+            return FTI_NSCS;
+        }
+    }
+    ring->sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE,
+     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        FTI_UringExit(ring);
+        return FTI_NSCS;
+    }
+
+    char* sq = ring->sqRing;
+    char* cq = ring->cqRing;
+    ring->sqHead = (unsigned*) (sq + p.sq_off.head);
+    ring->sqTail = (unsigned*) (sq + p.sq_off.tail);
+    ring->sqMask = (unsigned*) (sq + p.sq_off.ring_mask);
+    ring->sqArray = (unsigned*) (sq + p.sq_off.array);
+    ring->cqHead = (unsigned*) (cq + p.cq_off.head);
+    ring->cqTail = (unsigned*) (cq + p.cq_off.tail);
+    ring->cqMask = (unsigned*) (cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Checks if the kernel provides io_uring.
+  @return     integer         FTI_SCES if a ring can be created.
+
+  Used at configuration time to fall back to the POSIX I/O when the
+  kernel is too old or io_uring is disabled (e.g. by seccomp).
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_UringProbe(void) {
+    FTIT_uring ring;
+    if (FTI_UringInit(&ring, 1) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    FTI_UringExit(&ring);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes the pending part of a buffer with pwrite.
+  @param      fd              The write descriptor.
+  @param      buf             The buffer.
+  @return     integer         FTI_SCES if successful.
+
+  Used when no ring is available.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringWriteSync(WriteUringInfo_t* fd, FTIT_uringBuffer* buf) {
+    while (buf->iov.iov_len > 0) {
+        ssize_t ret = pwrite(fd->fd, buf->iov.iov_base, buf->iov.iov_len,
+         buf->pos);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        buf->iov.iov_base = (char*) buf->iov.iov_base + ret;
+        buf->iov.iov_len -= ret;
+        buf->pos += ret;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Queues the pending part of a buffer to the ring.
+  @param      fd              The write descriptor.
+  @param      idx             Index of the buffer.
+  @return     integer         FTI_SCES if successful.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringSubmit(WriteUringInfo_t* fd, int idx) {
+    FTIT_uringBuffer* buf = &fd->bufs[idx];
+
+    if (fd->ring.fd < 0) {
+        int ret = FTI_UringWriteSync(fd, buf);
+        if (ret != FTI_SCES && fd->err == 0) fd->err = ret;
+        return ret;
+    }
+
+    FTIT_uring* ring = &fd->ring;
+    unsigned tail = *ring->sqTail;
+    unsigned slot = tail & *ring->sqMask;
+    struct io_uring_sqe* sqe = &ring->sqes[slot];
+
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->fd = fd->fd;
+    sqe->off = buf->pos;
+    sqe->user_data = idx;
+    if (fd->fixed) {
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->addr = (uint64_t) (uintptr_t) buf->iov.iov_base;
+        sqe->len = buf->iov.iov_len;
+        sqe->buf_index = idx;
+    } else {
+        sqe->opcode = IORING_OP_WRITEV;
+        sqe->addr = (uint64_t) (uintptr_t) &buf->iov;
+        sqe->len = 1;
+    }
+    ring->sqArray[slot] = slot;
+    __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int ret;
+    do {
+        ret = FTI_UringEnter(ring->fd, 1, 0, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        if (fd->err == 0) fd->err = -errno;
+        return FTI_NSCS;
+    }
+    buf->busy = true;
+    fd->inflight++;
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Waits for at least one write and processes the completions.
+  @param      fd              The write descriptor.
+  @return     integer         FTI_SCES if successful.
+
+  Short writes are queued again for their remaining part. Failed writes
+  are recorded in the descriptor, the call only fails if the ring does.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringReap(WriteUringInfo_t* fd) {
+    FTIT_uring* ring = &fd->ring;
+    unsigned head = *ring->cqHead;
+
+    while (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        int ret = FTI_UringEnter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR) {
+            if (fd->err == 0) fd->err = -errno;
+            return FTI_NSCS;
+        }
+    }
+
+    while (head != __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cqMask];
+        FTIT_uringBuffer* buf = &fd->bufs[cqe->user_data];
+        int written = cqe->res;
+        head++;
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+
+        buf->busy = false;
+        fd->inflight--;
+        if (written < 0) {
+            if (fd->err == 0) fd->err = written;
+            continue;
+        }
+        buf->iov.iov_base = (char*) buf->iov.iov_base + written;
+        buf->iov.iov_len -= written;
+        buf->pos += written;
+        if (buf->iov.iov_len > 0 && fd->err == 0) {
+            FTI_UringSubmit(fd, cqe->user_data);
+        }
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns a staging buffer that is not in flight.
+  @param      fd              The write descriptor.
+  @return     integer         Index of the buffer, -1 on error.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringAcquire(WriteUringInfo_t* fd) {
+    while (fd->err == 0) {
+        int i;
+        for (i = 0; i < fd->nbBufs; i++) {
+            if (!fd->bufs[i].busy) return i;
+        }
+        if (FTI_UringReap(fd) != FTI_SCES) break;
+    }
+    return -1;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Submits the buffer being filled.
+  @param      fd              The write descriptor.
+  @return     integer         FTI_SCES if successful.
+
+  With O_DIRECT the last buffer of the file is padded to the alignment,
+  the file is truncated to its size when it is closed.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_UringFlush(WriteUringInfo_t* fd) {
+    if (fd->cur < 0 || fd->fill == 0) return FTI_SCES;
+
+    FTIT_uringBuffer* buf = &fd->bufs[fd->cur];
+    size_t len = fd->fill;
+    if (fd->direct && len % FTI_URING_ALIGN != 0) {
+        size_t padded = ((len + FTI_URING_ALIGN - 1) / FTI_URING_ALIGN) *
+         FTI_URING_ALIGN;
+        memset((char*) buf->ptr + len, 0, padded - len);
+        len = padded;
+    }
+    buf->iov.iov_base = buf->ptr;
+    buf->iov.iov_len = len;
+    buf->pos = fd->offset - fd->fill;
+    fd->cur = -1;
+    fd->fill = 0;
+    return FTI_UringSubmit(fd, buf - fd->bufs);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Prints the first error of the write descriptor.
+  @param      fd              The write descriptor.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_UringPrintError(WriteUringInfo_t* fd) {
+    char str[FTI_BUFS];
+    snprintf(str, FTI_BUFS, "Unable to write : [IO_URING ERROR - %s.]",
+     strerror(-fd->err));
+    FTI_Print(str, FTI_EROR);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Opens a checkpoint file and sets up its ring.
+  @param      FTI_Conf        Configuration metadata.
+  @param      fn              Path of the file.
+  @param      fd              The write descriptor.
+  @return     integer         FTI_SCES if successful.
+
+  If the file system refuses O_DIRECT, the file is opened without it. If
+  the buffers cannot be registered (e.g. memlock limit), the writes are
+  vectored from the same buffers, and if no ring can be created, the
+  buffers are written with pwrite.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_UringOpen(FTIT_configuration* FTI_Conf, char *fn,
+ WriteUringInfo_t* fd) {
+    char str[FTI_BUFS];
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+    fd->direct = false;
+    if (FTI_Conf->uringDirect) {
+        fd->fd = open(fn, flags | O_DIRECT, 0644);
+        if (fd->fd >= 0) {
+            fd->direct = true;
+        } else if (errno == EINVAL) {
+            FTI_Print("O_DIRECT is not supported for the checkpoint file,"
+             " using buffered I/O.", FTI_DBUG);
+        }
+    }
+    if (fd->fd < 0) {
+        fd->fd = open(fn, flags, 0644);
+    }
+    if (fd->fd < 0) {
+        snprintf(str, FTI_BUFS, "unable to create file [POSIX ERROR - %d] %s",
+         errno, strerror(errno));
+        FTI_Print(str, FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    fd->nbBufs = FTI_Conf->uringDepth;
+    fd->bufSize = FTI_Conf->uringBufferSize;
+    fd->bufs = talloc(FTIT_uringBuffer, fd->nbBufs);
+    if (!fd->bufs || posix_memalign(&fd->mem, FTI_URING_ALIGN,
+     fd->bufSize * fd->nbBufs) != 0) {
+        FTI_Print("unable to allocate the io_uring buffers", FTI_EROR);
+        free(fd->bufs);
+        fd->bufs = NULL;
+        fd->mem = NULL;
+        close(fd->fd);
+        return FTI_NSCS;
+    }
+    struct iovec* iov = talloc(struct iovec, fd->nbBufs);
+    int i;
+    for (i = 0; i < fd->nbBufs; i++) {
+        fd->bufs[i].ptr = (char*) fd->mem + i * fd->bufSize;
+        fd->bufs[i].busy = false;
+        if (iov) {
+            iov[i].iov_base = fd->bufs[i].ptr;
+            iov[i].iov_len = fd->bufSize;
+        }
+    }
+
+    fd->fixed = false;
+    if (FTI_UringInit(&fd->ring, fd->nbBufs) != FTI_SCES) {
+        FTI_Print("unable to create an io_uring instance, writing with"
+         " pwrite.", FTI_WARN);
+    } else if (iov && FTI_UringRegister(fd->ring.fd, IORING_REGISTER_BUFFERS,
+     iov, fd->nbBufs) == 0) {
+        fd->fixed = true;
+    }
+    free(iov);
+
+    fd->offset = 0;
+    fd->cur = -1;
+    fd->fill = 0;
+    fd->inflight = 0;
+    fd->err = 0;
+    MD5_Init(&(fd->integrity));
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Initializes the files for the upcoming checkpoint.
+  @param      FTI_Conf          Configuration of FTI
+  @param      FTI_Exec          Execution environment options
+  @param      FTI_Topo          Topology of nodes
+  @param      FTI_Ckpt          Checkpoint configurations
+  @param      FTI_Data          Data to be stored
+  @return     void*             Return void pointer to file descriptor
+
+ **/
+/*-------------------------------------------------------------------------*/
+void* FTI_InitUring(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_topology* FTI_Topo, FTIT_checkpoint *FTI_Ckpt, FTIT_keymap *FTI_Data) {
+    FTI_Print("I/O mode: io_uring.", FTI_DBUG);
+
+    char fn[FTI_BUFS];
+    int level = FTI_Exec->ckptMeta.level;
+
+    WriteUringInfo_t *write_info = talloc(WriteUringInfo_t, 1);
+    if (!write_info) return NULL;
+    memset(write_info, 0, sizeof(WriteUringInfo_t));
+    write_info->fd = -1;
+
+    snprintf(FTI_Exec->ckptMeta.ckptFile, FTI_BUFS, "Ckpt%d-Rank%d.%s",
+     FTI_Exec->ckptMeta.ckptId, FTI_Topo->myRank, FTI_Conf->suffix);
+
+    if (level == 4 && FTI_Ckpt[4].isInline) {
+        // If inline L4 save directly to global directory
+        snprintf(fn, FTI_BUFS, "%s/%s", FTI_Conf->gTmpDir,
+         FTI_Exec->ckptMeta.ckptFile);
+    } else {
+        snprintf(fn, FTI_BUFS, "%s/%s", FTI_Conf->lTmpDir,
+         FTI_Exec->ckptMeta.ckptFile);
+    }
+
+    if (FTI_UringOpen(FTI_Conf, fn, write_info) != FTI_SCES) {
+        free(write_info);
+        return NULL;
+    }
+    return write_info;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Appends data to the file
+  @param      src               pointer pointing to the data to be stored
+  @param      size              size of the data to be written
+  @param      fileDesc          The fileDescriptor
+  @return     integer         Return FTI_SCES  when successfuly write the data to the file
+
+  The data is copied to the staging buffers, the call returns once the
+  last bytes are copied. Full buffers are already in flight.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_UringWrite(void *src, size_t size, void *fileDesc) {
+    WriteUringInfo_t *fd = (WriteUringInfo_t *) fileDesc;
+    char* ptr = src;
+    size_t left = size;
+
+    while (left > 0) {
+        if (fd->cur < 0) {
+            fd->cur = FTI_UringAcquire(fd);
+            fd->fill = 0;
+            if (fd->cur < 0) break;
+        }
+        size_t n = fd->bufSize - fd->fill;
+        if (n > left) n = left;
+        memcpy((char*) fd->bufs[fd->cur].ptr + fd->fill, ptr, n);
+        fd->fill += n;
+        fd->offset += n;
+        ptr += n;
+        left -= n;
+        if (fd->fill == fd->bufSize && FTI_UringFlush(fd) != FTI_SCES) {
+            break;
+        }
+    }
+
+    if (fd->err != 0) {
+        FTI_UringPrintError(fd);
+        return FTI_NSCS;
+    }
+    MD5_Update(&(fd->integrity), src, size);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes a dataset to the checkpoint file.
+  @param      data            The dataset.
+  @param      fd              The write descriptor.
+  @return     integer         FTI_SCES if successful.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_WriteUringData(FTIT_dataset * data, void *fd) {
+    WriteUringInfo_t *write_info = (WriteUringInfo_t*) fd;
+    char str[FTI_BUFS];
+    int res;
+
+    if (!(data->isDevicePtr)) {
+        res = FTI_Try(FTI_UringWrite(data->ptr, data->size, write_info),
+         "Storing Data to Checkpoint file");
+    }
+#ifdef GPUSUPPORT
+    // if data are stored to the GPU move them from device
+    // memory to cpu memory and store them.
+    else {
+        res = FTI_Try(FTI_TransferDeviceMemToFileAsync(data, FTI_UringWrite,
+         write_info), "moving data from GPU to storage");
+    }
+#endif
+    if (res != FTI_SCES) {
+        snprintf(str, FTI_BUFS, "Dataset #%d could not be written.",
+         data->id);
+        FTI_Print(str, FTI_EROR);
+        FTI_UringClose(write_info);
+        return FTI_NSCS;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Return the current file postion
+  @param      fileDesc          The fileDescriptor
+  @return     size_t            Position of the file descriptor
+
+ **/
+/*-------------------------------------------------------------------------*/
+size_t FTI_GetUringFilePos(void *fileDesc) {
+    WriteUringInfo_t *fd = (WriteUringInfo_t *) fileDesc;
+    return fd->offset;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Completes the pending writes and closes the file
+  @param      fileDesc          The fileDescriptor
+  @return     integer         Return FTI_SCES  when successfuly write the data to the file
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_UringClose(void *fileDesc) {
+    WriteUringInfo_t *fd = (WriteUringInfo_t *) fileDesc;
+
+    if (fd->fd < 0) return FTI_NSCS;
+
+    if (fd->err == 0) {
+        FTI_UringFlush(fd);
+    }
+    // the buffers are released once the kernel is done with them
+    while (fd->inflight > 0 && fd->ring.fd >= 0) {
+        if (FTI_UringReap(fd) != FTI_SCES) break;
+    }
+    if (fd->direct && fd->err == 0 && ftruncate(fd->fd, fd->offset) != 0) {
+        fd->err = -errno;
+    }
+    if (fd->err == 0 && fsync(fd->fd) != 0) {
+        fd->err = -errno;
+    }
+
+    if (fd->ring.fd >= 0) {
+        if (fd->fixed) {
+            FTI_UringRegister(fd->ring.fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+        }
+        FTI_UringExit(&fd->ring);
+    }
+    close(fd->fd);
+    fd->fd = -1;
+    free(fd->mem);
+    free(fd->bufs);
+    fd->mem = NULL;
+    fd->bufs = NULL;
+
+    if (fd->err != 0) {
+        FTI_UringPrintError(fd);
+        return FTI_NSCS;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Finalizes the checksum of the file.
+  @param      dest            Where to store the checksum.
+  @param      md5             Md5 checksum up to now.
+  @return     void.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_UringMD5(unsigned char *dest, void *md5) {
+    WriteUringInfo_t *write_info = (WriteUringInfo_t *) md5;
+    MD5_Final(dest, &(write_info->integrity));
+}
@@ -0,0 +1,82 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   iouring.h
+ */
+
+#ifndef FTI_SRC_IO_IOURING_H_
+#define FTI_SRC_IO_IOURING_H_
+
+#ifdef ENABLE_IOURING
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of the staging buffers and of the O_DIRECT writes **/
+#define FTI_URING_ALIGN 4096
+
+/** Submission and completion rings shared with the kernel **/
+typedef struct FTIT_uring {
+    int                     fd;         /**< Ring descriptor, -1 if none      */
+    unsigned*               sqHead;
+    unsigned*               sqTail;
+    unsigned*               sqMask;
+    unsigned*               sqArray;
+    struct io_uring_sqe*    sqes;
+    unsigned*               cqHead;
+    unsigned*               cqTail;
+    unsigned*               cqMask;
+    struct io_uring_cqe*    cqes;
+    void*                   sqRing;
+    size_t                  sqRingSize;
+    void*                   cqRing;
+    size_t                  cqRingSize;
+    size_t                  sqesSize;
+} FTIT_uring;
+
+/** Staging buffer and the write it is part of **/
+typedef struct FTIT_uringBuffer {
+    void*           ptr;            /**< Aligned staging memory               */
+    struct iovec    iov;            /**< Part of the write still pending      */
+    int64_t         pos;            /**< File offset of 'iov'                 */
+    bool            busy;           /**< Submitted and not yet completed      */
+} FTIT_uringBuffer;
+
+typedef struct {
+    int fd;                         // file descriptor
+    size_t offset;                  // bytes written to the file
+    bool direct;                    // file opened with O_DIRECT
+    MD5_CTX integrity;              // integrity of the file
+    FTIT_uring ring;                // io_uring instance
+    bool fixed;                     // buffers are registered to the ring
+    FTIT_uringBuffer* bufs;         // staging buffers
+    int nbBufs;                     // number of staging buffers
+    size_t bufSize;                 // size of one staging buffer
+    void* mem;                      // memory of the staging buffers
+    int cur;                        // buffer being filled, -1 if none
+    size_t fill;                    // bytes copied in the current buffer
+    int inflight;                   // writes submitted to the ring
+    int err;                        // first error encountered
+} WriteUringInfo_t;
+
+int FTI_UringProbe(void);
+void* FTI_InitUring(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_topology* FTI_Topo, FTIT_checkpoint *FTI_Ckpt, FTIT_keymap *FTI_Data);
+int FTI_UringOpen(FTIT_configuration* FTI_Conf, char *fn,
+ WriteUringInfo_t* fd);
+int FTI_UringWrite(void *src, size_t size, void *fileDesc);
+int FTI_WriteUringData(FTIT_dataset * data, void *fd);
+size_t FTI_GetUringFilePos(void *fileDesc);
+int FTI_UringClose(void *fileDesc);
+void FTI_UringMD5(unsigned char *dest, void *md5);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // ENABLE_IOURING
+#endif  // FTI_SRC_IO_IOURING_H_
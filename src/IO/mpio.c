@@ -205,7 +205,8 @@ void *FTI_InitMPIO(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     char gfn[FTI_BUFS], ckptFile[FTI_BUFS];
     int i;
     MPI_Offset offset = 0;
-    MPI_Offset chunkSize = FTI_Exec->ckptSize;
+    MPI_Offset chunkSize = (FTI_Exec->encodedSize > 0) ?
+     FTI_Exec->encodedSize : FTI_Exec->ckptSize;
     WriteMPIInfo_t *write_info = (WriteMPIInfo_t*)
     malloc(sizeof(WriteMPIInfo_t));
 
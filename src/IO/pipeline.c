@@ -0,0 +1,392 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   pipeline.c
+ *  @date   October, 2026
+ *  @brief  Pipelined checkpoint writer.
+ *
+ *  The protected datasets are cut into chunks that flow through three
+ *  stages connected by a bounded ring of chunk slots:
+ *
+ *  - the calling thread serializes the datasets into chunks (device
+ *    data is copied into a staging buffer owned by the slot),
+ *  - one digest thread feeds the chunks, in file order, to the
+ *    integrity checksum of the backend,
+ *  - a pool of writer threads writes the chunks at their file offset.
+ *
+ *  A slot is recycled once it has been both hashed and written, so at
+ *  most 'write_queue_depth' chunks are in flight. The resulting file
+ *  and checksum are identical to the ones of the serial writer.
+ */
+
+#include <pthread.h>
+
+#include "../interface.h"
+#include "pipeline.h"
+
+/** Chunk slot of the pipeline ring **/
+typedef struct FTIT_pchunk {
+    void*       src;        /**< Data to hash and write                   */
+    void*       buf;        /**< Staging buffer for copied data           */
+    size_t      size;       /**< Size of the chunk                        */
+    size_t      offset;     /**< File offset of the chunk                 */
+    bool        filled;     /**< TRUE while the slot is in use            */
+    bool        hashed;     /**< TRUE once the digest stage is done       */
+    bool        written;    /**< TRUE once the write stage is done        */
+} FTIT_pchunk;
+
+/** Shared state of the pipelined writer **/
+typedef struct FTIT_pipeline {
+    FTIT_IO*        io;         /**< Backend of the checkpoint            */
+    void*           fd;         /**< Backend file descriptor              */
+    FTIT_pchunk*    ring;       /**< Chunk slots                          */
+    int             depth;      /**< Number of chunk slots                */
+    size_t          chunkSize;  /**< Maximum chunk size                   */
+    size_t          pos;        /**< File offset of the next chunk        */
+    uint64_t        nbFilled;   /**< Chunks produced so far               */
+    uint64_t        nbHashed;   /**< Chunks digested so far               */
+    uint64_t        nbClaimed;  /**< Chunks claimed by writers so far     */
+    bool            done;       /**< TRUE when no more chunks will come   */
+    int             status;     /**< FTI_NSCS once a stage failed         */
+    pthread_mutex_t lock;
+    pthread_cond_t  work;       /**< Signaled when a chunk is produced    */
+    pthread_cond_t  slot;       /**< Signaled when a slot is released     */
+} FTIT_pipeline;
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Marks a chunk as processed by a consumer stage.
+  @param      pipe            The pipeline (lock held).
+  @param      chunk           The chunk slot.
+
+  Releases the slot for the producer once both consumer stages are done.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_PipelineRelease(FTIT_pipeline* pipe, FTIT_pchunk* chunk) {
+    if (chunk->hashed && chunk->written) {
+        chunk->filled = false;
+        pthread_cond_signal(&pipe->slot);
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Digest stage, updates the checksum in file order.
+  @param      arg             The pipeline.
+  @return     void*           NULL.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void* FTI_PipelineDigest(void* arg) {
+    FTIT_pipeline* pipe = (FTIT_pipeline*) arg;
+
+    pthread_mutex_lock(&pipe->lock);
+    while (true) {
+        while (pipe->nbHashed == pipe->nbFilled && !pipe->done) {
+            pthread_cond_wait(&pipe->work, &pipe->lock);
+        }
+        if (pipe->nbHashed == pipe->nbFilled) break;
+
+        FTIT_pchunk* chunk = &pipe->ring[pipe->nbHashed % pipe->depth];
+        bool skip = (pipe->status != FTI_SCES);
+        pthread_mutex_unlock(&pipe->lock);
+
+        if (!skip) {
+            pipe->io->updIntegrity(chunk->src, chunk->size, pipe->fd);
+        }
+
+        pthread_mutex_lock(&pipe->lock);
+        chunk->hashed = true;
+        pipe->nbHashed++;
+        FTI_PipelineRelease(pipe, chunk);
+    }
+    pthread_mutex_unlock(&pipe->lock);
+    return NULL;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Write stage, writes chunks at their file offset.
+  @param      arg             The pipeline.
+  @return     void*           NULL.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void* FTI_PipelineWriter(void* arg) {
+    FTIT_pipeline* pipe = (FTIT_pipeline*) arg;
+
+    pthread_mutex_lock(&pipe->lock);
+    while (true) {
+        while (pipe->nbClaimed == pipe->nbFilled && !pipe->done) {
+            pthread_cond_wait(&pipe->work, &pipe->lock);
+        }
+        if (pipe->nbClaimed == pipe->nbFilled) break;
+
+        FTIT_pchunk* chunk = &pipe->ring[pipe->nbClaimed % pipe->depth];
+        pipe->nbClaimed++;
+        bool skip = (pipe->status != FTI_SCES);
+        pthread_mutex_unlock(&pipe->lock);
+
+        int res = FTI_SCES;
+        if (!skip) {
+            res = pipe->io->WriteAt(chunk->src, chunk->size, chunk->offset,
+             pipe->fd);
+        }
+
+        pthread_mutex_lock(&pipe->lock);
+        if (res != FTI_SCES) {
+            pipe->status = FTI_NSCS;
+            // wake up the producer in case it waits for a slot
+            pthread_cond_broadcast(&pipe->slot);
+        }
+        chunk->written = true;
+        FTI_PipelineRelease(pipe, chunk);
+    }
+    pthread_mutex_unlock(&pipe->lock);
+    return NULL;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Serialize stage, cuts a buffer into chunks.
+  @param      pipe            The pipeline.
+  @param      src             Buffer to checkpoint.
+  @param      size            Size of the buffer.
+  @param      copy            TRUE if the buffer has to be staged.
+  @return     integer         FTI_SCES if successful.
+
+  Blocks while all the chunk slots are in flight. If 'copy' is set, the
+  data is copied to the staging buffer of the slot, so the caller can
+  reuse 'src' as soon as the function returns.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_PipelineEnqueue(FTIT_pipeline* pipe, void* src, size_t size,
+ bool copy) {
+    size_t done = 0;
+
+    while (done < size) {
+        size_t len = size - done;
+        if (len > pipe->chunkSize) len = pipe->chunkSize;
+
+        pthread_mutex_lock(&pipe->lock);
+        FTIT_pchunk* chunk = &pipe->ring[pipe->nbFilled % pipe->depth];
+        while (chunk->filled && pipe->status == FTI_SCES) {
+            pthread_cond_wait(&pipe->slot, &pipe->lock);
+        }
+        int status = pipe->status;
+        pthread_mutex_unlock(&pipe->lock);
+        if (status != FTI_SCES) return FTI_NSCS;
+
+        // the slot is not visible to the consumers until it is published
+        if (copy) {
+            if (chunk->buf == NULL) {
+                chunk->buf = malloc(pipe->chunkSize);
+                if (chunk->buf == NULL) {
+                    FTI_Print("Unable to allocate pipeline staging buffer.",
+                     FTI_EROR);
+                    return FTI_NSCS;
+                }
+            }
+            memcpy(chunk->buf, (char*) src + done, len);
+            chunk->src = chunk->buf;
+        } else {
+            chunk->src = (char*) src + done;
+        }
+        chunk->size = len;
+        chunk->offset = pipe->pos;
+        chunk->hashed = false;
+        chunk->written = false;
+
+        pthread_mutex_lock(&pipe->lock);
+        chunk->filled = true;
+        pipe->nbFilled++;
+        pthread_cond_broadcast(&pipe->work);
+        pthread_mutex_unlock(&pipe->lock);
+
+        pipe->pos += len;
+        done += len;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Stages a host copy of device data into the pipeline.
+  @param      src             Host buffer of the prefetcher.
+  @param      size            Size of the buffer.
+  @param      opaque          The pipeline.
+  @return     integer         FTI_SCES if successful.
+
+  Has the signature of FTIT_fwritefunc to be used together with
+  FTI_TransferDeviceMemToFileAsync.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_PipelineStage(void* src, size_t size, void* opaque) {
+    return FTI_PipelineEnqueue((FTIT_pipeline*) opaque, src, size, true);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Checks if a checkpoint can use the pipelined writer.
+  @param      FTI_Conf        Configuration metadata.
+  @param      io              Backend of the checkpoint.
+  @return     bool            TRUE if the pipeline is enabled and supported.
+
+ **/
+/*-------------------------------------------------------------------------*/
+bool FTI_PipelineSupported(FTIT_configuration* FTI_Conf, FTIT_IO *io) {
+    return (FTI_Conf->writeThreads > 0) && (io->setPos != NULL) &&
+     (io->WriteAt != NULL) && (io->updIntegrity != NULL);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes all protected datasets using the pipelined writer.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      io              Backend of the checkpoint.
+  @param      write_info      Backend file descriptor from initCKPT.
+  @param      enc             Encoded datasets from FTI_CodecEncode or NULL.
+  @return     integer         FTI_SCES if successful.
+
+  Replaces the getPos/WriteData loop of FTI_Write. The datasets are
+  stored contiguously starting at the current file position, which is
+  also where the file position is left on return. The encoded image of
+  a dataset is written in place of its data.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_PipelineWrite(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_keymap* FTI_Data, FTIT_IO *io, void *write_info,
+ FTIT_codecBuffer* enc) {
+    char str[FTI_BUFS];
+    FTIT_dataset* data;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
+
+    FTIT_pipeline pipe;
+    memset(&pipe, 0x0, sizeof(FTIT_pipeline));
+    pipe.io = io;
+    pipe.fd = write_info;
+    pipe.depth = FTI_Conf->writeQueueDepth;
+    pipe.chunkSize = FTI_Conf->writeChunkSize;
+    pipe.status = FTI_SCES;
+    pipe.pos = io->getPos(write_info);
+
+    // flush the stream, chunks are written with positional writes
+    if (io->setPos(pipe.pos, write_info) != FTI_SCES) return FTI_NSCS;
+
+    pipe.ring = (FTIT_pchunk*) calloc(pipe.depth, sizeof(FTIT_pchunk));
+    if (pipe.ring == NULL) {
+        FTI_Print("Unable to allocate pipeline ring.", FTI_EROR);
+        return FTI_NSCS;
+    }
+    pthread_mutex_init(&pipe.lock, NULL);
+    pthread_cond_init(&pipe.work, NULL);
+    pthread_cond_init(&pipe.slot, NULL);
+
+    int nbThreads = 0;
+    pthread_t* threads = talloc(pthread_t, FTI_Conf->writeThreads + 1);
+    if (pthread_create(&threads[nbThreads], NULL, FTI_PipelineDigest,
+     &pipe) == 0) {
+        nbThreads++;
+    } else {
+        pipe.status = FTI_NSCS;
+    }
+    int i;
+    for (i = 0; i < FTI_Conf->writeThreads && pipe.status == FTI_SCES; i++) {
+        if (pthread_create(&threads[nbThreads], NULL, FTI_PipelineWriter,
+         &pipe) != 0) {
+            break;
+        }
+        nbThreads++;
+    }
+    if (nbThreads < 2) {
+        FTI_Print("Unable to start the pipeline threads.", FTI_EROR);
+        pipe.status = FTI_NSCS;
+    } else if (nbThreads < FTI_Conf->writeThreads + 1) {
+        snprintf(str, FTI_BUFS, "Pipelined writer started %d out of %d"
+         " writer threads.", nbThreads - 1, FTI_Conf->writeThreads);
+        FTI_Print(str, FTI_WARN);
+    }
+
+    for (i = 0; i < FTI_Exec->nbVar && pipe.status == FTI_SCES; i++) {
+        data[i].filePos = pipe.pos;
+        int res;
+        if (enc != NULL && enc[i].ptr != NULL) {
+            res = FTI_PipelineEnqueue(&pipe, enc[i].ptr, enc[i].size, false);
+        } else if (!(data[i].isDevicePtr)) {
+            res = FTI_PipelineEnqueue(&pipe, data[i].ptr, data[i].size, false);
+        } else {
+            res = FTI_TransferDeviceMemToFileAsync(&data[i], FTI_PipelineStage,
+             &pipe);
+        }
+        if (res != FTI_SCES) {
+            snprintf(str, FTI_BUFS, "Dataset #%d could not be written.",
+             data[i].id);
+            FTI_Print(str, FTI_EROR);
+            pthread_mutex_lock(&pipe.lock);
+            pipe.status = FTI_NSCS;
+            pthread_mutex_unlock(&pipe.lock);
+        }
+    }
+
+    pthread_mutex_lock(&pipe.lock);
+    pipe.done = true;
+    pthread_cond_broadcast(&pipe.work);
+    pthread_mutex_unlock(&pipe.lock);
+
+    for (i = 0; i < nbThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int res = pipe.status;
+    if (res == FTI_SCES) {
+        res = io->setPos(pipe.pos, write_info);
+    }
+
+    for (i = 0; i < pipe.depth; i++) {
+        free(pipe.ring[i].buf);
+    }
+    free(pipe.ring);
+    free(threads);
+    pthread_cond_destroy(&pipe.slot);
+    pthread_cond_destroy(&pipe.work);
+    pthread_mutex_destroy(&pipe.lock);
+
+    return res;
+}
@@ -0,0 +1,22 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   pipeline.h
+ */
+
+#ifndef FTI_SRC_IO_PIPELINE_H_
+#define FTI_SRC_IO_PIPELINE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool FTI_PipelineSupported(FTIT_configuration* FTI_Conf, FTIT_IO *io);
+int FTI_PipelineWrite(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_keymap* FTI_Data, FTIT_IO *io, void *write_info, FTIT_codecBuffer* enc);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // FTI_SRC_IO_PIPELINE_H_
@@ -41,7 +41,65 @@
 #include "../api-cuda.h"
 #include "cuda-md5/md5Opt.h"
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads the constant meta data at the beginning of a dCP file.
+  @param      fd              File descriptor of the dCP file.
+  @param      version         On return, format version of the file.
+  @param      blockSize       On return, dCP block size of the file.
+  @param      stackSize       On return, dCP stack size of the file.
+  @return     size_t          Bytes read, 0 on error.
+
+  Version 1 files start directly with the block size.
+ **/
+/*-------------------------------------------------------------------------*/
+static size_t FTI_ReadDcpPosixHeader(FILE* fd, uint32_t* version,
+ uint32_t* blockSize, unsigned int* stackSize) {
+    char magic[4];
+    size_t bytes = fread(magic, 1, sizeof(magic), fd);
+    if (bytes != sizeof(magic)) return 0;
+
+    if (memcmp(magic, DCP_POSIX_MAGIC, sizeof(magic)) == 0) {
+        bytes += fread(version, 1, sizeof(uint32_t), fd);
+        bytes += fread(blockSize, 1, sizeof(uint32_t), fd);
+    } else {
+        *version = DCP_POSIX_VERSION_LEGACY;
+        memcpy(blockSize, magic, sizeof(uint32_t));
+    }
+    bytes += fread(stackSize, 1, sizeof(unsigned int), fd);
+
+    if (ferror(fd) || feof(fd)) return 0;
+
+    if (*version > DCP_POSIX_VERSION) {
+        char str[FTI_BUFS];
+        snprintf(str, FTI_BUFS, "unknown dCP file format version %u",
+         *version);
+        FTI_Print(str, FTI_WARN);
+        return 0;
+    }
 
+    return bytes;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads the size of a dataset in the base layer of a dCP file.
+  @param      fd              File descriptor of the dCP file.
+  @param      version         Format version of the file.
+  @param      dataSize        On return, size of the dataset.
+  @return     size_t          Bytes read.
+ **/
+/*-------------------------------------------------------------------------*/
+static size_t FTI_ReadDcpPosixDataSize(FILE* fd, uint32_t version,
+ uint64_t* dataSize) {
+    if (version == DCP_POSIX_VERSION_LEGACY) {
+        uint32_t size32 = 0;
+        size_t bytes = fread(&size32, 1, sizeof(uint32_t), fd);
+        *dataSize = size32;
+        return bytes;
+    }
+    return fread(dataSize, 1, sizeof(uint64_t), fd);
+}
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -102,7 +160,8 @@ void *FTI_InitDCPPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     // data by setting hashdatasize = 0
     if (dcpLayer == 0) {
         FTIT_dataset* data;
-        if ((FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) || !data)
+        if ((FTI_Data->data(FTI_Data, &data,
+         FTI_Exec->nbVar) != FTI_SCES) || !data)
             return write_DCPinfo;
 
         int i = 0; for (; i < FTI_Exec->nbVar; i++) {
@@ -133,16 +192,22 @@ void *FTI_InitDCPPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     if (dcpLayer == 0) FTI_Exec->dcpInfoPosix.FileSize = 0;
 
     // write constant meta data in the beginning of file
+    // - magic and format version
     // - blocksize
     // - stacksize
     if (dcpLayer == 0) {
+        uint32_t version = DCP_POSIX_VERSION;
+        FWRITE(NULL, bytes, DCP_POSIX_MAGIC, 4, 1, write_info->f, "p",
+         write_info);
+        FWRITE(NULL, bytes, &version, sizeof(uint32_t), 1, write_info->f,
+         "p", write_info);
         FWRITE(NULL, bytes, &FTI_Conf->dcpInfoPosix.BlockSize,
          sizeof(uint32_t), 1, write_info->f, "p", write_info);
         FWRITE(NULL, bytes, &FTI_Conf->dcpInfoPosix.StackSize,
          sizeof(unsigned int), 1, write_info->f, "p", write_info);
-        FTI_Exec->dcpInfoPosix.FileSize += sizeof(uint32_t) +
+        FTI_Exec->dcpInfoPosix.FileSize += 4 + 2*sizeof(uint32_t) +
          sizeof(unsigned int);
-        write_DCPinfo->layerSize += sizeof(uint32_t) +
+        write_DCPinfo->layerSize += 4 + 2*sizeof(uint32_t) +
          sizeof(unsigned int);
     }
 
@@ -186,15 +251,16 @@ int FTI_WritePosixDCPData(FTIT_dataset *data, void *fd) {
     int32_t varId = data->id;
 
     FTI_Exec->dcpInfoPosix.dataSize += data->size;
-    uint32_t dataSize = data->size;
+    uint64_t dataSize = data->size;
     // uint32_t nbHashes = dataSize/FTI_Conf->dcpInfoPosix.BlockSize +
     // (bool)(dataSize%FTI_Conf->dcpInfoPosix.BlockSize);
 
-    if (dataSize > (MAX_BLOCK_IDX*FTI_Conf->dcpInfoPosix.BlockSize)) {
+    uint64_t maxDataSize = ((uint64_t)MAX_BLOCK_IDX) *
+     FTI_Conf->dcpInfoPosix.BlockSize;
+    if (dataSize > maxDataSize) {
         snprintf(errstr, FTI_BUFS, "overflow in size of dataset with id:"
-            " %d (datasize: %u > MAX_DATA_SIZE: %u)", data->id, dataSize,
-             ((uint32_t)MAX_BLOCK_IDX)*
-             ((uint32_t)FTI_Conf->dcpInfoPosix.BlockSize));
+            " %d (datasize: %lu > MAX_DATA_SIZE: %lu)", data->id, dataSize,
+             maxDataSize);
         FTI_Print(errstr, FTI_EROR);
         return FTI_NSCS;
     }
@@ -216,13 +282,13 @@ int FTI_WritePosixDCPData(FTIT_dataset *data, void *fd) {
     if (dcpLayer == 0) {
         FWRITE(FTI_NSCS, bytes, &data->id, sizeof(int), 1,
          write_info->f, "p", block);
-        FWRITE(FTI_NSCS, bytes, &dataSize, sizeof(uint32_t), 1,
+        FWRITE(FTI_NSCS, bytes, &dataSize, sizeof(uint64_t), 1,
          write_info->f, "p", block);
         FTI_Exec->dcpInfoPosix.FileSize += (sizeof(int) +
-         sizeof(uint32_t));
-        write_DCPinfo->layerSize += sizeof(int) + sizeof(uint32_t);
+         sizeof(uint64_t));
+        write_DCPinfo->layerSize += sizeof(int) + sizeof(uint64_t);
     }
-    uint32_t pos = 0;
+    uint64_t pos = 0;
 
     FTIT_data_prefetch prefetcher;
     size_t totalBytes = 0;
@@ -257,7 +323,8 @@ int FTI_WritePosixDCPData(FTIT_dataset *data, void *fd) {
         while (pos < totalBytes) {
             // hash index
             unsigned int blockId = offset/FTI_Conf->dcpInfoPosix.BlockSize;
-            unsigned int hashIdx = blockId*FTI_Conf->dcpInfoPosix.digestWidth;
+            size_t hashIdx = (size_t) blockId *
+             FTI_Conf->dcpInfoPosix.digestWidth;
 
             blockMeta.blockId = blockId;
 
@@ -393,16 +460,67 @@ int FTI_PosixDCPClose(void *fileDesc) {
 
 
 
+/** Location of the last copy of each block of a dataset in a dCP file **/
+typedef struct FTIT_dcpBlockMap {
+    FTIT_dataset*   data;
+    int64_t         nbBlocks;
+    int64_t*        pos;        /**< Offset of the block, -1 if absent    */
+    uint32_t*       size;       /**< Bytes of the block to recover        */
+} FTIT_dcpBlockMap;
+
+/* Returns the block map of a dataset, creating it on first use. */
+static FTIT_dcpBlockMap* FTI_DcpBlockMapGet(FTIT_execution* FTI_Exec,
+ FTIT_keymap* FTI_Data, FTIT_dcpBlockMap* maps, int* nbMaps, int varId,
+ uint32_t blockSize) {
+    char errstr[FTI_BUFS];
+    int i;
+    for (i = *nbMaps - 1; i >= 0; i--) {
+        if (maps[i].data->id == varId) {
+            return &maps[i];
+        }
+    }
+
+    FTIT_dataset* data;
+    if (FTI_Data->get(FTI_Data, &data, varId) != FTI_SCES) return NULL;
+    if (!data) {
+        snprintf(errstr, FTI_BUFS, "id '%d' does not exist!", varId);
+        FTI_Print(errstr, FTI_EROR);
+        return NULL;
+    }
+    if (*nbMaps == FTI_Exec->nbVar) {
+        return NULL;
+    }
+
+    FTIT_dcpBlockMap* map = &maps[(*nbMaps)++];
+    map->data = data;
+    map->nbBlocks = (data->size + blockSize - 1) / blockSize;
+    map->pos = talloc(int64_t, map->nbBlocks > 0 ? map->nbBlocks : 1);
+    map->size = talloc(uint32_t, map->nbBlocks > 0 ? map->nbBlocks : 1);
+    if (!map->pos || !map->size) {
+        FTI_Print("unable to allocate memory!", FTI_EROR);
+        map->nbBlocks = 0;
+        return NULL;
+    }
+    int64_t b;
+    for (b = 0; b < map->nbBlocks; b++) {
+        map->pos[b] = -1;
+    }
+    return map;
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It loads the checkpoint data for dcpPosix.
   @return     integer         FTI_SCES if successful.
 
-  dCP POSIX implementation of FTI_Recover().
+  dCP POSIX implementation of FTI_Recover(). The layers are scanned to
+  find the last copy of each block, then only those blocks are read,
+  concurrently.
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     FTIT_checkpoint* FTI_Ckpt, FTIT_keymap* FTI_Data) {
+    uint32_t version;
     uint32_t blockSize;
     unsigned int stackSize;
     int nbVarLayer;
@@ -411,8 +529,6 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     char errstr[FTI_BUFS];
     char fn[FTI_BUFS];
 
-    void* ptr;
-
     FTIT_dataset* data;
 
     snprintf(fn, FTI_BUFS, "%s/%s", FTI_Ckpt[FTI_Exec->ckptLvel].dcpDir,
@@ -420,14 +536,8 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     // read base part of file
     FILE* fd = fopen(fn, "rb");
-    fread(&blockSize, sizeof(uint32_t), 1, fd);
-    if (ferror(fd)) {
-        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-        FTI_Print(errstr, FTI_EROR);
-        return FTI_NSCS;
-    }
-    fread(&stackSize, sizeof(unsigned int), 1, fd);
-    if (ferror(fd)) {
+    if (fd == NULL ||
+     FTI_ReadDcpPosixHeader(fd, &version, &blockSize, &stackSize) == 0) {
         snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
         FTI_Print(errstr, FTI_EROR);
         return FTI_NSCS;
@@ -452,161 +562,132 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     }
 
 
-    void *buffer = malloc(blockSize);
-    if (!buffer) {
+    // locate the last copy of each block, layer 0 holds all the datasets
+    FTIT_dcpBlockMap* maps = talloc(FTIT_dcpBlockMap, FTI_Exec->nbVar);
+    if (!maps) {
         FTI_Print("unable to allocate memory!", FTI_EROR);
+        fclose(fd);
         return FTI_NSCS;
     }
+    int nbMaps = 0;
+    int res = FTI_SCES;
 
     int i;
-    // treat Layer 0 first
     fread(&ckptId, 1, sizeof(int), fd);
-    if (ferror(fd)) {
-        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-        FTI_Print(errstr, FTI_EROR);
-        return FTI_NSCS;
-    }
     fread(&nbVarLayer, 1, sizeof(int), fd);
-    if (ferror(fd)) {
-        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-        FTI_Print(errstr, FTI_EROR);
-        return FTI_NSCS;
+    if (ferror(fd) || feof(fd)) {
+        res = FTI_NSCS;
     }
-    for (i = 0; i < nbVarLayer; i++) {
+    for (i = 0; i < nbVarLayer && res == FTI_SCES; i++) {
         unsigned int varId;
-        uint32_t locDataSize;
+        uint64_t locDataSize;
         fread(&varId, sizeof(int), 1, fd);
-        if (ferror(fd)) {
-            snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
+        FTI_ReadDcpPosixDataSize(fd, version, &locDataSize);
+        if (ferror(fd) || feof(fd)) {
+            res = FTI_NSCS;
+            break;
         }
-        fread(&locDataSize, sizeof(uint32_t), 1, fd);
-        if (ferror(fd)) {
-            snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
+        FTIT_dcpBlockMap* map = FTI_DcpBlockMapGet(FTI_Exec, FTI_Data, maps,
+         &nbMaps, varId, blockSize);
+        if (!map) {
+            res = FTI_NSCS;
+            break;
         }
 
-        if (FTI_Data->get(&data, varId) != FTI_SCES) return FTI_NSCS;
-
-        if (!data) {
-            snprintf(errstr, FTI_BUFS, "id '%d' does not exist!", varId);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
+        int64_t base = ftello(fd);
+        uint64_t size = (locDataSize < map->data->size) ? locDataSize :
+         map->data->size;
+        int64_t b;
+        for (b = 0; b * blockSize < size; b++) {
+            uint64_t offset = b * blockSize;
+            map->pos[b] = base + offset;
+            map->size[b] = (size - offset < blockSize) ? size - offset :
+             blockSize;
         }
-#ifdef GPUSUPPORT
-        if (data->isDevicePtr) {
-            FTI_TransferFileToDeviceAsync(fd, data->devicePtr, data->size);
-        } else {
-            fread(data->ptr, locDataSize, 1, fd);
-            if (ferror(fd)) {
-                snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
-            }
-        }
-
-#else
-        fread(data->ptr, locDataSize, 1, fd);
-        if (ferror(fd)) {
-            snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
+        // the data of the layer is padded to a multiple of the block size
+        int64_t padded = ((locDataSize + blockSize - 1) / blockSize) *
+         blockSize;
+        if (fseeko(fd, base + padded, SEEK_SET) != 0) {
+            res = FTI_NSCS;
         }
-#endif
-        int overflow;
-        if ((overflow=locDataSize%blockSize) != 0) {
-            fread(buffer, blockSize - overflow, 1, fd);
-            if (ferror(fd)) {
-                snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
-            }
-        }
-    }
-
-
-    uint32_t offset;
-    blockMetaInfo_t blockMeta;
-    unsigned char *block = (unsigned char*) malloc(blockSize);
-    if (!block) {
-        FTI_Print("unable to allocate memory!", FTI_EROR);
-        return FTI_NSCS;
     }
 
+    // the next layers hold the blocks that changed
     int nbLayer = FTI_Exec->dcpInfoPosix.nbLayerReco;
-
-
-    for (i = 1; i < nbLayer; i++) {
-        uint32_t pos = 0;
+    for (i = 1; i < nbLayer && res == FTI_SCES; i++) {
+        uint64_t pos = 0;
         pos += fread(&ckptId, 1, sizeof(int), fd);
-        if (ferror(fd)) {
-            snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
-        }
         pos += fread(&nbVarLayer, 1, sizeof(int), fd);
-        if (ferror(fd)) {
-            snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-            FTI_Print(errstr, FTI_EROR);
-            return FTI_NSCS;
+        if (ferror(fd) || feof(fd)) {
+            res = FTI_NSCS;
+            break;
         }
 
+        int64_t cur = ftello(fd);
         while (pos < FTI_Exec->dcpInfoPosix.LayerSize[i]) {
+            blockMetaInfo_t blockMeta = {0};
             fread(&blockMeta, 1, 6, fd);
-            if (ferror(fd)) {
-                snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
+            if (ferror(fd) || feof(fd)) {
+                res = FTI_NSCS;
+                break;
             }
-
-            if (FTI_Data->get(&data, blockMeta.varId) != FTI_SCES)
-                return FTI_NSCS;
-
-            if (!data) {
-                snprintf(errstr, FTI_BUFS, "id '%d' does not exist!",
-                 blockMeta.varId);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
+            FTIT_dcpBlockMap* map = FTI_DcpBlockMapGet(FTI_Exec, FTI_Data,
+             maps, &nbMaps, blockMeta.varId, blockSize);
+            if (!map) {
+                res = FTI_NSCS;
+                break;
             }
 
-            offset = blockMeta.blockId * blockSize;
-            unsigned int chunkSize = ((data->size-offset) < blockSize) ?
-             data->size-offset : blockSize;
-
-#ifdef GPUSUPPORT
-            if (data->isDevicePtr) {
-                FTI_device_sync();
-                fread(block, 1, chunkSize, fd);
-                FTI_copy_to_device_async(data->devicePtr + offset, block,
-                 chunkSize);
-            } else {
-                ptr = data->ptr + offset;
-                fread(ptr, 1, chunkSize, fd);
-            }
-#else
-            ptr = data->ptr + offset;
-            fread(ptr, 1, chunkSize, fd);
-#endif
-            if (ferror(fd)) {
-                snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
-            }
-            fread(buffer, 1, blockSize - chunkSize, fd);
-            if (ferror(fd)) {
-                snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-                FTI_Print(errstr, FTI_EROR);
-                return FTI_NSCS;
+            // blocks beyond the current size of the dataset are stale
+            if (blockMeta.blockId < map->nbBlocks) {
+                uint64_t offset = (uint64_t) blockMeta.blockId * blockSize;
+                map->pos[blockMeta.blockId] = cur + 6;
+                map->size[blockMeta.blockId] =
+                 (map->data->size - offset < blockSize) ?
+                 map->data->size - offset : blockSize;
             }
 
+            cur += blockSize + 6;
+            if (fseeko(fd, cur, SEEK_SET) != 0) {
+                res = FTI_NSCS;
+                break;
+            }
             pos += (blockSize+6);
         }
     }
 
+    // read the blocks concurrently, contiguous blocks are merged
+    FTIT_readPlan plan;
+    FTI_ReadPlanInit(&plan);
+    for (i = 0; i < nbMaps && res == FTI_SCES; i++) {
+        int64_t b;
+        for (b = 0; b < maps[i].nbBlocks && res == FTI_SCES; b++) {
+            if (maps[i].pos[b] >= 0) {
+                res = FTI_ReadPlanAdd(&plan, maps[i].data, maps[i].pos[b],
+                 b * blockSize, maps[i].size[b]);
+            }
+        }
+    }
+    if (res == FTI_SCES) {
+        res = FTI_ReadPlanRun(FTI_Conf, &plan, fileno(fd));
+    } else {
+        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
+        FTI_Print(errstr, FTI_EROR);
+    }
+    FTI_ReadPlanFree(&plan);
+    for (i = 0; i < nbMaps; i++) {
+        free(maps[i].pos);
+        free(maps[i].size);
+    }
+    free(maps);
+    fclose(fd);
+    if (res != FTI_SCES) {
+        return FTI_NSCS;
+    }
+
     // create hasharray
-    if ((FTI_Data->data(&data, FTI_Exec->nbVarStored) != FTI_SCES) || !data)
+    if ((FTI_Data->data(FTI_Data, &data,
+     FTI_Exec->nbVarStored) != FTI_SCES) || !data)
         return FTI_NSCS;
 
     for (i = 0; i < FTI_Exec->nbVarStored; i++) {
@@ -635,7 +716,7 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             return FTI_NSCS;
         }
 
-        uint32_t nbBlocks = (data[i].size % blockSize) ?
+        uint64_t nbBlocks = (data[i].size % blockSize) ?
          data[i].size/blockSize + 1 : data[i].size/blockSize;
         data[i].dcpInfoPosix.hashDataSize = data[i].size;
         int j = 0;
@@ -645,7 +726,7 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
               totalBytes/blockSize + 1 : totalBytes/blockSize;
             int k;
             for (k = 0 ; k < currentBlocks && j < nbBlocks-1; k++) {
-                uint32_t hashIdx = j*MD5_DIGEST_LENGTH;
+                uint64_t hashIdx = (uint64_t) j*MD5_DIGEST_LENGTH;
                 FTI_Conf->dcpInfoPosix.hashFunc(ptr, blockSize,
                  &data[i].dcpInfoPosix.oldHashArray[hashIdx]);
                 ptr = ptr+blockSize;
@@ -664,8 +745,8 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 FTI_Print("unable to allocate memory!", FTI_EROR);
                 return FTI_NSCS;
             }
-            uint32_t dataOffset = blockSize * (nbBlocks - 1);
-            uint32_t dataSize = data[i].size - dataOffset;
+            uint64_t dataOffset = blockSize * (nbBlocks - 1);
+            uint64_t dataSize = data[i].size - dataOffset;
             memcpy(buffer, ptr, dataSize);
             FTI_Conf->dcpInfoPosix.hashFunc(buffer, blockSize,
             &data[i].dcpInfoPosix.oldHashArray[(nbBlocks-1)*MD5_DIGEST_LENGTH]);
@@ -675,9 +756,6 @@ int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     FTI_Exec->reco = 0;
 
-    free(buffer);
-    fclose(fd);
-
     return FTI_SCES;
 }
 
@@ -696,6 +774,7 @@ int FTI_RecoverVarDcpPosixFinalize() { /*TODO*/ return FTI_SCES; }
 int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
     FTIT_execution* FTI_Exec, FTIT_checkpoint* FTI_Ckpt, FTIT_keymap* FTI_Data,
     int id) {
+    uint32_t version;
     uint32_t blockSize;
     unsigned int stackSize;
     int nbVarLayer;
@@ -711,14 +790,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
 
     // read base part of file
     FILE* fd = fopen(fn, "rb");
-    fread(&blockSize, sizeof(uint32_t), 1, fd);
-    if (ferror(fd)) {
-        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
-        FTI_Print(errstr, FTI_EROR);
-        return FTI_NSCS;
-    }
-    fread(&stackSize, sizeof(unsigned int), 1, fd);
-    if (ferror(fd)) {
+    if (FTI_ReadDcpPosixHeader(fd, &version, &blockSize, &stackSize) == 0) {
         snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
         FTI_Print(errstr, FTI_EROR);
         return FTI_NSCS;
@@ -766,14 +838,14 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
     }
     for (i = 0; i < nbVarLayer; i++) {
         unsigned int varId;
-        uint32_t locDataSize;
+        uint64_t locDataSize;
         fread(&varId, sizeof(int), 1, fd);
         if (ferror(fd)) {
             snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
             FTI_Print(errstr, FTI_EROR);
             return FTI_NSCS;
         }
-        fread(&locDataSize, sizeof(uint32_t), 1, fd);
+        FTI_ReadDcpPosixDataSize(fd, version, &locDataSize);
         if (ferror(fd)) {
             snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
             FTI_Print(errstr, FTI_EROR);
@@ -781,7 +853,8 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
         }
         // if requested id load else skip dataSize
         if (varId == id) {
-            if (FTI_Data->get(&data, varId) != FTI_SCES) return FTI_NSCS;
+            if (FTI_Data->get(FTI_Data, &data, varId) != FTI_SCES)
+                return FTI_NSCS;
 
             if (!data) {
                 snprintf(errstr, FTI_BUFS, "id '%d' does not exist!", varId);
@@ -806,9 +879,9 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
                 }
             }
         } else {
-            uint32_t skip = (locDataSize%blockSize == 0) ?
+            uint64_t skip = (locDataSize%blockSize == 0) ?
              locDataSize : (locDataSize/blockSize + 1)*blockSize;
-            if (fseek(fd, skip, SEEK_CUR) == -1) {
+            if (fseeko(fd, skip, SEEK_CUR) == -1) {
                 snprintf(errstr, FTI_BUFS, "unable to seek in file %s", fn);
                 FTI_Print(errstr, FTI_EROR);
                 return FTI_NSCS;
@@ -817,7 +890,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
     }
 
 
-    uint32_t offset;
+    uint64_t offset;
 
     blockMetaInfo_t blockMeta;
     unsigned char *block = (unsigned char*) malloc(blockSize);
@@ -828,7 +901,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
 
     int nbLayer = FTI_Exec->dcpInfoPosix.nbLayerReco;
     for (i = 1; i < nbLayer; i++) {
-        uint32_t pos = 0;
+        uint64_t pos = 0;
         pos += fread(&ckptId, 1, sizeof(int), fd);
         if (ferror(fd)) {
             snprintf(errstr, FTI_BUFS, "unable to read in file %s", fn);
@@ -850,7 +923,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
                 return FTI_NSCS;
             }
             if (blockMeta.varId == id) {
-                if (FTI_Data->get(&data, blockMeta.varId) != FTI_SCES)
+                if (FTI_Data->get(FTI_Data, &data, blockMeta.varId) != FTI_SCES)
                     return FTI_NSCS;
 
                 if (!data) {
@@ -860,7 +933,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
                     return FTI_NSCS;
                 }
 
-                offset = blockMeta.blockId * blockSize;
+                offset = (uint64_t) blockMeta.blockId * blockSize;
                 void* ptr = data->ptr + offset;
                 unsigned int chunkSize = ((data->size-offset) < blockSize) ?
                  data->size-offset : blockSize;
@@ -889,7 +962,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
         }
     }
 
-    if (FTI_Data->get(&data, id) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) return FTI_NSCS;
 
     if (!data) {
         snprintf(errstr, FTI_BUFS, "id '%d' does not exist!", blockMeta.varId);
@@ -921,7 +994,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
         return FTI_NSCS;
     }
 
-    uint32_t nbBlocks = (data->size % blockSize) ?
+    uint64_t nbBlocks = (data->size % blockSize) ?
      data->size/blockSize + 1 : data->size/blockSize;
     data->dcpInfoPosix.hashDataSize = data->size;
     int j = 0;
@@ -931,7 +1004,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
           totalBytes/blockSize + 1 : totalBytes/blockSize;
         int k;
         for (k = 0 ; k < currentBlocks && j < nbBlocks-1; k++) {
-            uint32_t hashIdx = j*MD5_DIGEST_LENGTH;
+            uint64_t hashIdx = (uint64_t) j*MD5_DIGEST_LENGTH;
             FTI_Conf->dcpInfoPosix.hashFunc(ptr, blockSize,
              &data->dcpInfoPosix.oldHashArray[hashIdx]);
             ptr = ptr+blockSize;
@@ -949,8 +1022,8 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
             FTI_Print("unable to allocate memory!", FTI_EROR);
             return FTI_NSCS;
         }
-        uint32_t dataOffset = blockSize * (nbBlocks - 1);
-        uint32_t dataSize = data->size - dataOffset;
+        uint64_t dataOffset = blockSize * (nbBlocks - 1);
+        uint64_t dataSize = data->size - dataOffset;
         memcpy(buffer, ptr, dataSize);
         FTI_Conf->dcpInfoPosix.hashFunc(buffer, blockSize,
          &data->dcpInfoPosix.oldHashArray[(nbBlocks-1)*MD5_DIGEST_LENGTH]);
@@ -999,7 +1072,7 @@ int FTI_RecoverVarDcpPosix(FTIT_configuration* FTI_Conf,
   dCP POSIX implementation of FTI_CheckFile().
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_CheckFileDcpPosix(char* fn, int32_t fs, char* checksum) {
+int FTI_CheckFileDcpPosix(char* fn, int64_t fs, char* checksum) {
     if (access(fn, F_OK) == 0) {
         struct stat fileStatus;
         if (stat(fn, &fileStatus) == 0) {
@@ -1043,6 +1116,7 @@ int FTI_VerifyChecksumDcpPosix(char* fileName) {
     int *ckptIds  = NULL;
     char errstr[FTI_BUFS];
     char dummyBuffer[FTI_BUFS];
+    uint32_t version;
     uint32_t blockSize;
     unsigned int stackSize;
     unsigned int counter = 0;
@@ -1067,19 +1141,15 @@ int FTI_VerifyChecksumDcpPosix(char* fileName) {
     // position in file
     size_t fs = 0;
 
-    // get blocksize
-    fs += fread(&blockSize, 1, sizeof(uint32_t), fd);
-    if (ferror(fd)) {
-        snprintf(errstr, FTI_BUFS, "unable to read in file %s", fileName);
-        FTI_Print(errstr, FTI_EROR);
-        goto FINALIZE;
-    }
-    fs += fread(&stackSize, 1, sizeof(unsigned int), fd);
-    if (ferror(fd)) {
+    // get format version, blocksize and stacksize
+    size_t hdrSize = FTI_ReadDcpPosixHeader(fd, &version, &blockSize,
+     &stackSize);
+    if (hdrSize == 0) {
         snprintf(errstr, FTI_BUFS, "unable to read in file %s", fileName);
         FTI_Print(errstr, FTI_EROR);
         goto FINALIZE;
     }
+    fs += hdrSize;
 
     // check if settings are correckt. If not correct them
     if (blockSize != conf->dcpInfoPosix.BlockSize) {
@@ -1135,15 +1205,15 @@ int FTI_VerifyChecksumDcpPosix(char* fileName) {
         goto FINALIZE;
     }
     for (i = 0; i < nbVarLayer; i++) {
-        uint32_t dataSize;
-        uint32_t pos = 0;
+        uint64_t dataSize;
+        uint64_t pos = 0;
         fs += fread(dummyBuffer, 1, sizeof(int), fd);
         if (ferror(fd)|| feof(fd)) {
             snprintf(errstr, FTI_BUFS, "unable to read in file %s", fileName);
             FTI_Print(errstr, FTI_EROR);
             goto FINALIZE;
         }
-        fs += fread(&dataSize, 1, sizeof(uint32_t), fd);
+        fs += FTI_ReadDcpPosixDataSize(fd, version, &dataSize);
         if (ferror(fd)|| feof(fd)) {
             snprintf(errstr, FTI_BUFS, "unable to read in file %s", fileName);
             FTI_Print(errstr, FTI_EROR);
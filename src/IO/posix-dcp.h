@@ -18,11 +18,16 @@
 #define MAX_BLOCK_IDX 0x3fffffff
 #define MAX_VAR_ID 0x3ffff
 
+// dCP file format, version 1 files have no header and 32 bit dataset sizes
+#define DCP_POSIX_MAGIC "FDCP"
+#define DCP_POSIX_VERSION_LEGACY 1
+#define DCP_POSIX_VERSION 2
+
 #define DCP_POSIX_EXEC_TAG 0
 #define DCP_POSIX_CONF_TAG 1
 #define DCP_POSIX_INIT_TAG -1
 
-int FTI_CheckFileDcpPosix(char* fn, int32_t fs, char* checksum);
+int FTI_CheckFileDcpPosix(char* fn, int64_t fs, char* checksum);
 int FTI_VerifyChecksumDcpPosix(char* fileName);
 void* FTI_DcpPosixRecoverRuntimeInfo(int tag, void* exec_, void* conf_);
 int FTI_RecoverDcpPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
@@ -146,6 +146,62 @@ int FTI_PosixWrite(void *src, size_t size, void *fileDesc) {
     }
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes to the file at a given offset without hashing
+  @param      src               pointer pointing to the data to be stored
+  @param      size              size of the data to be written
+  @param      offset            file offset to write the data at
+  @param      fileDesc          The fileDescriptor
+  @return     integer         Return FTI_SCES  when successfuly write the data to the file
+
+  Positional write used by the pipelined writer. It may be called
+  concurrently from several threads and leaves the stream position and
+  the integrity context untouched. The caller has to flush the stream
+  (FTI_PosixSeek) before mixing it with FTI_PosixWrite.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_PosixWriteAt(void *src, size_t size, size_t offset, void *fileDesc) {
+    WritePosixInfo_t *fd = (WritePosixInfo_t *)fileDesc;
+    int fdesc = fileno(fd->f);
+    size_t written = 0;
+
+    while (written < size) {
+        ssize_t ret = pwrite(fdesc, ((char *)src) + written, size - written,
+         offset + written);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            char str[FTI_BUFS], error_msg[FTI_BUFS];
+            error_msg[0] = 0;
+            strerror_r(errno, error_msg, FTI_BUFS);
+            snprintf(str, FTI_BUFS, "Unable to write : [POSIX ERROR - %s.]",
+             error_msg);
+            FTI_Print(str, FTI_EROR);
+            return FTI_NSCS;
+        }
+        written += ret;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Adds a block of data to the file checksum
+  @param      src               pointer to the data written to the file
+  @param      size              size of the data
+  @param      fileDesc          The fileDescriptor
+  @return     void.
+
+  Blocks have to be passed in file order.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_PosixUpdateMD5(void *src, size_t size, void *fileDesc) {
+    WritePosixInfo_t *fd = (WritePosixInfo_t *)fileDesc;
+    MD5_Update(&(fd->integrity), src, size);
+}
+
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -347,27 +403,26 @@ int FTI_RecoverVarPOSIX(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     FTIT_dataset* data;
 
-    if ((FTI_Data->get(&data, id) != FTI_SCES)) {
+    if ((FTI_Data->get(FTI_Data, &data, id) != FTI_SCES)) {
         FTI_Print("failed to recover variable.", FTI_EROR);
         return FTI_NREC;
     }
 
     if (data->size != data->sizeStored) {
-        snprintf(str, sizeof(str), "Cannot recover %d bytes to protected "
-        "variable (ID %d) size: %d", data->sizeStored, data->id, data->size);
+        snprintf(str, sizeof(str), "Cannot recover %ld bytes to protected "
+        "variable (ID %d) size: %ld", data->sizeStored, data->id, data->size);
         FTI_Print(str, FTI_WARN);
         return FTI_NREC;
     }
 
-    int32_t filePos = data->filePos;
-    if (fseek(fileposix, filePos, SEEK_SET) == 0) {
-        fread(data->ptr, 1, data->size, fileposix);
-        if (ferror(fileposix)) {
-            FTI_Print("Could not read FTI checkpoint file.", FTI_EROR);
-        } else {
-            res = FTI_SCES;
-        }
+    // large variables are read by several threads
+    FTIT_readPlan plan;
+    FTI_ReadPlanInit(&plan);
+    res = FTI_ReadPlanAddDataset(&plan, data);
+    if (res == FTI_SCES) {
+        res = FTI_ReadPlanRun(FTI_Conf, &plan, fileno(fileposix));
     }
+    FTI_ReadPlanFree(&plan);
     return res;
 }
 
@@ -25,6 +25,8 @@ int FTI_PosixRead(void *dest, size_t size, void *fileDesc);
 size_t FTI_GetPosixFilePos(void *fileDesc);
 int FTI_PosixSeek(size_t pos, void *fileDesc);
 int FTI_PosixWrite(void *src, size_t size, void *fileDesc);
+int FTI_PosixWriteAt(void *src, size_t size, size_t offset, void *fileDesc);
+void FTI_PosixUpdateMD5(void *src, size_t size, void *fileDesc);
 int FTI_PosixClose(void *fileDesc);
 int FTI_PosixOpen(char *fn, void *fileDesc);
 int FTI_RecoverVarInitPOSIX(char* fn);
@@ -0,0 +1,330 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   reader.c
+ *  @date   October, 2026
+ *  @brief  Concurrent reads of the checkpoint data at recovery.
+ *
+ *  The recovery first builds a read plan: the list of extents of the
+ *  checkpoint file that land in each protected buffer, as described by the
+ *  metadata. Contiguous extents are merged and large ones are split, then
+ *  the extents are read with pread(2) by 'read_threads' threads directly
+ *  into the protected buffers. Encoded datasets are decoded by a single
+ *  task each.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../interface.h"
+#include "reader.h"
+
+/** Initial number of extents of a plan **/
+#define FTI_READ_PLAN_INIT 64
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads a region of a file.
+  @param      fd              File descriptor.
+  @param      buf             Destination buffer.
+  @param      size            Number of bytes to read.
+  @param      pos             Offset of the region in the file.
+  @return     integer         FTI_SCES if successful.
+
+  Short reads are resumed, reaching the end of the file is an error.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ReadAt(int fd, void* buf, int64_t size, int64_t pos) {
+    char* ptr = (char*) buf;
+    while (size > 0) {
+        size_t count = (size < FTI_READ_EXTENT_SIZE) ? size :
+         FTI_READ_EXTENT_SIZE;
+        ssize_t bytes = pread(fd, ptr, count, pos);
+        if (bytes == -1 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return FTI_NSCS;
+        }
+        ptr += bytes;
+        pos += bytes;
+        size -= bytes;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Initializes an empty read plan.
+  @param      plan            Read plan.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_ReadPlanInit(FTIT_readPlan* plan) {
+    plan->extents = NULL;
+    plan->nbExtents = 0;
+    plan->capacity = 0;
+}
+
+/* Appends an extent to the plan, growing it if needed. */
+static FTIT_readExtent* FTI_ReadPlanPush(FTIT_readPlan* plan) {
+    if (plan->nbExtents == plan->capacity) {
+        int capacity = (plan->capacity > 0) ? 2 * plan->capacity :
+         FTI_READ_PLAN_INIT;
+        FTIT_readExtent* extents = (FTIT_readExtent*) realloc(plan->extents,
+         capacity * sizeof(FTIT_readExtent));
+        if (extents == NULL) {
+            return NULL;
+        }
+        plan->extents = extents;
+        plan->capacity = capacity;
+    }
+    FTIT_readExtent* ext = &plan->extents[plan->nbExtents++];
+    ext->status = FTI_NSCS;
+    return ext;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Adds raw bytes of a dataset to the read plan.
+  @param      plan            Read plan.
+  @param      data            Destination dataset.
+  @param      filePos         Offset of the bytes in the checkpoint file.
+  @param      offset          Offset of the bytes in the dataset.
+  @param      size            Number of bytes.
+  @return     integer         FTI_SCES if successful.
+
+  The bytes are merged with the last extent of the plan when both are
+  contiguous in the file and in the dataset, and the result is split in
+  extents of at most FTI_READ_EXTENT_SIZE bytes.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ReadPlanAdd(FTIT_readPlan* plan, FTIT_dataset* data, int64_t filePos,
+ int64_t offset, int64_t size) {
+    while (size > 0) {
+        FTIT_readExtent* ext = (plan->nbExtents > 0) ?
+         &plan->extents[plan->nbExtents - 1] : NULL;
+        int64_t len;
+        if (ext != NULL && ext->data == data &&
+         ext->filePos + ext->size == filePos &&
+         ext->offset + ext->size == offset &&
+         ext->size < FTI_READ_EXTENT_SIZE) {
+            len = FTI_READ_EXTENT_SIZE - ext->size;
+            len = (size < len) ? size : len;
+            ext->size += len;
+        } else {
+            ext = FTI_ReadPlanPush(plan);
+            if (ext == NULL) {
+                FTI_Print("Unable to allocate the read plan.", FTI_EROR);
+                return FTI_NSCS;
+            }
+            len = (size < FTI_READ_EXTENT_SIZE) ? size : FTI_READ_EXTENT_SIZE;
+            ext->data = data;
+            ext->filePos = filePos;
+            ext->offset = offset;
+            ext->size = len;
+        }
+        filePos += len;
+        offset += len;
+        size -= len;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Adds a dataset of a checkpoint file to the read plan.
+  @param      plan            Read plan.
+  @param      data            Dataset, located by 'filePos' and 'sizeStored'.
+  @return     integer         FTI_SCES if successful.
+
+  An encoded dataset is decoded by a single task, it is not split.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ReadPlanAddDataset(FTIT_readPlan* plan, FTIT_dataset* data) {
+    if (data->codec == FTI_CODEC_NONE) {
+        return FTI_ReadPlanAdd(plan, data, data->filePos, 0,
+         data->sizeStored);
+    }
+    FTIT_readExtent* ext = FTI_ReadPlanPush(plan);
+    if (ext == NULL) {
+        FTI_Print("Unable to allocate the read plan.", FTI_EROR);
+        return FTI_NSCS;
+    }
+    ext->data = data;
+    ext->filePos = data->filePos;
+    ext->offset = 0;
+    ext->size = data->sizeStored;
+    return FTI_SCES;
+}
+
+/** Read plan executed by one FTI_ReadPlanRun call **/
+typedef struct FTIT_readJob {
+    FTIT_readPlan*      plan;
+    int                 fd;
+} FTIT_readJob;
+
+static void FTI_ReadTask(void* arg, int idx) {
+    FTIT_readJob* job = (FTIT_readJob*) arg;
+    FTIT_readExtent* ext = &job->plan->extents[idx];
+    FTIT_dataset* data = ext->data;
+
+    if (data->codec != FTI_CODEC_NONE) {
+        ext->status = FTI_CodecRead(data, job->fd, ext->filePos);
+        return;
+    }
+#ifdef GPUSUPPORT
+    if (data->isDevicePtr) {
+        char* buf = talloc(char, ext->size);
+        if (buf == NULL) {
+            ext->status = FTI_NSCS;
+            return;
+        }
+        ext->status = FTI_ReadAt(job->fd, buf, ext->size, ext->filePos);
+        if (ext->status == FTI_SCES) {
+            ext->status = FTI_copy_to_device((char*) data->devicePtr +
+             ext->offset, buf, ext->size, NULL);
+        }
+        free(buf);
+        return;
+    }
+#endif
+    ext->status = FTI_ReadAt(job->fd, (char*) data->ptr + ext->offset,
+     ext->size, ext->filePos);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Performs the reads of a plan.
+  @param      FTI_Conf        Configuration metadata.
+  @param      plan            Read plan.
+  @param      fd              Checkpoint file, opened for reading.
+  @return     integer         FTI_SCES if all the reads succeeded.
+
+  The extents are distributed among at most 'read_threads' threads. The
+  extents of a plan must not overlap in the datasets.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ReadPlanRun(FTIT_configuration* FTI_Conf, FTIT_readPlan* plan,
+ int fd) {
+    if (plan->nbExtents == 0) {
+        return FTI_SCES;
+    }
+
+    FTIT_readJob job;
+    job.plan = plan;
+    job.fd = fd;
+
+    int nbThreads = (FTI_Conf->readThreads < plan->nbExtents) ?
+     FTI_Conf->readThreads : plan->nbExtents;
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, nbThreads);
+    FTI_ThreadPoolRun(&pool, plan->nbExtents, FTI_ReadTask, &job);
+    FTI_ThreadPoolFinalize(&pool);
+
+    int i;
+    for (i = 0; i < plan->nbExtents; i++) {
+        if (plan->extents[i].status != FTI_SCES) {
+            char str[FTI_BUFS];
+            snprintf(str, FTI_BUFS, "Could not read %ld bytes of dataset #%d"
+             " at offset %ld of the checkpoint file.", plan->extents[i].size,
+             plan->extents[i].data->id, plan->extents[i].filePos);
+            FTI_Print(str, FTI_EROR);
+            return FTI_NSCS;
+        }
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Releases a read plan.
+  @param      plan            Read plan.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_ReadPlanFree(FTIT_readPlan* plan) {
+    free(plan->extents);
+    FTI_ReadPlanInit(plan);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads datasets from a checkpoint file.
+  @param      FTI_Conf        Configuration metadata.
+  @param      fn              Path of the checkpoint file.
+  @param      data            Datasets to recover.
+  @param      nbVar           Number of datasets.
+  @return     integer         FTI_SCES if successful.
+
+  The datasets are located in the file by 'filePos' and 'sizeStored'.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ReadDatasets(FTIT_configuration* FTI_Conf, char* fn,
+ FTIT_dataset* data, int nbVar) {
+    char str[FTI_BUFS];
+
+    int fd = open(fn, O_RDONLY);
+    if (fd == -1) {
+        snprintf(str, FTI_BUFS, "Could not open FTI checkpoint file. (%s)...",
+         fn);
+        FTI_Print(str, FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    FTIT_readPlan plan;
+    FTI_ReadPlanInit(&plan);
+    int res = FTI_SCES;
+    int i;
+    for (i = 0; i < nbVar && res == FTI_SCES; i++) {
+        res = FTI_ReadPlanAddDataset(&plan, &data[i]);
+    }
+    if (res == FTI_SCES) {
+        snprintf(str, FTI_BUFS, "Reading %d datasets from %s in %d extents.",
+         nbVar, fn, plan.nbExtents);
+        FTI_Print(str, FTI_DBUG);
+        res = FTI_ReadPlanRun(FTI_Conf, &plan, fd);
+    }
+    FTI_ReadPlanFree(&plan);
+
+    if (close(fd) != 0 && res == FTI_SCES) {
+        FTI_Print("Could not close FTI checkpoint file.", FTI_EROR);
+        res = FTI_NSCS;
+    }
+    return res;
+}
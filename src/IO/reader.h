@@ -0,0 +1,48 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   reader.h
+ */
+
+#ifndef FTI_SRC_IO_READER_H_
+#define FTI_SRC_IO_READER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest number of bytes read by one task **/
+#define FTI_READ_EXTENT_SIZE (16 * 1024 * 1024)
+
+/** Bytes of a checkpoint file copied into a dataset **/
+typedef struct FTIT_readExtent {
+    FTIT_dataset*   data;       /**< Destination dataset                  */
+    int64_t         filePos;    /**< Offset in the checkpoint file        */
+    int64_t         offset;     /**< Offset in the dataset buffer         */
+    int64_t         size;       /**< Number of bytes                      */
+    int             status;     /**< FTI_SCES once the read succeeded     */
+} FTIT_readExtent;
+
+/** Reads performed by one recovery **/
+typedef struct FTIT_readPlan {
+    FTIT_readExtent*    extents;
+    int                 nbExtents;
+    int                 capacity;
+} FTIT_readPlan;
+
+int FTI_ReadAt(int fd, void* buf, int64_t size, int64_t pos);
+void FTI_ReadPlanInit(FTIT_readPlan* plan);
+int FTI_ReadPlanAdd(FTIT_readPlan* plan, FTIT_dataset* data, int64_t filePos,
+ int64_t offset, int64_t size);
+int FTI_ReadPlanAddDataset(FTIT_readPlan* plan, FTIT_dataset* data);
+int FTI_ReadPlanRun(FTIT_configuration* FTI_Conf, FTIT_readPlan* plan,
+ int fd);
+void FTI_ReadPlanFree(FTIT_readPlan* plan);
+int FTI_ReadDatasets(FTIT_configuration* FTI_Conf, char* fn,
+ FTIT_dataset* data, int nbVar);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // FTI_SRC_IO_READER_H_
@@ -0,0 +1,307 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   transfer.c
+ *  @date   October, 2026
+ *  @brief  File copies between the local storage and the PFS.
+ *
+ *  Used by the L4 flush and the L4 recovery. Each file is copied in large
+ *  extents, preferably inside the kernel:
+ *
+ *  - copy_file_range(2), which may be offloaded to the file system,
+ *  - sendfile(2), when the files are not on compatible file systems,
+ *  - read(2)/write(2) through a 'transfer_size' buffer otherwise.
+ *
+ *  A method reported as unsupported for the pair of files is dropped and
+ *  the copy continues with the next one from the current file offsets.
+ *  Blocks marked in 'skip' (see dedup.c) are not copied but left as holes.
+ *  Several files are copied concurrently by 'transfer_threads' threads.
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif
+
+#include "../interface.h"
+#include "transfer.h"
+
+/** Largest extent handed to the kernel in one call **/
+#define FTI_XFER_MAX_EXTENT (1024 * 1024 * 1024)
+
+/** Copy methods, in the order in which they are tried **/
+enum {
+    FTI_XFER_RANGE = 0,
+    FTI_XFER_SENDFILE,
+    FTI_XFER_STREAM
+};
+
+static const char* FTI_XferNames[] = {
+    "copy_file_range", "sendfile", "read/write"
+};
+
+/** Files copied by one FTI_TransferFiles call **/
+typedef struct FTIT_transferBatch {
+    FTIT_configuration* FTI_Conf;
+    FTIT_transfer*      jobs;
+} FTIT_transferBatch;
+
+/* TRUE if errno tells that the method cannot copy between these files. */
+static bool FTI_TransferUnsupported(int err) {
+    return err == ENOSYS || err == EXDEV || err == EINVAL ||
+     err == EOPNOTSUPP || err == ENOTSUP;
+}
+
+/* Copies at most 'count' bytes at the current offsets of the files. */
+static ssize_t FTI_TransferExtent(int method, int in, int out, char* buf,
+ size_t count) {
+    switch (method) {
+        case FTI_XFER_RANGE:
+#ifdef HAVE_COPY_FILE_RANGE
+            return copy_file_range(in, NULL, out, NULL, count, 0);
+#else
+            errno = ENOSYS;
+            return -1;
+#endif
+        case FTI_XFER_SENDFILE:
+#ifdef HAVE_SENDFILE
+            return sendfile(out, in, NULL, count);
+#else
+            errno = ENOSYS;
+            return -1;
+#endif
+        default: {
+            ssize_t bytes = read(in, buf, count);
+            ssize_t done = 0;
+            while (done < bytes) {
+                ssize_t res = write(out, buf + done, bytes - done);
+                if (res == -1) {
+                    if (errno == EINTR) continue;
+                    return -1;
+                }
+                done += res;
+            }
+            return bytes;
+        }
+    }
+}
+
+/* Moves 'pos' past the blocks to skip and sets 'end' to the end of the
+   run of blocks to copy that follows. */
+static size_t FTI_TransferSkip(FTIT_transfer* job, size_t pos, size_t* end) {
+    *end = job->fs;
+    if (job->skip == NULL) {
+        return pos;
+    }
+    size_t bs = job->blockSize;
+    size_t nbBlocks = (job->fs + bs - 1) / bs;
+    size_t block = pos / bs;
+    if (job->skip[block]) {
+        while (block < nbBlocks && job->skip[block]) {
+            block++;
+        }
+        pos = (block * bs < job->fs) ? block * bs : job->fs;
+    }
+    while (block < nbBlocks && !job->skip[block]) {
+        block++;
+    }
+    if (block * bs < job->fs) {
+        *end = block * bs;
+    }
+    return pos;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Copies a file with the fastest method available.
+  @param      FTI_Conf        Configuration metadata.
+  @param      job             Source, destination and size of the copy.
+  @return     integer         FTI_SCES if successful.
+
+  The first 'job->fs' bytes of 'job->src' are copied into 'job->dst',
+  which is created or truncated. The blocks marked in 'job->skip' are
+  not copied, the copy keeps the size of the file with holes instead.
+  The result is also stored in 'job->status'.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_TransferFile(FTIT_configuration* FTI_Conf, FTIT_transfer* job) {
+    char str[FTI_BUFS];
+    job->status = FTI_NSCS;
+
+    int in = open(job->src, O_RDONLY);
+    if (in == -1) {
+        snprintf(str, FTI_BUFS, "unable to open '%s' for reading (%s).",
+         job->src, strerror(errno));
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+    int out = open(job->dst, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (out == -1) {
+        snprintf(str, FTI_BUFS, "unable to open '%s' for writing (%s).",
+         job->dst, strerror(errno));
+        FTI_Print(str, FTI_WARN);
+        close(in);
+        return FTI_NSCS;
+    }
+
+    if (FTI_Conf->transferFadvise) {
+        posix_fadvise(in, 0, job->fs, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(in, 0, job->fs, POSIX_FADV_WILLNEED);
+    }
+
+    int method = (FTI_Conf->transferZeroCopy) ? FTI_XFER_RANGE :
+     FTI_XFER_STREAM;
+    char* buf = NULL;
+    size_t pos = 0;
+    while (pos < job->fs) {
+        size_t end;
+        size_t next = FTI_TransferSkip(job, pos, &end);
+        if (next != pos) {
+            pos = next;
+            if (pos == job->fs) {
+                break;
+            }
+            if (lseek(in, pos, SEEK_SET) == -1 ||
+             lseek(out, pos, SEEK_SET) == -1) {
+                snprintf(str, FTI_BUFS, "unable to seek in '%s' (%s).",
+                 job->src, strerror(errno));
+                FTI_Print(str, FTI_WARN);
+                goto end;
+            }
+        }
+        // The in-kernel methods do not need a bounce buffer
+        size_t extent = FTI_XFER_MAX_EXTENT;
+        if (method == FTI_XFER_STREAM) {
+            extent = FTI_Conf->transferSize;
+            if (buf == NULL) {
+                buf = talloc(char, extent);
+            }
+        }
+        size_t count = (end - pos < extent) ? end - pos : extent;
+        ssize_t bytes = FTI_TransferExtent(method, in, out, buf, count);
+        if (bytes == -1 && errno == EINTR) {
+            continue;
+        }
+        // Some file systems report 0 bytes instead of an error
+        if (method != FTI_XFER_STREAM && (bytes == 0 ||
+         (bytes == -1 && FTI_TransferUnsupported(errno)))) {
+            method++;
+            continue;
+        }
+        if (bytes <= 0) {
+            if (bytes == 0) {
+                snprintf(str, FTI_BUFS, "'%s' is shorter than expected"
+                 " (%zu out of %zu bytes).", job->src, pos, job->fs);
+            } else {
+                snprintf(str, FTI_BUFS, "unable to copy '%s' to '%s' (%s).",
+                 job->src, job->dst, strerror(errno));
+            }
+            FTI_Print(str, FTI_WARN);
+            goto end;
+        }
+        pos += bytes;
+    }
+
+    // Skipped blocks at the end of the file
+    if (job->skip != NULL && ftruncate(out, job->fs) == -1) {
+        snprintf(str, FTI_BUFS, "unable to resize '%s' (%s).", job->dst,
+         strerror(errno));
+        FTI_Print(str, FTI_WARN);
+        goto end;
+    }
+
+    if (FTI_Conf->transferFadvise) {
+        posix_fadvise(out, 0, job->fs, POSIX_FADV_DONTNEED);
+    }
+
+    snprintf(str, FTI_BUFS, "copied '%s' to '%s' (%zu bytes) using %s.",
+     job->src, job->dst, job->fs, FTI_XferNames[method]);
+    FTI_Print(str, FTI_DBUG);
+    job->status = FTI_SCES;
+
+end:
+    free(buf);
+    close(in);
+    // Errors of remote file systems may be reported at close
+    if (close(out) == -1 && job->status == FTI_SCES) {
+        snprintf(str, FTI_BUFS, "unable to close '%s' (%s).", job->dst,
+         strerror(errno));
+        FTI_Print(str, FTI_WARN);
+        job->status = FTI_NSCS;
+    }
+    return job->status;
+}
+
+static void FTI_TransferTask(void* arg, int idx) {
+    FTIT_transferBatch* batch = (FTIT_transferBatch*) arg;
+    FTI_TransferFile(batch->FTI_Conf, &batch->jobs[idx]);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Copies a set of files concurrently.
+  @param      FTI_Conf        Configuration metadata.
+  @param      jobs            Copies to perform.
+  @param      nbJobs          Number of copies.
+  @return     integer         FTI_SCES if all copies succeeded.
+
+  The files are distributed among at most 'transfer_threads' threads. All
+  the copies are attempted, the status of each one is set in its job.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_TransferFiles(FTIT_configuration* FTI_Conf, FTIT_transfer* jobs,
+ int nbJobs) {
+    FTIT_transferBatch batch;
+    batch.FTI_Conf = FTI_Conf;
+    batch.jobs = jobs;
+
+    int nbThreads = (FTI_Conf->transferThreads < nbJobs) ?
+     FTI_Conf->transferThreads : nbJobs;
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, nbThreads);
+    FTI_ThreadPoolRun(&pool, nbJobs, FTI_TransferTask, &batch);
+    FTI_ThreadPoolFinalize(&pool);
+
+    int i;
+    for (i = 0; i < nbJobs; i++) {
+        if (jobs[i].status != FTI_SCES) {
+            return FTI_NSCS;
+        }
+    }
+    return FTI_SCES;
+}
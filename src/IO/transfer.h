@@ -0,0 +1,33 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   transfer.h
+ */
+
+#ifndef FTI_SRC_IO_TRANSFER_H_
+#define FTI_SRC_IO_TRANSFER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** File copy handled by the transfer engine **/
+typedef struct FTIT_transfer {
+    char    src[FTI_BUFS];      /**< Path of the file to copy             */
+    char    dst[FTI_BUFS];      /**< Path of the copy                     */
+    size_t  fs;                 /**< Number of bytes to copy              */
+    const uint8_t* skip;        /**< Blocks left as holes, or NULL        */
+    size_t  blockSize;          /**< Size of the blocks of 'skip'         */
+    size_t  skipped;            /**< Bytes left as holes                  */
+    int     status;             /**< FTI_SCES once the copy succeeded     */
+} FTIT_transfer;
+
+int FTI_TransferFile(FTIT_configuration* FTI_Conf, FTIT_transfer* job);
+int FTI_TransferFiles(FTIT_configuration* FTI_Conf, FTIT_transfer* jobs,
+ int nbJobs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // FTI_SRC_IO_TRANSFER_H_
@@ -61,6 +61,9 @@ static FTIT_keymap* FTI_Data;
 /** SDC injection model and all the required information.                  */
 static FTIT_injection FTI_Inje;
 
+/** L1 checkpoint written in the background, if any.                       */
+static FTIT_asyncCkpt FTI_Async;
+
 /** MPI communicator that splits the global one into app and FTI appart.   */
 MPI_Comm FTI_COMM_WORLD;
 
@@ -140,6 +143,13 @@ int FTI_Init(const char* configFile, MPI_Comm globalComm) {
     }
     MPI_Barrier(FTI_Exec.globalComm);  // wait for myRank == 0
                                        // process to save config file
+    // the spans of all processes start after the barrier
+    FTI_TraceInit(FTI_Conf.traceDir, FTI_Topo.myRank, FTI_Topo.amIaHead);
+    FTI_Exec.metricsStart = MPI_Wtime();
+    FTI_Exec.metricsDump = FTI_Exec.metricsStart;
+    if (FTI_Conf.metricsDir[0] != '\0') {
+        MKDIR(FTI_Conf.metricsDir, 0777);
+    }
     if (FTI_Conf.ioMode == FTI_IO_FTIFF) {
         FTIFF_InitMpiTypes();
     }
@@ -155,7 +165,11 @@ int FTI_Init(const char* configFile, MPI_Comm globalComm) {
         snprintf(FTI_Conf.suffix, sizeof(FTI_Conf.suffix), "fti");
     }
 
-    FTI_KeyMap(&FTI_Data, sizeof(FTIT_dataset), FTI_Conf.maxVarId, true);
+    res = FTI_Try(FTI_KeyMap(&FTI_Data, sizeof(FTIT_dataset),
+      FTI_Conf.maxVarId, true), "create the dataset keymap.");
+    if (res == FTI_NSCS) {
+        return FTI_NSCS;
+    }
 
     FTI_Exec.initSCES = 1;
 
@@ -185,6 +199,10 @@ int FTI_Init(const char* configFile, MPI_Comm globalComm) {
           "Initializing IO pointers") != FTI_SCES) {
             FTI_Print("Cannot define the function pointers\n", FTI_EROR);
         }
+        if (FTI_Try(FTI_AsyncInit(&FTI_Conf, &FTI_Topo, FTI_Ckpt, &FTI_Async),
+          "start the background checkpoint writer") != FTI_SCES) {
+            FTI_Print("Background L1 checkpoints are disabled.", FTI_WARN);
+        }
 
         // call in any case. treatment for diffCkpt disabled inside initializer
         if (FTI_Conf.dcpFtiff) {
@@ -627,8 +645,11 @@ int FTI_SendFile(char* lpath, char *rpath) {
     FTI_InitStageRequestApp(&FTI_Exec, &FTI_Topo, ID);
 
     if (FTI_Topo.nbHeads == 0) {
-        if (FTI_SyncStage(lpath, rpath, &FTI_Exec, &FTI_Topo,
-          &FTI_Conf, ID) != FTI_SCES) {
+        double t0 = FTI_TraceStart();
+        int res = FTI_SyncStage(lpath, rpath, &FTI_Exec, &FTI_Topo,
+          &FTI_Conf, ID);
+        FTI_TraceSpan("stage", "Stage", t0, ID);
+        if (res != FTI_SCES) {
             FTI_Print("synchronous staging failed!", FTI_WARN);
             return FTI_NSCS;
         }
@@ -712,7 +733,7 @@ int FTI_setIDFromString(char *name) {
     int i = 0;
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec.nbVar) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec.nbVar) != FTI_SCES) {
         FTI_Print("failed to set ID from string", FTI_WARN);
         return FTI_NSCS;
     }
@@ -730,7 +751,7 @@ int FTI_setIDFromString(char *name) {
     // set id to i+1 and assign name
     strncpy(dataAdd.idChar, name, FTI_BUFS);
 
-    FTI_Data->push_back(&dataAdd, i);
+    FTI_Data->push_back(FTI_Data, &dataAdd, i);
     FTI_Exec.nbVar++;
 
     return i;
@@ -754,7 +775,7 @@ int FTI_getIDFromString(char *name) {
      FTI_Exec.nbVarStored : FTI_Exec.nbVar;
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, n) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, n) != FTI_SCES) {
         FTI_Print("failed to get ID from string", FTI_WARN);
         return FTI_NSCS;
     }
@@ -801,7 +822,7 @@ int FTI_RenameGroup(FTIT_H5Group* h5group, char* name) {
 
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid) {
+int FTI_Protect(int id, void* ptr, int64_t count, fti_id_t tid) {
     if (FTI_Exec.initSCES == 0) {
         FTI_Print("FTI is not initialized.", FTI_WARN);
         return FTI_NSCS;
@@ -827,13 +848,13 @@ int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid) {
     char memLocation[4];
 
     FTIT_dataset* data;
-    if (FTI_Data->get(&data, id) != FTI_SCES) {
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) {
         FTI_Print("failed to protect variable", FTI_WARN);
         return FTI_NSCS;
     }
 
     if (data != NULL) {  // Search for dataset with given id
-        int32_t prevSize = data->size;
+        int64_t prevSize = data->size;
 #ifdef GPUSUPPORT
         if (ptrInfo.type == FTIT_PTRTYPE_CPU) {
             // strcpy(memLocation, "CPU");
@@ -998,6 +1019,7 @@ int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid) {
 #endif
     // Important assignment, we use realloc!
     data->sharedData.dataset = NULL;
+    data->attribute.codec = FTI_CODEC_DEFAULT;
     data->count = count;
     data->type = FTI_GetType(tid);
     if (data->type == NULL) {
@@ -1045,7 +1067,7 @@ int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid) {
     }
 
     // append dataset to protected variables
-    if (FTI_Data->push_back(data, id) != FTI_SCES) {
+    if (FTI_Data->push_back(FTI_Data, data, id) != FTI_SCES) {
         snprintf(str, FTI_BUFS, "failed to append variable with id = '%d' to"
         " protected variable map.", id);
         FTI_Print(str, FTI_EROR);
@@ -1088,11 +1110,14 @@ int FTI_Protect(int id, void* ptr, int32_t count, fti_id_t tid) {
   flag can consist of any combination of the following flags:
     FTI_ATTRIBUTE_NAME
     FTI_ATTRIBUTE_DIM
+    FTI_ATTRIBUTE_CODEC
   flags can be combined by using the bitwise or operator. The attributes will
   appear inside the meta data files when a checkpoint is taken. When setting 
   the dimension of a dataset, the first dimension is the leading dimension, 
   i.e. the dimension that is stored contiguous inside a flat matrix 
-  representation. 
+  representation. The codec is a combination of FTI_CODEC_ZLIB and
+  FTI_CODEC_SHUFFLE, FTI_CODEC_NONE, or FTI_CODEC_DEFAULT to fall back to
+  'Advanced:codec' of the configuration.
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_SetAttribute(int id, FTIT_attribute attribute,
@@ -1103,7 +1128,7 @@ int FTI_SetAttribute(int id, FTIT_attribute attribute,
     }
 
     FTIT_dataset* data;
-    if (FTI_Data->get(&data, id) != FTI_SCES) {
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) {
         FTI_Print("failed to set attribute: could not query dataset", FTI_WARN);
         return FTI_NSCS;
     }
@@ -1125,6 +1150,18 @@ int FTI_SetAttribute(int id, FTIT_attribute attribute,
         data->attribute.dim = attribute.dim;
     }
 
+    if ( (flag & FTI_ATTRIBUTE_CODEC) == FTI_ATTRIBUTE_CODEC ) {
+        if (attribute.codec != FTI_CODEC_DEFAULT && (attribute.codec &
+         ~(FTI_CODEC_ZLIB | FTI_CODEC_SHUFFLE))) {
+            char str[FTI_BUFS];
+            snprintf(str, FTI_BUFS, "failed to set attribute: invalid codec"
+             " '%d' for dataset with id=%d", attribute.codec, id);
+            FTI_Print(str, FTI_WARN);
+            return FTI_NSCS;
+        }
+        data->attribute.codec = attribute.codec;
+    }
+
     return FTI_SCES;
 }
 
@@ -1231,7 +1268,7 @@ int FTI_AddSubset(int id, int rank, FTIT_hsize_t* offset,
 #ifdef ENABLE_HDF5
 
     FTIT_dataset* data;
-    if (FTI_Data->get(&data, id) != FTI_SCES) {
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) {
         FTI_Print("failed to add subset", FTI_WARN);
         return FTI_NSCS;
     }
@@ -1356,7 +1393,7 @@ int FTI_UpdateSubset(int id, int rank, FTIT_hsize_t* offset,
 #ifdef ENABLE_HDF5
 
     FTIT_dataset* data;
-    if (FTI_Data->get(&data, id) != FTI_SCES) {
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) {
         FTI_Print("failed to update subset", FTI_WARN);
         return FTI_NSCS;
     }
@@ -1598,7 +1635,7 @@ int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
     char str[FTI_BUFS];  // For console output
 
     FTIT_dataset* data;
-    if (FTI_Data->get(&data, id) != FTI_SCES) {
+    if (FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) {
         FTI_Print("failed to define dataset", FTI_WARN);
         return FTI_NSCS;
     }
@@ -1613,7 +1650,7 @@ int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
     }
 
     // check if size is correct
-    int expectedSize = 1;
+    int64_t expectedSize = 1;
     int j;
     for (j = 0; j < rank; j++) {
         expectedSize *= dimLength[j];  // compute the number of elements
@@ -1624,7 +1661,7 @@ int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
             // sprintf(str, "Trying to define datasize: number of elements %d,
             // but the dataset count is %ld.", expectedSize, data->count);
             snprintf(str, sizeof(str), "Trying to define datasize: number of"
-            " elements %d, but the dataset count is %d.",
+            " elements %ld, but the dataset count is %ld.",
              expectedSize, data->count);
             FTI_Print(str, FTI_WARN);
             return FTI_NSCS;
@@ -1650,7 +1687,7 @@ int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
 /**
   @brief      Returns size saved in metadata of variable
   @param      id              Variable ID.
-  @return     int32_t            Returns size of variable or 0 if size not saved.
+  @return     int64_t            Returns size of variable or 0 if size not saved.
 
   This function returns size of variable of given ID that is saved in metadata.
   This may be different from size of variable that is in the program. If this
@@ -1659,14 +1696,14 @@ int FTI_DefineDataset(int id, int rank, int* dimLength, char* name,
   is no size saved in metadata it returns 0.
  **/
 /*-------------------------------------------------------------------------*/
-int32_t FTI_GetStoredSize(int id) {
+int64_t FTI_GetStoredSize(int id) {
     if (FTI_Exec.initSCES == 0) {
         FTI_Print("FTI is not initialized.", FTI_WARN);
         return 0;
     }
 
     FTIT_dataset* data;
-    if ((FTI_Data->get(&data, id) != FTI_SCES)) {
+    if ((FTI_Data->get(FTI_Data, &data, id) != FTI_SCES)) {
         FTI_Print("Unable to determine the stored variable size!", FTI_WARN);
         return 0;
     }
@@ -1704,7 +1741,7 @@ void* FTI_Realloc(int id, void* ptr) {
 
     if (FTI_Exec.reco) {
         FTIT_dataset* data;
-        if ((FTI_Data->get(&data, id) != FTI_SCES)) {
+        if ((FTI_Data->get(FTI_Data, &data, id) != FTI_SCES)) {
             FTI_Print("Unable to reallocate variable buffer to stored size!",
              FTI_WARN);
             return ptr;
@@ -1731,7 +1768,7 @@ void* FTI_Realloc(int id, void* ptr) {
         ptr = tmp;
 
         // sprintf(str, "Reallocated size: %ld", data->sizeStored);
-        snprintf(str, sizeof(str), "Reallocated size: %d", data->sizeStored);
+        snprintf(str, sizeof(str), "Reallocated size: %ld", data->sizeStored);
         FTI_Print(str, FTI_INFO);
 
         FTI_Exec.ckptSize += data->sizeStored - data->size;
@@ -1773,7 +1810,7 @@ int FTI_BitFlip(int id) {
         }
 
         FTIT_dataset* data;
-        if ((FTI_Data->get(&data, id) != FTI_SCES) || !data) {
+        if ((FTI_Data->get(FTI_Data, &data, id) != FTI_SCES) || !data) {
             FTI_Print("Dataset id to inject BitFlip is invalid", FTI_WARN);
             return FTI_NSCS;
         }
@@ -1827,6 +1864,150 @@ int FTI_BitFlip(int id) {
     return FTI_NSCS;
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Post-processes a written checkpoint.
+  @param      res             Result of the write.
+  @param      stored          Datasets stored in the checkpoint.
+  @param      nbStored        Number of datasets stored.
+  @param      t0              Time at which the checkpoint started.
+  @param      t1              Time at which the write started.
+  @param      t2              Time at which the write ended.
+  @return     integer         FTI_DONE if successful.
+
+  'stored' is FTI_Data, or the snapshot of a background checkpoint. The
+  positions of the datasets in the file are copied to FTI_Data to allow
+  the recovery online.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_FinishCkpt(int res, FTIT_keymap* stored, int nbStored,
+ double t0, double t1, double t2) {
+    char str[FTI_BUFS];  // For console output
+    int level = FTI_Exec.ckptMeta.level;
+
+    if (!FTI_Ckpt[FTI_Exec.ckptMeta.level].isInline) {
+        // If postCkpt. work is Async. then send message
+        FTI_Exec.activateHeads(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt, res);
+    } else {  // If post-processing is inline
+        FTI_Exec.wasLastOffline = 0;
+        if (res != FTI_SCES) {  // If Writing checkpoint failed
+            // The same as head call FTI_PostCkpt with reject
+            // ckptLvel if not success
+            FTI_Exec.ckptMeta.level = FTI_REJW - FTI_BASE;
+        }
+        res = FTI_Try(FTI_PostCkpt(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt,
+         stored), "postprocess the checkpoint.");
+        if (res == FTI_SCES) {
+            FTI_Exec.ckptLvel = FTI_Exec.ckptMeta.level;  // Update level
+        }
+    }
+    double t3;
+
+    if (!FTI_Exec.hasCkpt && (FTI_Topo.splitRank == 0) && (res == FTI_SCES)) {
+        // Setting recover flag to 1 (to recover from current ckpt level)
+        res = FTI_Try(FTI_UpdateConf(&FTI_Conf, &FTI_Exec, 1),
+         "update configuration file.");
+        // in case FTI couldn't recover all ckpt files in FTI_Init
+        FTI_Exec.initSCES = 1;
+        if (res == FTI_SCES) {
+            FTI_Exec.hasCkpt = true;
+        }
+    }
+
+    MPI_Bcast(&FTI_Exec.hasCkpt, 1, MPI_INT, 0, FTI_COMM_WORLD);
+
+    t3 = MPI_Wtime();  // Time after post-processing
+    FTI_Exec.timings.total = t3 - t0;
+    FTI_Exec.timings.level = FTI_Exec.ckptMeta.level;
+    FTI_TraceSpan("api", "Checkpoint", t0, level);
+    FTI_MetricsCkpt(&FTI_Exec, level, (FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix)
+     && FTI_Ckpt[4].isDcp, t2 - t1, res);
+    FTI_MetricsDump(&FTI_Conf, &FTI_Exec, &FTI_Topo, false);
+    // a dCP costs less than the full checkpoint of the level
+    if (FTI_Conf.ckptScheduler && !FTI_Ckpt[4].isDcp) {
+        FTI_UpdateCkptCost(&FTI_Exec, FTI_Ckpt, level, t3 - t0, res);
+    }
+
+    if (res != FTI_SCES) {
+        // sprintf(str, "Checkpoint with ID %d at Level %d failed.",
+        // FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level);
+        snprintf(str, sizeof(str), "Checkpoint with ID %d at Level %d failed.",
+         FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    /*sprintf(str, "Ckpt. ID %d (L%d) (%.2f MB/proc) taken in %.2f sec. 
+    (Wt:%.2fs, Wr:%.2fs, Ps:%.2fs)",
+            FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level, 
+            FTI_Exec.ckptSize / (1024.0 * 1024.0), t3 - t0,
+             t1 - t0, t2 - t1, t3 - t2);*/
+    snprintf(str, sizeof(str), "Ckpt. ID %d (L%d) (%.2f MB/proc) taken in %.2f"
+    " sec. (Wt:%.2fs, Wr:%.2fs, Ps:%.2fs)",
+            FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level,
+             FTI_Exec.ckptSize / (1024.0 * 1024.0), t3 - t0, t1 - t0, t2 - t1,
+             t3 - t2);
+    FTI_Print(str, FTI_INFO);
+
+    if ( (FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix) && FTI_Ckpt[4].isDcp ) {
+        FTI_PrintDcpStats(FTI_Conf, FTI_Exec, FTI_Topo);
+    }
+
+    // update stored values to allow recovery online.
+    // FIXME in such a way, we don't cover the case !inline since at
+    // this point we cannot know if the
+    // postprocessing has been successfully.
+    // One way could be to convert tmp checkpoint into
+    // L1 checkpoint and update lateron.
+
+    FTI_Exec.nbVarStored = nbStored;
+    FTI_Exec.ckptId = FTI_Exec.ckptMeta.ckptId;
+
+    FTIT_dataset* data;
+    if (stored->data(stored, &data, nbStored) != FTI_SCES) {
+        FTI_Print("failed to finalize FTI", FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    int k = 0; for (; k < nbStored; k++) {
+        FTIT_dataset* var = &data[k];
+        if (stored != FTI_Data && FTI_Data->get(FTI_Data, &var, data[k].id)
+         != FTI_SCES) {
+            return FTI_NSCS;
+        }
+        if (var == NULL) {
+            continue;
+        }
+        var->sizeStored = data[k].size;
+        var->filePos = data[k].filePos;
+        var->codec = data[k].codec;
+    }
+
+    return FTI_DONE;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Completes the L1 checkpoint written in the background.
+  @return     integer         FTI_DONE if successful.
+
+  Waits for the background write, then creates the metadata and does the
+  post-processing like FTI_Checkpoint. Collective.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_CompleteAsyncCkpt() {
+    double t0 = MPI_Wtime();
+    FTIT_timings timings = {0};
+    FTI_Exec.timings = timings;
+    int res = FTI_Try(FTI_AsyncWait(&FTI_Exec, &FTI_Async),
+     "complete the background checkpoint.");
+    double t2 = MPI_Wtime();
+    return FTI_FinishCkpt(res, FTI_Async.data, FTI_Async.exec.nbVar, t0, t0,
+     t2);
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It takes the checkpoint and triggers the post-ckpt. work.
@@ -1863,6 +2044,10 @@ int FTI_Checkpoint(int id, int level) {
 
     double t1, t2;
 
+    if (FTI_Async.pending) {
+        FTI_CompleteAsyncCkpt();
+    }
+
     FTI_Exec.ckptMeta.ckptId = id;
 
     // reset hdf5 single file requests.
@@ -1879,7 +2064,8 @@ int FTI_Checkpoint(int id, int level) {
 
     if (level == FTI_L4_DCP) {
         if ((FTI_Conf.ioMode == FTI_IO_FTIFF) ||
-         (FTI_Conf.ioMode == FTI_IO_POSIX)) {
+         (FTI_Conf.ioMode == FTI_IO_POSIX) ||
+         (FTI_Conf.ioMode == FTI_IO_IOURING)) {
             if ( FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix ) {
                 FTI_Ckpt[4].isDcp = true;
             } else {
@@ -1892,6 +2078,8 @@ int FTI_Checkpoint(int id, int level) {
     }
 
     double t0 = MPI_Wtime();  // Start time
+    FTIT_timings timings = {0};
+    FTI_Exec.timings = timings;
     if (FTI_Exec.wasLastOffline == 1) {
         // Block until previous checkpoint is done (Async. work)
         int lastLevel;
@@ -1915,7 +2103,15 @@ int FTI_Checkpoint(int id, int level) {
 
     // Time after waiting for head to done previous post-processing
     t1 = MPI_Wtime();
+    FTI_Exec.timings.wait = t1 - t0;
     FTI_Exec.ckptMeta.level = level;  // assign to temporary metadata
+    if (FTI_AsyncCkpt(&FTI_Exec, FTI_Data, &FTI_Async) == FTI_SCES) {
+        FTI_TraceSpan("api", "Snapshot", t0, id);
+        snprintf(str, sizeof(str), "Ckpt. ID %d (L1) snapshot taken in %.2f"
+         " sec., written in background.", id, MPI_Wtime() - t0);
+        FTI_Print(str, FTI_INFO);
+        return FTI_DONE;
+    }
     int res = FTI_Try(FTI_WriteCkpt(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt,
      FTI_Data), "write the checkpoint.");
     t2 = MPI_Wtime();  // Time after writing checkpoint
@@ -1927,85 +2123,151 @@ int FTI_Checkpoint(int id, int level) {
 #endif
     }
 
-    if (!FTI_Ckpt[FTI_Exec.ckptMeta.level].isInline) {
-        // If postCkpt. work is Async. then send message
-        FTI_Exec.activateHeads(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt, res);
-    } else {  // If post-processing is inline
-        FTI_Exec.wasLastOffline = 0;
-        if (res != FTI_SCES) {  // If Writing checkpoint failed
-            // The same as head call FTI_PostCkpt with reject
-            // ckptLvel if not success
-            FTI_Exec.ckptMeta.level = FTI_REJW - FTI_BASE;
-        }
-        res = FTI_Try(FTI_PostCkpt(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt),
-         "postprocess the checkpoint.");
-        if (res == FTI_SCES) {
-            FTI_Exec.ckptLvel = FTI_Exec.ckptMeta.level;  // Update level
-        }
+    return FTI_FinishCkpt(res, FTI_Data, FTI_Exec.nbVar, t0, t1, t2);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the phase timings of the last checkpoint.
+  @param      timings         Filled with the durations of the last ckpt.
+  @return     integer         FTI_SCES if successful.
+
+  This function copies the durations measured by the calling process during
+  the last call to FTI_Checkpoint (waiting, writing, hashing/metadata,
+  post-processing and flush). The values are local to the process; use a
+  reduction to obtain the critical path over all ranks.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_GetCkptTimings(FTIT_timings* timings) {
+    if (FTI_Exec.initSCES == 0) {
+        FTI_Print("FTI is not initialized.", FTI_WARN);
+        return FTI_NSCS;
     }
-    double t3;
 
-    if (!FTI_Exec.hasCkpt && (FTI_Topo.splitRank == 0) && (res == FTI_SCES)) {
-        // Setting recover flag to 1 (to recover from current ckpt level)
-        res = FTI_Try(FTI_UpdateConf(&FTI_Conf, &FTI_Exec, 1),
-         "update configuration file.");
-        // in case FTI couldn't recover all ckpt files in FTI_Init
-        FTI_Exec.initSCES = 1;
-        if (res == FTI_SCES) {
-            FTI_Exec.hasCkpt = true;
-        }
+    if (timings == NULL) {
+        FTI_Print("timings is NULL, cannot return the ckpt. timings.",
+         FTI_WARN);
+        return FTI_NSCS;
     }
 
-    MPI_Bcast(&FTI_Exec.hasCkpt, 1, MPI_INT, 0, FTI_COMM_WORLD);
+    *timings = FTI_Exec.timings;
+    return FTI_SCES;
+}
 
-    t3 = MPI_Wtime();  // Time after post-processing
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the checkpoint intervals used by FTI_Snapshot.
+  @param      schedule        Filled with the intervals of the levels.
+  @return     integer         FTI_SCES if successful.
 
-    if (res != FTI_SCES) {
-        // sprintf(str, "Checkpoint with ID %d at Level %d failed.",
-        // FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level);
-        snprintf(str, sizeof(str), "Checkpoint with ID %d at Level %d failed.",
-         FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level);
-        FTI_Print(str, FTI_WARN);
+  This function copies, for each level, the checkpoint interval in minutes
+  and, when the scheduler is enabled ('Advanced:ckpt_scheduler'), the
+  smoothed checkpoint cost and the MTBF it is computed from. The values
+  are the same on all the application processes.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_GetCkptSchedule(FTIT_schedule* schedule) {
+    if (FTI_Exec.initSCES == 0) {
+        FTI_Print("FTI is not initialized.", FTI_WARN);
         return FTI_NSCS;
     }
 
-    /*sprintf(str, "Ckpt. ID %d (L%d) (%.2f MB/proc) taken in %.2f sec. 
-    (Wt:%.2fs, Wr:%.2fs, Ps:%.2fs)",
-            FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level, 
-            FTI_Exec.ckptSize / (1024.0 * 1024.0), t3 - t0,
-             t1 - t0, t2 - t1, t3 - t2);*/
-    snprintf(str, sizeof(str), "Ckpt. ID %d (L%d) (%.2f MB/proc) taken in %.2f"
-    " sec. (Wt:%.2fs, Wr:%.2fs, Ps:%.2fs)",
-            FTI_Exec.ckptMeta.ckptId, FTI_Exec.ckptMeta.level,
-             FTI_Exec.ckptSize / (1024.0 * 1024.0), t3 - t0, t1 - t0, t2 - t1,
-             t3 - t2);
-    FTI_Print(str, FTI_INFO);
+    if (schedule == NULL) {
+        FTI_Print("schedule is NULL, cannot return the ckpt. schedule.",
+         FTI_WARN);
+        return FTI_NSCS;
+    }
 
-    if ( (FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix) && FTI_Ckpt[4].isDcp ) {
-        FTI_PrintDcpStats(FTI_Conf, FTI_Exec, FTI_Topo);
+    memset(schedule, 0, sizeof(FTIT_schedule));
+    int i;
+    for (i = 1; i < 5; i++) {
+        schedule->interval[i] = FTI_Ckpt[i].ckptIntv;
+        schedule->cost[i] = FTI_Ckpt[i].ckptCost;
+        schedule->mtbf[i] = FTI_Ckpt[i].mtbf;
     }
+    return FTI_SCES;
+}
 
-    // update stored values to allow recovery online.
-    // FIXME in such a way, we don't cover the case !inline since at
-    // this point we cannot know if the
-    // postprocessing has been successfully.
-    // One way could be to convert tmp checkpoint into
-    // L1 checkpoint and update lateron.
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Sets the MTBF of a checkpoint level.
+  @param      level           Checkpoint level (1 to 4).
+  @param      mtbf            Mean time between failures in minutes.
+  @return     integer         FTI_SCES if successful.
 
-    FTI_Exec.nbVarStored = FTI_Exec.nbVar;
-    FTI_Exec.ckptId = FTI_Exec.ckptMeta.ckptId;
+  Replaces the MTBF configured for the level ('Advanced:mtbf_l1' to
+  'mtbf_l4'), e.g. with the failure rate observed by the resource manager.
+  With the scheduler enabled, the interval of the level is recomputed at
+  once if its cost was already measured. The same value must be passed on
+  all the application processes.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_SetMtbf(int level, double mtbf) {
+    if (FTI_Exec.initSCES == 0) {
+        FTI_Print("FTI is not initialized.", FTI_WARN);
+        return FTI_NSCS;
+    }
 
-    FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec.nbVar) != FTI_SCES) {
-        FTI_Print("failed to finalize FTI", FTI_WARN);
+    if (level < 1 || level > 4 || mtbf < 0) {
+        FTI_Print("Invalid level or MTBF, cannot set the MTBF.", FTI_WARN);
         return FTI_NSCS;
     }
 
-    int k = 0; for (; k < FTI_Exec.nbVar; k++) {
-        data[k].sizeStored = data[k].size;
+    FTI_Ckpt[level].mtbf = mtbf;
+    if (FTI_Conf.ckptScheduler) {
+        return FTI_ScheduleLevel(&FTI_Exec, FTI_Ckpt, level);
     }
+    return FTI_SCES;
+}
 
-    return FTI_DONE;
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the checkpoint metrics since FTI_Init.
+  @param      metrics         Filled with the metrics.
+  @param      scope           FTI_METRICS_LOCAL, _NODE or _GLOBAL.
+  @return     integer         FTI_SCES if successful.
+
+  This function returns the checkpoints taken per level, the bytes they
+  wrote, the dCP dirty shares, the latency histograms of the writes, the
+  post-processing and the recoveries, and the flushed bytes. With
+  FTI_METRICS_NODE or FTI_METRICS_GLOBAL, the metrics of the application
+  processes of the node or of the whole execution are aggregated, the call
+  is then collective on FTI_COMM_WORLD. The metrics of the heads are only
+  written in their metrics files ('Advanced:metrics_dir').
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_GetMetrics(FTIT_metrics* metrics, int scope) {
+    if (FTI_Exec.initSCES == 0) {
+        FTI_Print("FTI is not initialized.", FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    if (metrics == NULL) {
+        FTI_Print("metrics is NULL, cannot return the metrics.", FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    FTIT_metrics local = FTI_Exec.metrics;
+    local.nbProcs = 1;
+    local.uptime = MPI_Wtime() - FTI_Exec.metricsStart;
+    switch (scope) {
+        case FTI_METRICS_LOCAL:
+            *metrics = local;
+            return FTI_SCES;
+        case FTI_METRICS_GLOBAL:
+            return FTI_MetricsReduce(&local, metrics, FTI_COMM_WORLD);
+        case FTI_METRICS_NODE: {
+            MPI_Comm nodeComm;
+            MPI_Comm_split(FTI_COMM_WORLD, FTI_Topo.nodeID, FTI_Topo.myRank,
+             &nodeComm);
+            int res = FTI_MetricsReduce(&local, metrics, nodeComm);
+            MPI_Comm_free(&nodeComm);
+            return res;
+        }
+        default:
+            FTI_Print("Unknown scope, cannot return the metrics.", FTI_WARN);
+            return FTI_NSCS;
+    }
 }
 
 /*-------------------------------------------------------------------------*/
@@ -2038,6 +2300,10 @@ int FTI_InitICP(int id, int level, bool activate) {
         return FTI_SCES;
     }
 
+    if (FTI_Async.pending) {
+        FTI_CompleteAsyncCkpt();
+    }
+
     FTI_Exec.h5SingleFile = false;
     if (level == FTI_L4_H5_SINGLE) {
         if (FTI_Conf.h5SingleFileEnable) {
@@ -2087,7 +2353,8 @@ int FTI_InitICP(int id, int level, bool activate) {
     FTI_Ckpt[4].isDcp = false;
     if (level == FTI_L4_DCP) {
         if ((FTI_Conf.ioMode == FTI_IO_FTIFF) ||
-         (FTI_Conf.ioMode == FTI_IO_POSIX)) {
+         (FTI_Conf.ioMode == FTI_IO_POSIX) ||
+         (FTI_Conf.ioMode == FTI_IO_IOURING)) {
             if (FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix) {
                 FTI_Ckpt[4].isDcp = true;
             } else {
@@ -2189,7 +2456,7 @@ int FTI_AddVarICP(int varID) {
     char str[FTI_BUFS];
 
     FTIT_dataset* data;
-    if ((FTI_Data->get(&data, varID) != FTI_SCES) || !data) {
+    if ((FTI_Data->get(FTI_Data, &data, varID) != FTI_SCES) || !data) {
         snprintf(str, FTI_BUFS,
          "FTI_AddVarICP: dataset ID: %d is invalid!", varID);
         FTI_Print(str, FTI_WARN);
@@ -2292,13 +2559,14 @@ int FTI_FinalizeICP() {
 
     if ((FTI_Conf.dcpFtiff || FTI_Conf.dcpPosix) && FTI_Ckpt[4].isDcp) {
         // After dCP update store total data and dCP sizes in application rank0
-        uint32_t *dataSize = (FTI_Conf.dcpFtiff)?(uint32_t*)&
+        uint64_t *dataSize = (FTI_Conf.dcpFtiff)?(uint64_t*)&
         FTI_Exec.FTIFFMeta.pureDataSize:&FTI_Exec.dcpInfoPosix.dataSize;
-        uint32_t *dcpSize = (FTI_Conf.dcpFtiff)?(uint32_t*)&
+        uint64_t *dcpSize = (FTI_Conf.dcpFtiff)?(uint64_t*)&
         FTI_Exec.FTIFFMeta.dcpSize:&FTI_Exec.dcpInfoPosix.dcpSize;
-        uint32_t dcpStats[2];  // 0:totalDcpSize, 1:totalDataSize
-        uint32_t sendBuf[] = { *dcpSize, *dataSize };
-        MPI_Reduce(sendBuf, dcpStats, 2, MPI_UINT32_T, MPI_SUM, 0,
+        FTI_MetricsDcp(&FTI_Exec, *dataSize, *dcpSize);
+        uint64_t dcpStats[2];  // 0:totalDcpSize, 1:totalDataSize
+        uint64_t sendBuf[] = { *dcpSize, *dataSize };
+        MPI_Reduce(sendBuf, dcpStats, 2, MPI_UINT64_T, MPI_SUM, 0,
          FTI_COMM_WORLD);
         if (FTI_Topo.splitRank ==  0) {
             *dcpSize = dcpStats[0];
@@ -2326,8 +2594,9 @@ int FTI_FinalizeICP() {
             // ckptLvel if not success
             FTI_Exec.ckptMeta.level = FTI_REJW - FTI_BASE;
         }
-        resPP = FTI_Try(FTI_PostCkpt(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt),
-         "postprocess the checkpoint.");
+        // the datasets may have changed since they were added to the file
+        resPP = FTI_Try(FTI_PostCkpt(&FTI_Conf, &FTI_Exec, &FTI_Topo, FTI_Ckpt,
+         NULL), "postprocess the checkpoint.");
         if (resPP == FTI_SCES) {
             // Store last successful post-processing checkpoint level
             FTI_Exec.ckptLvel = FTI_Exec.ckptMeta.level;
@@ -2348,6 +2617,10 @@ int FTI_FinalizeICP() {
     MPI_Bcast(&FTI_Exec.hasCkpt, 1, MPI_INT, 0, FTI_COMM_WORLD);
 
     double t3 = MPI_Wtime();  // Time after post-processing
+    FTI_MetricsCkpt(&FTI_Exec, FTI_Exec.ckptMeta.level, (FTI_Conf.dcpFtiff ||
+     FTI_Conf.dcpPosix) && FTI_Ckpt[4].isDcp, t2 - FTI_Exec.iCPInfo.t1,
+     (resCP == FTI_SCES) ? resPP : resCP);
+    FTI_MetricsDump(&FTI_Conf, &FTI_Exec, &FTI_Topo, false);
 
     if (resCP == FTI_SCES) {
         FTI_Exec.ckptId = FTI_Exec.ckptMeta.ckptId;
@@ -2396,7 +2669,7 @@ int FTI_FinalizeICP() {
     FTI_Exec.nbVarStored = FTI_Exec.nbVar;
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec.nbVar) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec.nbVar) != FTI_SCES) {
         FTI_Print("failed to finalize FTI", FTI_WARN);
         return FTI_NSCS;
     }
@@ -2410,15 +2683,11 @@ int FTI_FinalizeICP() {
 
 /*-------------------------------------------------------------------------*/
 /**
-  @brief      It loads the checkpoint data.
+  @brief      Reads the protected datasets from the checkpoint files.
   @return     integer         FTI_SCES if successful.
-
-  This function loads the checkpoint data from the checkpoint file and
-  it updates some basic checkpoint information.
-
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_Recover() {
+static int FTI_LoadCkptData() {
     if ( FTI_Conf.ioMode == FTI_IO_FTIFF ) {
         int ret = FTI_Try(FTIFF_Recover(&FTI_Exec, FTI_Data, FTI_Ckpt),
          "Recovering from Checkpoint");
@@ -2429,6 +2698,9 @@ int FTI_Recover() {
         FTI_Print("FTI is not initialized.", FTI_WARN);
         return FTI_NREC;
     }
+    if (FTI_Async.pending) {
+        FTI_CompleteAsyncCkpt();
+    }
     if (FTI_Exec.initSCES == 2) {
         FTI_Print("No checkpoint files to make recovery.", FTI_WARN);
         return FTI_NREC;
@@ -2439,7 +2711,7 @@ int FTI_Recover() {
     char str[2*FTI_BUFS];  // For console output
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec.nbVarStored) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec.nbVarStored) != FTI_SCES) {
         FTI_Print("failed to recover", FTI_WARN);
         return FTI_NREC;
     }
@@ -2474,8 +2746,8 @@ int FTI_Recover() {
                 protected variable (ID %d) size: %ld",
                         data[i].sizeStored, data[i].id,
                         data[i].size);*/
-                snprintf(str, sizeof(str), "Cannot recover %d bytes to "
-                  "protected variable (ID %d) size: %d",
+                snprintf(str, sizeof(str), "Cannot recover %ld bytes to "
+                  "protected variable (ID %d) size: %ld",
                         data[i].sizeStored, data[i].id,
                         data[i].size);
                 FTI_Print(str, FTI_WARN);
@@ -2497,7 +2769,7 @@ int FTI_Recover() {
         int lidx = FTI_Exec.dcpInfoPosix.nbLayerReco - 1;
         for (i = 0; i < FTI_Exec.nbVarStored; i++) {
             int varId = FTI_Exec.dcpInfoPosix.datasetInfo[lidx][i].varID;
-            if ((FTI_Data->get(&data, varId) != FTI_SCES) || !data) {
+            if ((FTI_Data->get(FTI_Data, &data, varId) != FTI_SCES) || !data) {
                 char errstr[FTI_BUFS];
                 snprintf(errstr, FTI_BUFS, "id '%d' does not exist!", varId);
                 FTI_Print(errstr, FTI_EROR);
@@ -2510,8 +2782,8 @@ int FTI_Recover() {
                         FTI_Exec.dcpInfoPosix.datasetInfo[lidx][i].varSize, 
                         FTI_Exec.dcpInfoPosix.datasetInfo[lidx][i].varID,
                         data->sizeStored);*/
-                snprintf(str, sizeof(str), "Cannot recover %d bytes to "
-                  "protected variable (ID %d) size: %d",
+                snprintf(str, sizeof(str), "Cannot recover %lu bytes to "
+                  "protected variable (ID %d) size: %ld",
                         FTI_Exec.dcpInfoPosix.datasetInfo[lidx][i].varSize,
                          FTI_Exec.dcpInfoPosix.datasetInfo[lidx][i].varID,
                         data->sizeStored);
@@ -2553,54 +2825,13 @@ int FTI_Recover() {
       fn);
     FTI_Print(str, FTI_DBUG);
 
-    FILE* fd = fopen(fn, "rb");
-    if (fd == NULL) {
-        // sprintf(str, "Could not open FTI checkpoint file. (%s)...", fn);
-        snprintf(str, sizeof(str), "Could not open FTI checkpoint file."
-          " (%s)...", fn);
-        FTI_Print(str, FTI_EROR);
-        return FTI_NREC;
-    }
-
-    if (FTI_Data->data(&data, FTI_Exec.nbVarStored) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec.nbVarStored) != FTI_SCES) {
         FTI_Print("failed to recover", FTI_WARN);
         return FTI_NREC;
     }
 
-#ifdef GPUSUPPORT
-
-    for (i = 0; i < FTI_Exec.nbVarStored; i++) {
-        size_t filePos = data[i].filePosStored;
-        // strncpy(data[i].idChar, data[i].idChar, FTI_BUFS);
-        fseek(fd, filePos, SEEK_SET);
-        if (data[i].isDevicePtr)
-            FTI_TransferFileToDeviceAsync(fd, data[i].devicePtr,
-             data[i].sizeStored);
-        else
-            fread(data[i].ptr, 1, data[i].sizeStored, fd);
-
-        if (ferror(fd)) {
-            FTI_Print("Could not read FTI checkpoint file.", FTI_EROR);
-            fclose(fd);
-            return FTI_NREC;
-        }
-    }
-
-#else
-    for (i = 0; i < FTI_Exec.nbVarStored; i++) {
-        size_t filePos = data[i].filePos;
-        // strncpy(data[i].idChar, data[i].idChar, FTI_BUFS);
-        fseek(fd, filePos, SEEK_SET);
-        fread(data[i].ptr, 1, data[i].sizeStored, fd);
-        if (ferror(fd)) {
-            FTI_Print("Could not read FTI checkpoint file.", FTI_EROR);
-            fclose(fd);
-            return FTI_NREC;
-        }
-    }
-#endif
-    if (fclose(fd) != 0) {
-        FTI_Print("Could not close FTI checkpoint file.", FTI_EROR);
+    if (FTI_ReadDatasets(&FTI_Conf, fn, data, FTI_Exec.nbVarStored)
+     != FTI_SCES) {
         return FTI_NREC;
     }
 
@@ -2609,6 +2840,27 @@ int FTI_Recover() {
     return FTI_SCES;
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      It loads the checkpoint data.
+  @return     integer         FTI_SCES if successful.
+
+  This function loads the checkpoint data from the checkpoint file and
+  it updates some basic checkpoint information. The datasets are read
+  concurrently by 'read_threads' threads.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_Recover() {
+    double t0 = MPI_Wtime();
+    int res = FTI_LoadCkptData();
+    FTI_TraceSpan("reco", "Recover", t0, FTI_Exec.ckptLvel);
+    if (res == FTI_SCES) {
+        FTI_MetricsLatency(&FTI_Exec.metrics.recover, MPI_Wtime() - t0);
+    }
+    return res;
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      Takes an FTI snapshot or recovers the data if it is a restart.
@@ -2700,7 +2952,9 @@ int FTI_Finalize() {
             FTI_FinalizeStage(&FTI_Exec, &FTI_Topo, &FTI_Conf);
         }
         MPI_Barrier(FTI_Exec.globalComm);
-        FTI_Data->clear();
+        FTI_Data->clear(FTI_Data);
+        FTI_TraceFinalize();
+    FTI_MetricsDump(&FTI_Conf, &FTI_Exec, &FTI_Topo, true);
         if (!FTI_Conf.keepHeadsAlive) {
             MPI_Finalize();
             exit(0);
@@ -2711,8 +2965,13 @@ int FTI_Finalize() {
 
     // Notice: The following code is only executed by the application procs
 
+    if (FTI_Async.pending) {
+        FTI_CompleteAsyncCkpt();
+    }
+    FTI_AsyncFree(&FTI_Async);
+
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec.nbVar) != FTI_SCES) {
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec.nbVar) != FTI_SCES) {
         FTI_Print("failed to finalize FTI", FTI_WARN);
         return FTI_NSCS;
     }
@@ -2840,7 +3099,9 @@ int FTI_Finalize() {
         FTI_FreeVPRMem(&FTI_Exec, FTI_Data);
     }
 #endif
-    FTI_Data->clear();
+    FTI_Data->clear(FTI_Data);
+    FTI_TraceFinalize();
+    FTI_MetricsDump(&FTI_Conf, &FTI_Exec, &FTI_Topo, true);
     MPI_Barrier(FTI_Exec.globalComm);
     FTI_Print("FTI has been finalized.", FTI_INFO);
     return FTI_SCES;
@@ -2870,6 +3131,10 @@ int FTI_RecoverVarInit() {
         return FTI_SCES;
     }
 
+    if (FTI_Async.pending) {
+        FTI_CompleteAsyncCkpt();
+    }
+
     if (FTI_Exec.initSCES == 2) {
         FTI_Print("No checkpoint files to make recovery.", FTI_WARN);
         return FTI_NSCS;
@@ -2913,6 +3178,7 @@ int FTI_RecoverVarInit() {
             break;
 
         case FTI_IO_POSIX:
+        case FTI_IO_IOURING:
             res = FTI_RecoverVarInitPOSIX(fn);
             break;
 
@@ -2974,6 +3240,7 @@ int FTI_RecoverVar(int id) {
             break;
 
         case FTI_IO_POSIX:
+        case FTI_IO_IOURING:
             res = FTI_RecoverVarPOSIX(&FTI_Conf, &FTI_Exec, &FTI_Topo,
              FTI_Ckpt, FTI_Data, id, fileposix);
             break;
@@ -3036,6 +3303,7 @@ int FTI_RecoverVarFinalize() {
             break;
 
         case FTI_IO_POSIX:
+        case FTI_IO_IOURING:
             res = FTI_RecoverVarFinalizePOSIX(fileposix);
             break;
 
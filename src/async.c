@@ -0,0 +1,283 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  @file   async.c
+ *  @date   October, 2026
+ *  @brief  L1 checkpoints written by a background thread.
+ *
+ *  With 'Advanced:async_l1', FTI_Checkpoint copies the protected datasets
+ *  into a staging pool and returns. A background thread writes the copy
+ *  through the regular I/O backend of the level, while the application
+ *  continues and may modify its buffers. The metadata and post-processing
+ *  need collective operations, they are done by the application thread
+ *  when the checkpoint is completed, i.e. at the next checkpoint, before
+ *  a recovery or in FTI_Finalize. Until then, the previous L1 checkpoint
+ *  remains the one to recover from.
+ */
+
+#include "async.h"
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Writes the snapshot, executed by the background thread.
+  @param      arg             The background checkpoint.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_AsyncJob(void* arg) {
+    FTIT_asyncCkpt* async = (FTIT_asyncCkpt*) arg;
+    async->res = async->exec.ckptFunc[LOCAL](async->FTI_Conf, &async->exec,
+     async->FTI_Topo, async->FTI_Ckpt, async->data, &ftiIO[LOCAL]);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Starts the background writer.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      async           The background checkpoint.
+  @return     integer         FTI_SCES if successful.
+
+  If 'Advanced:async_pool_size' is set, the staging pool is allocated
+  here, otherwise it is sized to the protected data at the first
+  checkpoint and grown with it.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_AsyncInit(FTIT_configuration* FTI_Conf, FTIT_topology* FTI_Topo,
+ FTIT_checkpoint* FTI_Ckpt, FTIT_asyncCkpt* async) {
+    memset(async, 0, sizeof(FTIT_asyncCkpt));
+    if (!FTI_Conf->asyncL1 || FTI_Topo->amIaHead) {
+        return FTI_SCES;
+    }
+
+    async->FTI_Conf = FTI_Conf;
+    async->FTI_Topo = FTI_Topo;
+    async->FTI_Ckpt = FTI_Ckpt;
+
+    if (FTI_Conf->asyncPoolSize > 0) {
+        if (posix_memalign(&async->pool, FTI_ASYNC_ALIGN,
+         FTI_Conf->asyncPoolSize) != 0) {
+            FTI_Print("unable to allocate the staging pool of the background"
+             " checkpoints", FTI_EROR);
+            async->pool = NULL;
+            return FTI_NSCS;
+        }
+        async->poolSize = FTI_Conf->asyncPoolSize;
+    }
+    if (FTI_KeyMap(&async->data, sizeof(FTIT_dataset), FTI_Conf->maxVarId,
+     true) != FTI_SCES || FTI_WorkQueueInit(&async->queue, true) !=
+     FTI_SCES) {
+        free(async->pool);
+        FTI_KeyMapFree(&async->data);
+        memset(async, 0, sizeof(FTIT_asyncCkpt));
+        return FTI_NSCS;
+    }
+    async->active = true;
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Prepares the snapshot of the protected datasets.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      async           The background checkpoint.
+  @return     integer         FTI_SCES if the snapshot can be taken.
+
+  The copies of the datasets point into the staging pool, the data itself
+  is not copied yet. Device datasets are not supported. The local
+  temporary directory is created here, so that all the processes agree
+  on the result before writing.
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_AsyncPrepare(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data,
+ FTIT_asyncCkpt* async) {
+    FTIT_configuration* FTI_Conf = async->FTI_Conf;
+    FTIT_dataset* data;
+    int i;
+
+    MKDIR(FTI_Conf->lTmpDir, 0777);
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    int64_t size = 0;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        if (data[i].isDevicePtr) return FTI_NSCS;
+        size += ((data[i].size + FTI_ASYNC_ALIGN - 1) / FTI_ASYNC_ALIGN) *
+         FTI_ASYNC_ALIGN;
+    }
+
+    if (size > async->poolSize) {
+        if (FTI_Conf->asyncPoolSize > 0) {
+            FTI_Print("Protected data exceeds the staging pool"
+             " ('Advanced:async_pool_size').", FTI_DBUG);
+            return FTI_NSCS;
+        }
+        free(async->pool);
+        async->pool = NULL;
+        async->poolSize = 0;
+        if (posix_memalign(&async->pool, FTI_ASYNC_ALIGN, size) != 0) {
+            FTI_Print("unable to grow the staging pool of the background"
+             " checkpoints", FTI_WARN);
+            async->pool = NULL;
+            return FTI_NSCS;
+        }
+        async->poolSize = size;
+    }
+
+    if (FTI_KeyMap(&async->data, sizeof(FTIT_dataset), FTI_Conf->maxVarId,
+     true) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    int64_t offset = 0;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        FTIT_dataset copy = data[i];
+        copy.ptr = (char*) async->pool + offset;
+        if (async->data->push_back(async->data, &copy, copy.id) !=
+         FTI_SCES) {
+            return FTI_NSCS;
+        }
+        offset += ((data[i].size + FTI_ASYNC_ALIGN - 1) / FTI_ASYNC_ALIGN) *
+         FTI_ASYNC_ALIGN;
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Takes a snapshot and writes it in the background.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      async           The background checkpoint.
+  @return     integer         FTI_SCES if the checkpoint was started.
+
+  Only plain L1 checkpoints of the I/O modes writing the local files
+  with FTI_Write are taken in the background. If a process cannot take
+  the snapshot, all of them write the checkpoint synchronously. On
+  FTI_NSCS the caller writes the checkpoint itself.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_AsyncCkpt(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data,
+ FTIT_asyncCkpt* async) {
+    if (!async->active || async->pending) {
+        return FTI_NSCS;
+    }
+    FTIT_configuration* FTI_Conf = async->FTI_Conf;
+    if (FTI_Exec->ckptMeta.level != 1 || FTI_Exec->h5SingleFile ||
+     FTI_Conf->dcpPosix || FTI_Conf->dcpFtiff) {
+        return FTI_NSCS;
+    }
+    switch (FTI_Conf->ioMode) {
+        case FTI_IO_POSIX:
+        case FTI_IO_MPI:
+        case FTI_IO_IME:
+        case FTI_IO_IOURING:
+            break;
+        default:
+            return FTI_NSCS;
+    }
+
+    int res = FTI_AsyncPrepare(FTI_Exec, FTI_Data, async);
+    int allRes;
+    MPI_Allreduce(&res, &allRes, 1, MPI_INT, MPI_SUM, FTI_COMM_WORLD);
+    if (allRes != FTI_SCES) {
+        FTI_Print("Background checkpoint not possible, writing the"
+         " checkpoint synchronously.", FTI_DBUG);
+        return FTI_NSCS;
+    }
+
+    FTIT_dataset* data;
+    FTIT_dataset* copy;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES ||
+     async->data->data(async->data, &copy, FTI_Exec->nbVar) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    int i;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        memcpy(copy[i].ptr, data[i].ptr, data[i].size);
+    }
+
+    async->exec = *FTI_Exec;
+    async->res = FTI_NSCS;
+    async->pending = true;
+    if (FTI_WorkQueuePush(&async->queue, FTI_AsyncJob, async) != FTI_SCES) {
+        // the other processes are already writing in the background
+        FTI_AsyncJob(async);
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Waits for the background write and creates the metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      async           The background checkpoint.
+  @return     integer         FTI_SCES if the checkpoint was written.
+
+  Collective, the post-processing is left to the caller. The checkpoint
+  metadata and the positions of the datasets in the file are copied to
+  the execution metadata, the snapshot ('async->data') is kept until the
+  next background checkpoint.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_AsyncWait(FTIT_execution* FTI_Exec, FTIT_asyncCkpt* async) {
+    double t0 = MPI_Wtime();
+    FTI_WorkQueueDrain(&async->queue);
+    async->pending = false;
+
+    async->exec.timings = FTI_Exec->timings;
+    int res = FTI_CommitCkpt(async->FTI_Conf, &async->exec, async->FTI_Topo,
+     async->FTI_Ckpt, async->data, async->res, t0);
+    FTI_Exec->ckptMeta = async->exec.ckptMeta;
+    FTI_Exec->timings = async->exec.timings;
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Stops the background writer and frees the staging pool.
+  @param      async           The background checkpoint.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_AsyncFree(FTIT_asyncCkpt* async) {
+    if (!async->active) {
+        return;
+    }
+    FTI_WorkQueueFinalize(&async->queue);
+    FTI_KeyMapFree(&async->data);
+    free(async->pool);
+    memset(async, 0, sizeof(FTIT_asyncCkpt));
+}
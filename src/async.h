@@ -0,0 +1,38 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   async.h
+ */
+
+#ifndef FTI_SRC_ASYNC_H_
+#define FTI_SRC_ASYNC_H_
+
+#include "interface.h"
+
+/** Alignment of the datasets in the staging pool **/
+#define FTI_ASYNC_ALIGN 64
+
+/** L1 checkpoint written by the background thread **/
+typedef struct FTIT_asyncCkpt {
+    FTIT_workqueue          queue;      /**< Background writer            */
+    bool                    active;     /**< Background writes enabled    */
+    bool                    pending;    /**< Checkpoint not completed yet */
+    int                     res;        /**< Result of the write          */
+    FTIT_configuration*     FTI_Conf;
+    FTIT_topology*          FTI_Topo;
+    FTIT_checkpoint*        FTI_Ckpt;
+    FTIT_execution          exec;       /**< Execution state of snapshot  */
+    FTIT_keymap*            data;       /**< Snapshot of the datasets     */
+    void*                   pool;       /**< Staging pool                 */
+    int64_t                 poolSize;   /**< Size of the staging pool     */
+} FTIT_asyncCkpt;
+
+int FTI_AsyncInit(FTIT_configuration* FTI_Conf, FTIT_topology* FTI_Topo,
+ FTIT_checkpoint* FTI_Ckpt, FTIT_asyncCkpt* async);
+int FTI_AsyncCkpt(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data,
+ FTIT_asyncCkpt* async);
+int FTI_AsyncWait(FTIT_execution* FTI_Exec, FTIT_asyncCkpt* async);
+void FTI_AsyncFree(FTIT_asyncCkpt* async);
+
+#endif  // FTI_SRC_ASYNC_H_
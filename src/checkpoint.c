@@ -112,6 +112,92 @@ int FTI_UpdateIterTime(FTIT_execution* FTI_Exec) {
     return FTI_SCES;
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Recomputes the checkpoint interval of a level.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      level           Checkpoint level.
+  @return     integer         FTI_SCES if successful.
+
+  Uses the Daly higher-order estimate of the optimal interval from the
+  measured checkpoint cost C and the MTBF M of the level:
+  T = sqrt(2CM) * (1 + sqrt(C/2M)/3 + (C/2M)/9) - C for C < 2M, else M.
+  The first term is the Young estimate. The interval is rounded to the
+  minute used by FTI_Snapshot, and the level counter is reset so that the
+  next checkpoint of the level comes one interval after the current
+  minute. Levels disabled, without MTBF or without measured cost keep
+  their interval.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ScheduleLevel(FTIT_execution* FTI_Exec, FTIT_checkpoint* FTI_Ckpt,
+        int level) {
+    if (FTI_Ckpt[level].ckptIntv <= 0 || FTI_Ckpt[level].mtbf <= 0 ||
+     FTI_Ckpt[level].ckptCost <= 0) {
+        return FTI_SCES;
+    }
+
+    double cost = FTI_Ckpt[level].ckptCost;
+    double mtbf = FTI_Ckpt[level].mtbf * 60;
+    double intv = mtbf;
+    if (cost < 2 * mtbf) {
+        double ratio = cost / (2 * mtbf);
+        intv = sqrt(2 * cost * mtbf) * (1 + sqrt(ratio) / 3 + ratio / 9)
+         - cost;
+    }
+    int minutes = rint(intv / 60);
+    if (minutes < 1) {
+        minutes = 1;
+    }
+
+    if (minutes != FTI_Ckpt[level].ckptIntv) {
+        FTI_Ckpt[level].ckptIntv = minutes;
+        FTI_Ckpt[level].ckptCnt = FTI_Exec->minuteCnt / minutes + 1;
+        char str[FTI_BUFS];
+        snprintf(str, FTI_BUFS, "L%d ckpt. interval set to %d min. (cost:"
+         " %.2f sec., MTBF: %.1f min.)", level, minutes, cost,
+         FTI_Ckpt[level].mtbf);
+        FTI_Print(str, FTI_INFO);
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Updates the measured cost of a checkpoint level.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      level           Level of the checkpoint.
+  @param      cost            Local duration of the checkpoint (sec.).
+  @param      res             Result of the checkpoint.
+  @return     integer         FTI_SCES if successful.
+
+  The cost of a checkpoint is the time the slowest process spent in it,
+  writing and post-processing included. It is smoothed with an
+  exponential moving average, so the interval follows the drift of the
+  costs without jumping on a single slow checkpoint. Failed checkpoints
+  are not accounted. Collective over the application processes.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_UpdateCkptCost(FTIT_execution* FTI_Exec, FTIT_checkpoint* FTI_Ckpt,
+        int level, double cost, int res) {
+    double local[2] = { cost, (res != FTI_SCES) }, global[2];
+    MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MAX, FTI_COMM_WORLD);
+    if (global[1] > 0 || level < 1 || level > 4) {
+        return FTI_NSCS;
+    }
+
+    if (FTI_Ckpt[level].ckptCost <= 0) {
+        FTI_Ckpt[level].ckptCost = global[0];
+    } else {
+        FTI_Ckpt[level].ckptCost = FTI_CKPT_COST_WEIGHT * global[0] +
+         (1 - FTI_CKPT_COST_WEIGHT) * FTI_Ckpt[level].ckptCost;
+    }
+    return FTI_ScheduleLevel(FTI_Exec, FTI_Ckpt, level);
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It writes the checkpoint data in the target file.
@@ -145,6 +231,7 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             MPI_Barrier(FTI_COMM_WORLD);
         }
     }
+    double t0 = MPI_Wtime();
     // If checkpoint is inlin and level 4 save directly to PFS
     int res;  // response from writing funcitons
     int offset = 2*(FTI_Conf->dcpPosix || FTI_Conf->dcpFtiff);
@@ -169,11 +256,38 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         res = FTI_Exec->ckptFunc[LOCAL](FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
          FTI_Data, &ftiIO[offset + LOCAL]);
     }
+    FTI_TraceSpan("ckpt", "WriteCkpt", t0, FTI_Exec->ckptMeta.level);
+
+    return FTI_CommitCkpt(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt, FTI_Data,
+     res, t0);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Creates the metadata of a written checkpoint.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      res             Result of the local write.
+  @param      t0              Time at which the write started.
+  @return     integer         FTI_SCES if successful.
+
+  The checkpoint is only valid if every process wrote its file. Called
+  once the files are written, by FTI_WriteCkpt or when a background
+  checkpoint is completed.
 
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_CommitCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data, int res, double t0) {
     // Check if all processes have written correctly
     // (every process must succeed)
     int allRes;
     MPI_Allreduce(&res, &allRes, 1, MPI_INT, MPI_SUM, FTI_COMM_WORLD);
+    FTI_Exec->timings.write = MPI_Wtime() - t0;
     if (allRes != FTI_SCES) {
         return FTI_NSCS;
     } else if (FTI_Exec->h5SingleFile) {
@@ -182,15 +296,16 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     if ((FTI_Conf->dcpFtiff || FTI_Conf->dcpPosix) && FTI_Ckpt[4].isDcp) {
         // After dCP update store total data and dCP
         // sizes in application rank 0
-        uint32_t *dataSize = (FTI_Conf->dcpFtiff)?
-        (uint32_t*)&FTI_Exec->FTIFFMeta.pureDataSize:
+        uint64_t *dataSize = (FTI_Conf->dcpFtiff)?
+        (uint64_t*)&FTI_Exec->FTIFFMeta.pureDataSize:
         &FTI_Exec->dcpInfoPosix.dataSize;
-        uint32_t *dcpSize = (FTI_Conf->dcpFtiff)?
-        (uint32_t*)&FTI_Exec->FTIFFMeta.dcpSize:
+        uint64_t *dcpSize = (FTI_Conf->dcpFtiff)?
+        (uint64_t*)&FTI_Exec->FTIFFMeta.dcpSize:
         &FTI_Exec->dcpInfoPosix.dcpSize;
-        uint32_t dcpStats[2];  // 0:totalDcpSize, 1:totalDataSize
-        uint32_t sendBuf[] = { *dcpSize, *dataSize };
-        MPI_Reduce(sendBuf, dcpStats, 2, MPI_UINT32_T, MPI_SUM, 0,
+        FTI_MetricsDcp(FTI_Exec, *dataSize, *dcpSize);
+        uint64_t dcpStats[2];  // 0:totalDcpSize, 1:totalDataSize
+        uint64_t sendBuf[] = { *dcpSize, *dataSize };
+        MPI_Reduce(sendBuf, dcpStats, 2, MPI_UINT64_T, MPI_SUM, 0,
          FTI_COMM_WORLD);
         if (FTI_Topo->splitRank ==  0) {
             *dcpSize = dcpStats[0];
@@ -198,8 +313,11 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         }
     }
 
+    double t1 = MPI_Wtime();
     res = FTI_Try(FTI_CreateMetadata(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
      FTI_Data), "create metadata.");
+    FTI_Exec->timings.hash = MPI_Wtime() - t1;
+    FTI_TraceSpan("ckpt", "CreateMetadata", t1, FTI_Exec->ckptMeta.ckptId);
 
     if ((FTI_Conf->dcpFtiff || FTI_Conf->keepL4Ckpt) &&
         (FTI_Topo->splitRank == 0)) {
@@ -216,6 +334,7 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
   @param      FTI_Exec        Execution metadata.
   @param      FTI_Topo        Topology metadata.
   @param      FTI_Ckpt        Checkpoint metadata.
+  @param      FTI_Data        Dataset metadata, NULL if not in memory.
   @return     integer         FTI_SCES if successful.
 
   This function launches the required action dependeing on the ckpt. level.
@@ -227,7 +346,8 @@ int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt) {
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data) {
     char str[FTI_BUFS];  // For console output
 
     double t1 = MPI_Wtime();  // Start time
@@ -236,15 +356,19 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     switch (FTI_Exec->ckptMeta.level) {
         case 4:
             res = FTI_Flush(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt, 0);
+            FTI_TraceSpan("post", "Flush", t1, 4);
             break;
         case 3:
             res = FTI_RSenc(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt);
+            FTI_TraceSpan("post", "RSenc", t1, 3);
             break;
         case 2:
-            res = FTI_Ptner(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt);
+            res = FTI_Ptner(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt, FTI_Data);
+            FTI_TraceSpan("post", "Ptner", t1, 2);
             break;
         case 1:
             res = FTI_Local(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt);
+            FTI_TraceSpan("post", "Local", t1, 1);
             break;
     }
 
@@ -260,6 +384,16 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     double t2 = MPI_Wtime();  // Post-processing time
 
+    if (FTI_Exec->ckptMeta.level == 4) {
+        FTI_Exec->timings.flush = t2 - t1;
+    } else {
+        FTI_Exec->timings.post = t2 - t1;
+    }
+    if (FTI_Exec->ckptMeta.level >= 1 && FTI_Exec->ckptMeta.level <= 4) {
+        FTI_MetricsLatency(&FTI_Exec->metrics.post[FTI_Exec->ckptMeta.level],
+         t2 - t1);
+    }
+
     if (FTI_Exec->h5SingleFile) {
         double t3 = MPI_Wtime();  // Post-processing time
 
@@ -291,7 +425,8 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 // In case of Level 4 Checkpoint We keep a
                 // copy of the global checkpoint file
                 // on the local persistent memory
-                if (FTI_Conf->ioMode != FTI_IO_POSIX) {
+                if (FTI_Conf->ioMode != FTI_IO_POSIX &&
+                 FTI_Conf->ioMode != FTI_IO_IOURING) {
                     RENAME(FTI_Conf->lTmpDir, FTI_Ckpt[4].L4Replica);
                 } else {
                     RENAME(FTI_Conf->lTmpDir, FTI_Ckpt[1].dir);
@@ -317,6 +452,7 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                                   // be needed in next checkpoint)
 
     double t3 = MPI_Wtime();  // Renaming directories time
+    FTI_TraceSpan("post", "PostCkpt", t1, FTI_Exec->ckptMeta.level);
 
     snprintf(str, FTI_BUFS, "Post-checkpoint took %.2f sec."
         " (Pt:%.2fs, Cl:%.2fs)",
@@ -329,6 +465,61 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     return FTI_SCES;
 }
 
+/** Stage request queued for the staging thread of the head **/
+typedef struct FTIT_headStageJob {
+    FTIT_configuration* FTI_Conf;
+    FTIT_execution*     FTI_Exec;
+    FTIT_topology*      FTI_Topo;
+    FTIT_StageJob       request;
+} FTIT_headStageJob;
+
+static void FTI_HeadStageJob(void* arg) {
+    FTIT_headStageJob* job = (FTIT_headStageJob*) arg;
+    double t0 = FTI_TraceStart();
+    FTI_ProcessStageRequest(job->FTI_Conf, job->FTI_Exec, job->FTI_Topo,
+     &job->request);
+    FTI_TraceSpan("stage", "Stage", t0, job->request.ID);
+    free(job);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Waits before the next poll of an idle head.
+  @param      FTI_Conf        Configuration metadata.
+  @param      idle            Current wait in microseconds (in/out).
+  @return     void
+
+  The wait starts at 1us and doubles up to 'Advanced:idle_sleep', it
+  is reset by the caller as soon as a request is received. The head thus
+  answers immediately under load and leaves its core to the application
+  when there is nothing to do.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_HeadBackoff(FTIT_configuration* FTI_Conf, int* idle) {
+    if (FTI_Conf->headIdleSleep == 0) {
+        return;
+    }
+    *idle = (*idle == 0) ? 1 : 2 * (*idle);
+    if (*idle > FTI_Conf->headIdleSleep) {
+        *idle = FTI_Conf->headIdleSleep;
+    }
+    struct timespec ts;
+    ts.tv_sec = *idle / 1000000;
+    ts.tv_nsec = (*idle % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+/* Updates the depth of the staging queue of the head in its metrics. */
+static void FTI_HeadQueueDepth(FTIT_execution* FTI_Exec,
+ FTIT_workqueue* queue) {
+    FTIT_metrics* metrics = &FTI_Exec->metrics;
+    metrics->headQueue = FTI_WorkQueuePending(queue);
+    if (metrics->headQueue > metrics->headQueueMax) {
+        metrics->headQueueMax = metrics->headQueue;
+    }
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It listens for checkpoint notifications.
@@ -341,6 +532,11 @@ int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
   and takes the required actions after notification. This function is only
   executed by the head of the nodes and its complementary with the
   FTI_Checkpoint function in terms of communications.
+
+  The head only receives the stage requests here, the files are copied by
+  its staging thread ('Advanced:staging_thread') so that checkpoint
+  requests are not delayed by staging. When no message is pending, the
+  head sleeps with an exponential back-off instead of spinning.
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
@@ -351,10 +547,17 @@ int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     int ckpt_flag = 0;
     int stage_flag = 0;
     int finalize_flag = 0;
+    int idle = 0;
+
+    FTIT_workqueue stageQueue;
+    FTI_WorkQueueInit(&stageQueue, FTI_Conf->stagingEnabled &&
+     FTI_Conf->headStageThread);
 
     FTI_Print("Head starts listening...", FTI_DBUG);
     while (1) {  // heads can stop only by receiving FTI_ENDW
-        FTI_Print("Head waits for message...", FTI_DBUG);
+        if (idle == 0) {
+            FTI_Print("Head waits for message...", FTI_DBUG);
+        }
         MPI_Iprobe(MPI_ANY_SOURCE, FTI_Conf->finalTag, FTI_Exec->globalComm,
          &finalize_flag, &finalize_status);
         if (FTI_Conf->stagingEnabled) {
@@ -367,17 +570,29 @@ int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             // head will process the whole checkpoint
             // (treated second due to priority)
             FTI_HandleCkptRequest(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt);
+            FTI_HeadQueueDepth(FTI_Exec, &stageQueue);
+            FTI_MetricsDump(FTI_Conf, FTI_Exec, FTI_Topo, false);
             ckpt_flag = 0;
+            idle = 0;
             continue;
         }
 
         if (stage_flag) {
-            // head will process each unstage request on its own
-            // [A MAYBE: we could interrupt the unstageing process if
-            // we receive a checkpoint request.]
-            FTI_HandleStageRequest(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
-             stage_status.MPI_SOURCE);
+            // the request is queued and the head goes back to listening,
+            // the staging thread copies the file meanwhile.
+            FTIT_headStageJob* job = talloc(FTIT_headStageJob, 1);
+            if (FTI_RecvStageRequest(FTI_Conf, FTI_Exec,
+             stage_status.MPI_SOURCE, &job->request) == FTI_SCES) {
+                job->FTI_Conf = FTI_Conf;
+                job->FTI_Exec = FTI_Exec;
+                job->FTI_Topo = FTI_Topo;
+                FTI_WorkQueuePush(&stageQueue, FTI_HeadStageJob, job);
+                FTI_HeadQueueDepth(FTI_Exec, &stageQueue);
+            } else {
+                free(job);
+            }
             stage_flag = 0;
+            idle = 0;
             continue;
         }
 
@@ -404,6 +619,9 @@ int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 FTI_Print("Inconsistency in Finalize request.", FTI_WARN);
             }
 
+            // the staging files are removed at finalization
+            FTI_WorkQueueFinalize(&stageQueue);
+
             FTI_Print("Head stopped listening.", FTI_DBUG);
             FTI_Finalize();
 
@@ -411,6 +629,8 @@ int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 break;
             }
         }
+
+        FTI_HeadBackoff(FTI_Conf, &idle);
     }
     // will be reached only if keepHeadsAlive is TRUE
     return FTI_SCES;
@@ -483,8 +703,8 @@ int FTI_HandleCkptRequest(FTIT_configuration* FTI_Conf,
     MPI_Allreduce(&res, &allRes, 1, MPI_INT, MPI_SUM, FTI_COMM_WORLD);
     if (allRes == FTI_SCES) {
         // If checkpoint was written correctly do post-processing
-        res = FTI_Try(FTI_PostCkpt(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt),
-            "postprocess the checkpoint.");
+        res = FTI_Try(FTI_PostCkpt(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
+         NULL), "postprocess the checkpoint.");
         if (res == FTI_SCES) {
             // send checkpoint level if post-processing succeeds
             res = FTI_Exec->ckptMeta.level;
@@ -516,31 +736,81 @@ int FTI_HandleCkptRequest(FTIT_configuration* FTI_Conf,
 
   This function performs a normal checkpoint by calling the respective file format procedures,
   initalize ckpt, write data, compute integrity and finalize files.
+  If 'write_threads' is set and the backend provides the positional write
+  hooks, the data is written by the pipelined writer (FTI_PipelineWrite).
+  Datasets with a codec are encoded before the file is initialized, so the
+  backends see the size of the encoded checkpoint ('encodedSize').
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_Write(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
         FTIT_keymap* FTI_Data, FTIT_IO *io) {
     int i;
+    FTIT_codecBuffer* enc;
+    double t0 = FTI_TraceStart();
+    if (FTI_CodecEncode(FTI_Conf, FTI_Exec, FTI_Ckpt, FTI_Data, &enc)
+     != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (enc != NULL) {
+        FTI_TraceSpan("ckpt", "Encode", t0, FTI_Exec->nbVar);
+    }
+
     void *write_info = io->initCKPT(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
      FTI_Data);
     if (!write_info) {
         FTI_Print("unable to initialize checkpoint!", FTI_EROR);
+        FTI_CodecFree(enc, FTI_Exec->nbVar);
         return FTI_NSCS;
     }
 
-    FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_PipelineSupported(FTI_Conf, io)) {
+        t0 = FTI_TraceStart();
+        if (FTI_PipelineWrite(FTI_Conf, FTI_Exec, FTI_Data, io, write_info,
+         enc) != FTI_SCES) {
+            io->finCKPT(write_info);
+            free(write_info);
+            FTI_CodecFree(enc, FTI_Exec->nbVar);
+            return FTI_NSCS;
+        }
+        FTI_TraceSpan("ckpt", "PipelineWrite", t0, FTI_Exec->nbVar);
+    } else {
+        FTIT_dataset* data;
+        if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES) {
+            FTI_CodecFree(enc, FTI_Exec->nbVar);
+            return FTI_NSCS;
+        }
 
-    for (i = 0; i < FTI_Exec->nbVar; i++) {
-        data[i].filePos = io->getPos(write_info);
-        int ret = io->WriteData(&data[i], write_info);
-        if (ret != FTI_SCES)
-            return ret;
+        for (i = 0; i < FTI_Exec->nbVar; i++) {
+            data[i].filePos = io->getPos(write_info);
+            t0 = FTI_TraceStart();
+            int ret;
+            if (enc != NULL && enc[i].ptr != NULL) {
+                // the backends write 'size' bytes from 'ptr'
+                FTIT_dataset encoded = data[i];
+                encoded.ptr = enc[i].ptr;
+                encoded.size = enc[i].size;
+                ret = io->WriteData(&encoded, write_info);
+            } else {
+                ret = io->WriteData(&data[i], write_info);
+            }
+            FTI_TraceSpan("ckpt", "WriteData", t0, data[i].id);
+            if (ret != FTI_SCES) {
+                FTI_CodecFree(enc, FTI_Exec->nbVar);
+                return ret;
+            }
+        }
     }
+    FTI_CodecFree(enc, FTI_Exec->nbVar);
 
+    t0 = FTI_TraceStart();
     io->finIntegrity(FTI_Exec->integrity, write_info);
-    io->finCKPT(write_info);
+    FTI_TraceSpan("ckpt", "Integrity", t0, -1);
+    // asynchronous backends report write errors when the file is closed
+    if (io->finCKPT(write_info) != FTI_SCES) {
+        free(write_info);
+        return FTI_NSCS;
+    }
     free(write_info);
     return FTI_SCES;
 }
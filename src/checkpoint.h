@@ -10,12 +10,23 @@
 
 #include "interface.h"
 
+/** Weight of the last measured cost in the smoothed ckpt. cost **/
+#define FTI_CKPT_COST_WEIGHT 0.3
+
 int FTI_UpdateIterTime(FTIT_execution* FTI_Exec);
+int FTI_UpdateCkptCost(FTIT_execution* FTI_Exec, FTIT_checkpoint* FTI_Ckpt,
+        int level, double cost, int res);
+int FTI_ScheduleLevel(FTIT_execution* FTI_Exec, FTIT_checkpoint* FTI_Ckpt,
+        int level);
 int FTI_WriteCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
         FTIT_keymap* FTI_Data);
+int FTI_CommitCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data, int res, double t0);
 int FTI_PostCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt);
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data);
 int FTI_Listen(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt);
 int FTI_HandleCkptRequest(FTIT_configuration* FTI_Conf,
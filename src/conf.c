@@ -152,6 +152,13 @@ int FTI_ReadConf(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     FTI_Ckpt[2].ckptCnt  = 1;
     FTI_Ckpt[3].ckptCnt  = 1;
     FTI_Ckpt[4].ckptCnt  = 1;
+    int level;
+    for (level = 1; level < 5; level++) {
+        char key[FTI_BUFS];
+        snprintf(key, FTI_BUFS, "Advanced:mtbf_l%d", level);
+        FTI_Ckpt[level].mtbf = iniparser_getdouble(ini, key, 0);
+        FTI_Ckpt[level].ckptCost = 0;
+    }
     FTI_Ckpt[4].ckptDcpCnt  = 1;
 
     FTI_Conf->stagingEnabled = (bool)iniparser_getboolean(ini,
@@ -195,6 +202,52 @@ int FTI_ReadConf(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
      "Advanced:block_size", -1) * 1024;
     FTI_Conf->transferSize = (int)iniparser_getint(ini,
      "Advanced:transfer_size", -1) * 1024 * 1024;
+    FTI_Conf->transferZeroCopy = (bool)iniparser_getboolean(ini,
+     "Advanced:transfer_zero_copy", 1);
+    FTI_Conf->transferFadvise = (bool)iniparser_getboolean(ini,
+     "Advanced:transfer_fadvise", 0);
+    FTI_Conf->transferThreads = (int)iniparser_getint(ini,
+     "Advanced:transfer_threads", 1);
+    FTI_Conf->metaFormat = (int)iniparser_getint(ini,
+     "Advanced:meta_format", FTI_META_INI);
+    FTI_Conf->writeThreads = (int)iniparser_getint(ini,
+     "Advanced:write_threads", 0);
+    FTI_Conf->writeQueueDepth = (int)iniparser_getint(ini,
+     "Advanced:write_queue_depth", -1);
+    FTI_Conf->writeChunkSize = (size_t)iniparser_getlint(ini,
+     "Advanced:write_chunk_size", 4096) * 1024;
+    FTI_Conf->codec = (int)iniparser_getint(ini,
+     "Advanced:codec", FTI_CODEC_NONE);
+    FTI_Conf->zlibLevel = (int)iniparser_getint(ini,
+     "Advanced:zlib_level", 1);
+    FTI_Conf->compressThreads = (int)iniparser_getint(ini,
+     "Advanced:compress_threads", 1);
+    FTI_Conf->readThreads = (int)iniparser_getint(ini,
+     "Advanced:read_threads", 1);
+    FTI_Conf->uringDepth = (int)iniparser_getint(ini,
+     "Advanced:uring_depth", 8);
+    FTI_Conf->uringBufferSize = (size_t)iniparser_getlint(ini,
+     "Advanced:uring_buffer_size", 1024) * 1024;
+    FTI_Conf->uringDirect = (bool)iniparser_getboolean(ini,
+     "Advanced:uring_direct", 0);
+    FTI_Conf->asyncL1 = (bool)iniparser_getboolean(ini,
+     "Advanced:async_l1", 0);
+    FTI_Conf->asyncPoolSize = (int64_t)iniparser_getlint(ini,
+     "Advanced:async_pool_size", 0) * 1024 * 1024;
+    FTI_Conf->l2FromMemory = (bool)iniparser_getboolean(ini,
+     "Advanced:l2_from_memory", 0);
+    FTI_Conf->ckptScheduler = (bool)iniparser_getboolean(ini,
+     "Advanced:ckpt_scheduler", 0);
+    par = iniparser_getstring(ini, "Advanced:trace_dir", "");
+    snprintf(FTI_Conf->traceDir, FTI_BUFS, "%s", par);
+    par = iniparser_getstring(ini, "Advanced:metrics_dir", "");
+    snprintf(FTI_Conf->metricsDir, FTI_BUFS, "%s", par);
+    FTI_Conf->metricsIntv = (int)iniparser_getint(ini,
+     "Advanced:metrics_intv", 60);
+    FTI_Conf->dedup = (bool)iniparser_getboolean(ini,
+     "Advanced:dedup", 0);
+    FTI_Conf->dedupBlockSize = (size_t)iniparser_getlint(ini,
+     "Advanced:dedup_block_size", 64) * 1024;
     FTI_Conf->ckptTag = (int)iniparser_getint(ini,
      "Advanced:ckpt_tag", 711);
     FTI_Conf->stageTag = (int)iniparser_getint(ini,
@@ -203,11 +256,21 @@ int FTI_ReadConf(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
      "Advanced:final_tag", 3107);
     FTI_Conf->generalTag = (int)iniparser_getint(ini,
      "Advanced:general_tag", 2612);
+    FTI_Conf->headIdleSleep = (int)iniparser_getint(ini,
+     "Advanced:idle_sleep", 1000);
+    FTI_Conf->headStageThread = (bool)iniparser_getboolean(ini,
+     "Advanced:staging_thread", 1);
     FTI_Conf->test = (int)iniparser_getint(ini, "Advanced:local_test", -1);
-    FTI_Conf->l3WordSize = FTI_WORD;
+    FTI_Conf->l3WordSize = (int)iniparser_getint(ini,
+     "Advanced:l3_word_size", FTI_WORD);
+    FTI_Conf->l3Code = (int)iniparser_getint(ini, "Advanced:l3_code",
+     FTI_L3_RS);
+    FTI_Conf->l3Threads = (int)iniparser_getint(ini,
+     "Advanced:l3_threads", 1);
     FTI_Conf->ioMode = (int)iniparser_getint(ini, "Basic:ckpt_io", 0) + 1000;
     // Enable either dcp for posix of ftiff depending on the selected io
-    if (FTI_Conf->ioMode == FTI_IO_POSIX) {
+    if (FTI_Conf->ioMode == FTI_IO_POSIX ||
+     FTI_Conf->ioMode == FTI_IO_IOURING) {
         FTI_Conf->dcpPosix = dcpEnabled;
         FTI_Conf->dcpInfoPosix.BlockSize = FTI_Conf->dcpBlockSize;
         // FTI_Exec->dcpInfoPosix.LayerSize = (unsigned long*)
@@ -429,6 +492,124 @@ CHECK_DCP_SETTING_END:
         " file.", FTI_WARN);
         FTI_Conf->transferSize = 16 * 1024 * 1024;
     }
+    if (FTI_Conf->transferThreads < 1 || FTI_Conf->transferThreads > 64) {
+        FTI_Print("Transfer threads ('Advanced:transfer_threads') must be"
+        " between 1 and 64. Set to default (1 thread).", FTI_WARN);
+        FTI_Conf->transferThreads = 1;
+    }
+    if (FTI_Conf->metaFormat != FTI_META_INI &&
+     FTI_Conf->metaFormat != FTI_META_BIN) {
+        FTI_Print("Metadata format ('Advanced:meta_format') must be 0 (INI)"
+        " or 1 (binary). Set to default (INI).", FTI_WARN);
+        FTI_Conf->metaFormat = FTI_META_INI;
+    }
+    if (FTI_Conf->headIdleSleep < 0 || FTI_Conf->headIdleSleep > 1000000) {
+        FTI_Print("Head idle sleep ('Advanced:idle_sleep') must be"
+        " between 0 and 1000000 us. Set to default (1000 us).", FTI_WARN);
+        FTI_Conf->headIdleSleep = 1000;
+    }
+    if (FTI_Conf->metricsIntv < 0) {
+        FTI_Print("Metrics interval ('Advanced:metrics_intv') must be"
+        " positive. Set to default (60 sec.).", FTI_WARN);
+        FTI_Conf->metricsIntv = 60;
+    }
+    if (FTI_Conf->dedupBlockSize < 4 * 1024 ||
+     FTI_Conf->dedupBlockSize > 16 * 1024 * 1024) {
+        FTI_Print("Dedup block size ('Advanced:dedup_block_size') must be"
+        " between 4 and 16384 KB. Set to default (64 KB).", FTI_WARN);
+        FTI_Conf->dedupBlockSize = 64 * 1024;
+    }
+    if (FTI_Conf->l3Threads < 1 || FTI_Conf->l3Threads > 64) {
+        FTI_Print("L3 threads ('Advanced:l3_threads') must be between"
+        " 1 and 64. Set to default (1 thread).", FTI_WARN);
+        FTI_Conf->l3Threads = 1;
+    }
+    if (FTI_Conf->l3WordSize != 8 && FTI_Conf->l3WordSize != 16 &&
+     FTI_Conf->l3WordSize != 32) {
+        FTI_Print("L3 word size ('Advanced:l3_word_size') must be 8, 16 or"
+        " 32. Set to default (16).", FTI_WARN);
+        FTI_Conf->l3WordSize = FTI_WORD;
+    }
+    if (FTI_Conf->l3Code != FTI_L3_RS && FTI_Conf->l3Code != FTI_L3_CAUCHY) {
+        FTI_Print("L3 code ('Advanced:l3_code') must be 0 (RS) or 1"
+        " (Cauchy). Set to default (RS).", FTI_WARN);
+        FTI_Conf->l3Code = FTI_L3_RS;
+    }
+    // the Cauchy code encodes units of w packets
+    int unit = FTI_Conf->l3WordSize * FTI_L3_PACKET;
+    if (FTI_Conf->l3Code == FTI_L3_CAUCHY && FTI_Conf->blockSize % unit) {
+        char str[FTI_BUFS];
+        snprintf(str, FTI_BUFS, "The L3 Cauchy code needs a block size"
+        " multiple of %d KB. Set to default (RS).", unit / 1024);
+        FTI_Print(str, FTI_WARN);
+        FTI_Conf->l3Code = FTI_L3_RS;
+    }
+    if (FTI_Conf->writeThreads < 0 || FTI_Conf->writeThreads > 64) {
+        FTI_Print("Write threads ('Advanced:write_threads') must be between"
+        " 0 and 64. Pipelined writes disabled.", FTI_WARN);
+        FTI_Conf->writeThreads = 0;
+    }
+    if (FTI_Conf->writeThreads > 0) {
+        if (FTI_Conf->writeChunkSize < (64 * 1024)) {
+            FTI_Print("Write chunk size ('Advanced:write_chunk_size') must be"
+            " at least 64 KB. Set to default (4096 KB).", FTI_WARN);
+            FTI_Conf->writeChunkSize = 4096 * 1024;
+        }
+        if (FTI_Conf->writeQueueDepth < FTI_Conf->writeThreads + 1) {
+            FTI_Conf->writeQueueDepth = 2 * FTI_Conf->writeThreads + 2;
+        }
+    }
+    if (FTI_Conf->codec & ~(FTI_CODEC_ZLIB | FTI_CODEC_SHUFFLE)) {
+        FTI_Print("Codec ('Advanced:codec') must be 0 (none), 1 (zlib),"
+        " 2 (shuffle) or 3 (shuffle and zlib). Codec disabled.", FTI_WARN);
+        FTI_Conf->codec = FTI_CODEC_NONE;
+    }
+    if (FTI_Conf->codec != FTI_CODEC_NONE &&
+     FTI_Conf->ioMode != FTI_IO_POSIX && FTI_Conf->ioMode != FTI_IO_MPI &&
+     FTI_Conf->ioMode != FTI_IO_IME && FTI_Conf->ioMode != FTI_IO_IOURING) {
+        FTI_Print("Codec ('Advanced:codec') is only supported with the POSIX,"
+        " MPI-IO, IME and io_uring I/O modes. Codec disabled.", FTI_WARN);
+        FTI_Conf->codec = FTI_CODEC_NONE;
+    }
+#ifdef FTI_NOZLIB
+    if (FTI_Conf->codec & FTI_CODEC_ZLIB) {
+        FTI_Print("FTI was built without zlib, the zlib codec"
+        " ('Advanced:codec') is disabled.", FTI_WARN);
+        FTI_Conf->codec &= ~FTI_CODEC_ZLIB;
+    }
+#endif
+    if (FTI_Conf->zlibLevel < 1 || FTI_Conf->zlibLevel > 9) {
+        FTI_Print("Zlib level ('Advanced:zlib_level') must be between"
+        " 1 and 9. Set to default (1).", FTI_WARN);
+        FTI_Conf->zlibLevel = 1;
+    }
+    if (FTI_Conf->compressThreads < 1 || FTI_Conf->compressThreads > 64) {
+        FTI_Print("Compress threads ('Advanced:compress_threads') must be"
+        " between 1 and 64. Set to default (1).", FTI_WARN);
+        FTI_Conf->compressThreads = 1;
+    }
+    if (FTI_Conf->readThreads < 1 || FTI_Conf->readThreads > 64) {
+        FTI_Print("Read threads ('Advanced:read_threads') must be between"
+        " 1 and 64. Set to default (1).", FTI_WARN);
+        FTI_Conf->readThreads = 1;
+    }
+    if (FTI_Conf->uringDepth < 1 || FTI_Conf->uringDepth > 256) {
+        FTI_Print("io_uring depth ('Advanced:uring_depth') must be between"
+        " 1 and 256. Set to default (8).", FTI_WARN);
+        FTI_Conf->uringDepth = 8;
+    }
+    if (FTI_Conf->uringBufferSize < 4096 ||
+     FTI_Conf->uringBufferSize % 4096 != 0) {
+        FTI_Print("io_uring buffer size ('Advanced:uring_buffer_size') must"
+        " be a positive multiple of 4 (KB). Set to default (1024).",
+         FTI_WARN);
+        FTI_Conf->uringBufferSize = 1024 * 1024;
+    }
+    if (FTI_Conf->asyncPoolSize < 0) {
+        FTI_Print("Staging pool size ('Advanced:async_pool_size') must be"
+        " positive or 0. Set to default (0).", FTI_WARN);
+        FTI_Conf->asyncPoolSize = 0;
+    }
     if (FTI_Conf->test != 0 && FTI_Conf->test != 1) {
         FTI_Print("Local test size needs to be set to 0 or 1.", FTI_WARN);
         return FTI_NSCS;
@@ -450,6 +631,13 @@ CHECK_DCP_SETTING_END:
              FTI_WARN);
             return FTI_NSCS;
         }
+        if (FTI_Ckpt[i].mtbf < 0) {
+            char str[FTI_BUFS];
+            snprintf(str, FTI_BUFS, "MTBF ('Advanced:mtbf_l%d') must be"
+            " positive or 0. Set to default (0).", i);
+            FTI_Print(str, FTI_WARN);
+            FTI_Ckpt[i].mtbf = 0;
+        }
     }
     if (FTI_Conf->h5SingleFileIsInline == 0 && FTI_Topo->nbHeads != 1) {
         FTI_Print("If h5_single_file_inline is set to 0 then head must be"
@@ -496,6 +684,20 @@ CHECK_DCP_SETTING_END:
         case FTI_IO_FTIFF:
             FTI_Print("Selected Ckpt I/O is FTI-FF", FTI_INFO);
             break;
+        case FTI_IO_IOURING:
+#ifdef ENABLE_IOURING  // --> If the kernel headers provide io_uring
+            if (FTI_UringProbe() == FTI_SCES) {
+                FTI_Print("Selected Ckpt I/O is io_uring", FTI_INFO);
+                break;
+            }
+            FTI_Print("Selected Ckpt I/O is io_uring, but the kernel does"
+                " not support it. Setting IO mode to POSIX.", FTI_WARN);
+#else
+            FTI_Print("Selected Ckpt I/O is io_uring, but io_uring is not"
+                " enabled. Setting IO mode to POSIX.", FTI_WARN);
+#endif
+            FTI_Conf->ioMode = FTI_IO_POSIX;
+            break;
 #ifdef ENABLE_SIONLIB  // --> If SIONlib is installed
         case FTI_IO_SIONLIB:
             FTI_Print("Selected Ckpt I/O is SIONLIB", FTI_INFO);
@@ -427,13 +427,13 @@ int iniparser_getint(dictionary * d, const char * key, int notfound)
   slightly modified to return long instead of int.
  */
 /*--------------------------------------------------------------------------*/
-int32_t iniparser_getlint(dictionary * d, const char * key, int notfound)
+int64_t iniparser_getlint(dictionary * d, const char * key, int notfound)
 {
     char    *   str ;
 
     str = iniparser_getstring(d, key, INI_INVALID_KEY);
     if (str==INI_INVALID_KEY) return notfound ;
-    return strtol(str, NULL, 0);
+    return strtoll(str, NULL, 0);
 }
 
 /*-------------------------------------------------------------------------*/
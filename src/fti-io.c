@@ -79,12 +79,18 @@ int FTI_InitFunctionPointers(int ckptIO, FTIT_execution * FTI_Exec) {
             ftiIO[LOCAL].finCKPT = FTI_PosixClose;
             ftiIO[LOCAL].getPos = FTI_GetPosixFilePos;
             ftiIO[LOCAL].finIntegrity = FTI_PosixMD5;
+            ftiIO[LOCAL].setPos = FTI_PosixSeek;
+            ftiIO[LOCAL].WriteAt = FTI_PosixWriteAt;
+            ftiIO[LOCAL].updIntegrity = FTI_PosixUpdateMD5;
 
             ftiIO[GLOBAL].initCKPT = FTI_InitPosix;
             ftiIO[GLOBAL].WriteData = FTI_WritePosixData;
             ftiIO[GLOBAL].finCKPT = FTI_PosixClose;
             ftiIO[GLOBAL].getPos = FTI_GetPosixFilePos;
             ftiIO[GLOBAL].finIntegrity = FTI_PosixMD5;
+            ftiIO[GLOBAL].setPos = FTI_PosixSeek;
+            ftiIO[GLOBAL].WriteAt = FTI_PosixWriteAt;
+            ftiIO[GLOBAL].updIntegrity = FTI_PosixUpdateMD5;
 
 
             ftiIO[2 + LOCAL].initCKPT = FTI_InitDCPPosix;
@@ -123,6 +129,9 @@ int FTI_InitFunctionPointers(int ckptIO, FTIT_execution * FTI_Exec) {
             ftiIO[LOCAL].finCKPT      = FTI_PosixClose;
             ftiIO[LOCAL].getPos       = FTI_GetPosixFilePos;
             ftiIO[LOCAL].finIntegrity = FTI_PosixMD5;
+            ftiIO[LOCAL].setPos = FTI_PosixSeek;
+            ftiIO[LOCAL].WriteAt = FTI_PosixWriteAt;
+            ftiIO[LOCAL].updIntegrity = FTI_PosixUpdateMD5;
 
             ftiIO[GLOBAL].initCKPT     = FTI_InitIME;
             ftiIO[GLOBAL].WriteData    = FTI_WriteIMEData;
@@ -144,6 +153,51 @@ int FTI_InitFunctionPointers(int ckptIO, FTIT_execution * FTI_Exec) {
             ftiIO[2 + GLOBAL].finIntegrity = FTI_dummy;
 
 
+            FTI_Exec->ckptFunc[GLOBAL] = FTI_Write;
+            FTI_Exec->ckptFunc[LOCAL] = FTI_Write;
+
+            FTI_Exec->initICPFunc[LOCAL] = FTI_startICP;
+            FTI_Exec->initICPFunc[GLOBAL] = FTI_startICP;
+
+            FTI_Exec->writeVarICPFunc[LOCAL] = FTI_WriteVar;
+            FTI_Exec->writeVarICPFunc[GLOBAL] = FTI_WriteVar;
+
+            FTI_Exec->finalizeICPFunc[LOCAL] = FTI_FinishICP;
+            FTI_Exec->finalizeICPFunc[GLOBAL] = FTI_FinishICP;
+
+            FTI_Exec->activateHeads = FTI_ActivateHeadsPosix;
+
+            break;
+#endif
+
+#ifdef ENABLE_IOURING  // If the kernel headers provide io_uring
+        case FTI_IO_IOURING:
+            ftiIO[LOCAL].initCKPT = FTI_InitUring;
+            ftiIO[LOCAL].WriteData = FTI_WriteUringData;
+            ftiIO[LOCAL].finCKPT = FTI_UringClose;
+            ftiIO[LOCAL].getPos = FTI_GetUringFilePos;
+            ftiIO[LOCAL].finIntegrity = FTI_UringMD5;
+
+            ftiIO[GLOBAL].initCKPT = FTI_InitUring;
+            ftiIO[GLOBAL].WriteData = FTI_WriteUringData;
+            ftiIO[GLOBAL].finCKPT = FTI_UringClose;
+            ftiIO[GLOBAL].getPos = FTI_GetUringFilePos;
+            ftiIO[GLOBAL].finIntegrity = FTI_UringMD5;
+
+
+            ftiIO[2 + LOCAL].initCKPT = FTI_InitDCPPosix;
+            ftiIO[2 + LOCAL].WriteData = FTI_WritePosixDCPData;
+            ftiIO[2 + LOCAL].finCKPT = FTI_PosixDCPClose;
+            ftiIO[2 + LOCAL].getPos = FTI_GetDCPPosixFilePos;
+            ftiIO[2 + LOCAL].finIntegrity = FTI_dummy;
+
+            ftiIO[2 + GLOBAL].initCKPT = FTI_InitDCPPosix;
+            ftiIO[2 + GLOBAL].WriteData = FTI_WritePosixDCPData;
+            ftiIO[2 + GLOBAL].finCKPT = FTI_PosixDCPClose;
+            ftiIO[2 + GLOBAL].getPos = FTI_GetDCPPosixFilePos;
+            ftiIO[2 + GLOBAL].finIntegrity = FTI_dummy;
+
+
             FTI_Exec->ckptFunc[GLOBAL] = FTI_Write;
             FTI_Exec->ckptFunc[LOCAL] = FTI_Write;
 
@@ -167,6 +221,9 @@ int FTI_InitFunctionPointers(int ckptIO, FTIT_execution * FTI_Exec) {
             ftiIO[LOCAL].finCKPT = FTI_PosixClose;
             ftiIO[LOCAL].getPos = FTI_GetPosixFilePos;
             ftiIO[LOCAL].finIntegrity = FTI_PosixMD5;
+            ftiIO[LOCAL].setPos = FTI_PosixSeek;
+            ftiIO[LOCAL].WriteAt = FTI_PosixWriteAt;
+            ftiIO[LOCAL].updIntegrity = FTI_PosixUpdateMD5;
 
             ftiIO[GLOBAL].initCKPT = FTI_InitMPIO;
             ftiIO[GLOBAL].WriteData = FTI_WriteMPIOData;
@@ -196,6 +253,9 @@ int FTI_InitFunctionPointers(int ckptIO, FTIT_execution * FTI_Exec) {
             ftiIO[LOCAL].finCKPT = FTI_PosixClose;
             ftiIO[LOCAL].getPos = FTI_GetPosixFilePos;
             ftiIO[LOCAL].finIntegrity = FTI_PosixMD5;
+            ftiIO[LOCAL].setPos = FTI_PosixSeek;
+            ftiIO[LOCAL].WriteAt = FTI_PosixWriteAt;
+            ftiIO[LOCAL].updIntegrity = FTI_PosixUpdateMD5;
 
             ftiIO[GLOBAL].initCKPT = FTI_InitSion;
             ftiIO[GLOBAL].WriteData = FTI_WriteSionData;
@@ -56,6 +56,8 @@
 int FTI_startICP(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
         FTIT_keymap* FTI_Data, FTIT_IO *io) {
+    // variables are written as they come, without the codec stage
+    if (FTI_CodecReset(FTI_Exec, FTI_Data) != FTI_SCES) return FTI_NSCS;
     void *ret = io->initCKPT(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt, FTI_Data);
     FTI_Exec->iCPInfo.fd = ret;
     return FTI_SCES;
@@ -86,7 +88,7 @@ int FTI_WriteVar(int varID, FTIT_configuration* FTI_Conf,
 
     FTIT_dataset* data;
 
-    if (FTI_Data->get(&data, varID) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->get(FTI_Data, &data, varID) != FTI_SCES) return FTI_NSCS;
 
     if (data == NULL) {
         char str[FTI_BUFS];
@@ -49,6 +49,10 @@ extern "C" {
 #include "util/dataset.h"
 #include "util/keymap.h"
 #include "util/metaqueue.h"
+#include "util/threadpool.h"
+#include "util/workqueue.h"
+#include "util/trace.h"
+#include "util/metrics.h"
 #include "util/macros.h"
 #include "util/utility.h"
 #include "util/failure-injection.h"
@@ -59,8 +63,15 @@ extern "C" {
 #include "IO/ftiff.h"
 #include "IO/ftiff-dcp.h"
 #include "IO/ime.h"
+#include "IO/codec.h"
+#include "IO/reader.h"
+#include "IO/iouring.h"
+#include "IO/pipeline.h"
+#include "IO/transfer.h"
+#include "IO/dedup.h"
 
 #include "./meta.h"
+#include "./meta-bin.h"
 #include "./api-cuda.h"
 #include "./postreco.h"
 #include "util/tools.h"
@@ -73,6 +84,7 @@ extern "C" {
 #include "./postckpt.h"
 #include "./recover.h"
 #include "./icp.h"
+#include "./async.h"
 
 #include "deps/md5/md5.h"
 #include "deps/iniparser/iniparser.h"
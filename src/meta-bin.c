@@ -0,0 +1,642 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   meta-bin.c
+ *  @date   October, 2026
+ *  @brief  Binary format of the group metadata files.
+ *
+ *  Alternative to the INI 'sector<s>-group<g>.fti' files, selected with
+ *  'Advanced:meta_format'. The readers detect the format of a file from
+ *  its magic, so checkpoints of both formats can be recovered whatever
+ *  the current setting. The file layout is described in meta-bin.h; all
+ *  the values are stored in the byte order of the writing host.
+ *
+ *  A process only reads the header and the rank table, plus its own
+ *  section when it needs the variables or the dCP layers. The header and
+ *  the rank table are protected by one CRC32, each section by its own.
+ */
+
+#include "interface.h"
+
+#ifndef FTI_NOZLIB
+#   include "zlib.h"
+#endif
+
+static uint32_t FTI_MetaBinCrc(uint32_t crc, const void* buf, size_t size) {
+#ifdef FTI_NOZLIB
+    return crc32_raw(buf, size, crc ^ ~0U) ^ ~0U;
+#else
+    return crc32(crc, buf, size);
+#endif
+}
+
+/* CRC32 of the header (without its 'crc' field) and of the rank table. */
+static uint32_t FTI_MetaBinTableCrc(FTIT_metaHeader* hdr,
+ FTIT_metaRank* ranks) {
+    FTIT_metaHeader tmp = *hdr;
+    tmp.crc = 0;
+    uint32_t crc = FTI_MetaBinCrc(0, &tmp, sizeof(FTIT_metaHeader));
+    return FTI_MetaBinCrc(crc, ranks, sizeof(FTIT_metaRank) * hdr->groupSize);
+}
+
+/* Size of the section of a rank. */
+static size_t FTI_MetaBinSectionSize(FTIT_metaHeader* hdr,
+ FTIT_metaRank* rank) {
+    return sizeof(FTIT_metaVar) * hdr->nbVar +
+     sizeof(FTIT_metaLayer) * hdr->nbLayer +
+     sizeof(uint64_t) * rank->nbDims + rank->strSize;
+}
+
+/* Appends a string to the strings of a rank and returns its offset. */
+static uint32_t FTI_MetaBinPutString(char* strings, uint32_t* strSize,
+ const char* str) {
+    uint32_t offset = *strSize;
+    size_t len = strnlen(str, FTI_BUFS - 1);
+    memcpy(strings + offset, str, len);
+    strings[offset + len] = '\0';
+    *strSize += len + 1;
+    return offset;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Checks whether a metadata file is in the binary format.
+  @param      fn              Path of the metadata file.
+  @return     bool            TRUE if the file starts with the magic.
+
+ **/
+/*-------------------------------------------------------------------------*/
+bool FTI_MetaBinIsBinary(const char* fn) {
+    char magic[8];
+    FILE* fd = fopen(fn, "rb");
+    if (fd == NULL) {
+        return false;
+    }
+    size_t bytes = fread(magic, 1, sizeof(magic), fd);
+    fclose(fd);
+    return bytes == sizeof(magic) &&
+     memcmp(magic, FTI_META_MAGIC, sizeof(FTI_META_MAGIC)) == 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Opens a binary metadata file and loads its rank table.
+  @param      mb              Reader to initialize.
+  @param      fn              Path of the metadata file.
+  @return     integer         FTI_SCES if successful.
+
+  The header and the rank table are read and checked against their CRC32.
+  The sections of the ranks are loaded with FTI_MetaBinLoadRank.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_MetaBinOpen(FTIT_metabin* mb, const char* fn) {
+    char str[FTI_BUFS];
+    memset(mb, 0x0, sizeof(FTIT_metabin));
+
+    mb->fd = fopen(fn, "rb");
+    if (mb->fd == NULL) {
+        snprintf(str, FTI_BUFS, "unable to open metadata file '%s'.", fn);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    if (fread(&mb->hdr, sizeof(FTIT_metaHeader), 1, mb->fd) != 1 ||
+     memcmp(mb->hdr.magic, FTI_META_MAGIC, sizeof(FTI_META_MAGIC)) != 0) {
+        snprintf(str, FTI_BUFS, "'%s' is not a binary metadata file.", fn);
+        FTI_Print(str, FTI_WARN);
+        FTI_MetaBinClose(mb);
+        return FTI_NSCS;
+    }
+    if (mb->hdr.version > FTI_META_VERSION) {
+        snprintf(str, FTI_BUFS, "metadata file '%s' has version %u, only"
+         " versions up to %d are supported.", fn, mb->hdr.version,
+         FTI_META_VERSION);
+        FTI_Print(str, FTI_WARN);
+        FTI_MetaBinClose(mb);
+        return FTI_NSCS;
+    }
+
+    mb->ranks = talloc(FTIT_metaRank, mb->hdr.groupSize);
+    if (fread(mb->ranks, sizeof(FTIT_metaRank), mb->hdr.groupSize, mb->fd)
+     != mb->hdr.groupSize ||
+     FTI_MetaBinTableCrc(&mb->hdr, mb->ranks) != mb->hdr.crc) {
+        snprintf(str, FTI_BUFS, "rank table of metadata file '%s' is"
+         " corrupted.", fn);
+        FTI_Print(str, FTI_WARN);
+        FTI_MetaBinClose(mb);
+        return FTI_NSCS;
+    }
+
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Loads the section of one rank from a binary metadata file.
+  @param      mb              Reader opened with FTI_MetaBinOpen.
+  @param      rank            Rank in the group.
+  @return     integer         FTI_SCES if successful.
+
+  Seeks directly to the section of 'rank' and checks it against its
+  CRC32. The previously loaded section is released.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_MetaBinLoadRank(FTIT_metabin* mb, int rank) {
+    char str[FTI_BUFS];
+    if (rank < 0 || rank >= mb->hdr.groupSize) {
+        snprintf(str, FTI_BUFS, "rank %d is not in the metadata file.",
+         rank);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    FTIT_metaRank* entry = &mb->ranks[rank];
+    size_t size = FTI_MetaBinSectionSize(&mb->hdr, entry);
+    free(mb->section);
+    mb->section = talloc(char, size + 1);
+
+    if (fseek(mb->fd, entry->offset, SEEK_SET) != 0 ||
+     fread(mb->section, 1, size, mb->fd) != size ||
+     FTI_MetaBinCrc(0, mb->section, size) != entry->crc) {
+        snprintf(str, FTI_BUFS, "metadata of rank %d is corrupted.", rank);
+        FTI_Print(str, FTI_WARN);
+        free(mb->section);
+        mb->section = NULL;
+        return FTI_NSCS;
+    }
+
+    char* ptr = (char*) mb->section;
+    mb->vars = (FTIT_metaVar*) ptr;
+    ptr += sizeof(FTIT_metaVar) * mb->hdr.nbVar;
+    mb->layers = (FTIT_metaLayer*) ptr;
+    ptr += sizeof(FTIT_metaLayer) * mb->hdr.nbLayer;
+    mb->dims = (uint64_t*) ptr;
+    ptr += sizeof(uint64_t) * entry->nbDims;
+    mb->strings = ptr;
+    // guards the strings of a truncated section
+    mb->strings[entry->strSize] = '\0';
+
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Closes a binary metadata file and releases the reader.
+  @param      mb              Reader opened with FTI_MetaBinOpen.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_MetaBinClose(FTIT_metabin* mb) {
+    if (mb->fd != NULL) {
+        fclose(mb->fd);
+    }
+    free(mb->ranks);
+    free(mb->section);
+    memset(mb, 0x0, sizeof(FTIT_metabin));
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      It writes the metadata of the group in the binary format.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      fn              Path of the metadata file.
+  @return     integer         FTI_SCES if successful.
+
+  Binary counterpart of FTI_WriteMetadata, the remaining parameters are
+  the ones of FTI_WriteMetadata.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_WriteMetadataBin(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_checkpoint* FTI_Ckpt, const char* fn, int64_t* fs,
+        int64_t mfs, char* fnl, char* checksums, int* allVarIDs,
+        int* allRanks, uint64_t* allCounts,
+        int* allVarTypeIDs, int* allVarTypeSizes, int* allVarCodecs,
+        int64_t* allVarSizes, uint64_t* allLayerSizes, char* allLayerHashes,
+        int64_t *allVarPositions, char *allNames, char *allCharIds) {
+    char str[FTI_BUFS];
+    int nbVar = FTI_Exec->nbVar;
+    int groupSize = FTI_Topo->groupSize;
+    bool isDcp = FTI_Ckpt[FTI_Exec->ckptMeta.level].isDcp;
+    int nbLayer = (isDcp) ? ((FTI_Exec->dcpInfoPosix.Counter-1) %
+     FTI_Conf->dcpInfoPosix.StackSize) + 1 : 0;
+
+    FTIT_metaHeader hdr;
+    memset(&hdr, 0x0, sizeof(FTIT_metaHeader));
+    memcpy(hdr.magic, FTI_META_MAGIC, sizeof(FTI_META_MAGIC));
+    hdr.version = FTI_META_VERSION;
+    hdr.maxFs = (uint64_t) mfs;
+    hdr.groupSize = groupSize;
+    hdr.nbVar = nbVar;
+    hdr.nbLayer = nbLayer;
+    hdr.ckptId = FTI_Exec->ckptMeta.ckptId;
+    hdr.isDcp = isDcp;
+    hdr.l3Code = FTI_L3Code(FTI_Conf);
+
+    FTIT_metaRank* ranks = talloc(FTIT_metaRank, groupSize);
+    memset(ranks, 0x0, sizeof(FTIT_metaRank) * groupSize);
+
+    // Largest section: every string at its maximum length
+    size_t maxSection = sizeof(FTIT_metaVar) * nbVar +
+     sizeof(FTIT_metaLayer) * nbLayer + sizeof(uint64_t) * 32 * nbVar +
+     (size_t) FTI_BUFS * (2 * nbVar + 1);
+    char* section = talloc(char, maxSection);
+
+    FILE* fd = fopen(fn, "wb");
+    if (fd == NULL) {
+        snprintf(str, FTI_BUFS, "unable to create metadata file '%s'.", fn);
+        FTI_Print(str, FTI_WARN);
+        free(ranks);
+        free(section);
+        return FTI_NSCS;
+    }
+
+    // Sections are written after the header and the rank table
+    uint64_t offset = sizeof(FTIT_metaHeader) +
+     sizeof(FTIT_metaRank) * groupSize;
+    if (fseek(fd, offset, SEEK_SET) != 0) {
+        FTI_Print("unable to seek in the metadata file.", FTI_WARN);
+        goto error;
+    }
+
+    int i;
+    for (i = 0; i < groupSize; i++) {
+        FTIT_metaRank* rank = &ranks[i];
+        rank->fs = (uint64_t) fs[i];
+        rank->offset = offset;
+        strncpy(rank->checksum, checksums + (i * MD5_DIGEST_STRING_LENGTH),
+         MD5_DIGEST_STRING_LENGTH);
+        rank->checksum[MD5_DIGEST_STRING_LENGTH - 1] = '\0';
+
+        int j;
+        for (j = 0; j < nbVar; j++) {
+            rank->nbDims += allRanks[i * nbVar + j];
+        }
+
+        FTIT_metaVar* vars = (FTIT_metaVar*) section;
+        FTIT_metaLayer* layers = (FTIT_metaLayer*) (vars + nbVar);
+        uint64_t* dims = (uint64_t*) (layers + nbLayer);
+        char* strings = (char*) (dims + rank->nbDims);
+
+        rank->fileName = FTI_MetaBinPutString(strings, &rank->strSize,
+         fnl + (i * FTI_BUFS));
+
+        uint32_t dim = 0;
+        for (j = 0; j < nbVar; j++) {
+            int idx = i * nbVar + j;
+            memset(&vars[j], 0x0, sizeof(FTIT_metaVar));
+            vars[j].id = allVarIDs[idx];
+            vars[j].typeId = allVarTypeIDs[idx];
+            vars[j].typeSize = allVarTypeSizes[idx];
+            vars[j].codec = allVarCodecs[idx];
+            vars[j].size = (uint64_t) allVarSizes[idx];
+            vars[j].pos = (uint64_t) allVarPositions[idx];
+            vars[j].ndims = allRanks[idx];
+            vars[j].dims = dim;
+            int r;
+            for (r = 0; r < allRanks[idx]; r++) {
+                dims[dim++] = allCounts[i * 32 * nbVar + j * 32 + r];
+            }
+            vars[j].name = FTI_MetaBinPutString(strings, &rank->strSize,
+             &allNames[(i * nbVar * FTI_BUFS) + j * FTI_BUFS]);
+            vars[j].idChar = FTI_MetaBinPutString(strings, &rank->strSize,
+             &allCharIds[(i * nbVar * FTI_BUFS) + j * FTI_BUFS]);
+        }
+        for (j = 0; j < nbLayer; j++) {
+            memset(&layers[j], 0x0, sizeof(FTIT_metaLayer));
+            layers[j].size = allLayerSizes[i * nbLayer + j];
+            strncpy(layers[j].hash, &allLayerHashes[i *
+             nbLayer * MD5_DIGEST_STRING_LENGTH + j * MD5_DIGEST_STRING_LENGTH],
+             MD5_DIGEST_STRING_LENGTH);
+            layers[j].hash[MD5_DIGEST_STRING_LENGTH - 1] = '\0';
+        }
+
+        size_t size = FTI_MetaBinSectionSize(&hdr, rank);
+        rank->crc = FTI_MetaBinCrc(0, section, size);
+        if (fwrite(section, 1, size, fd) != size) {
+            FTI_Print("unable to write the metadata sections.", FTI_WARN);
+            goto error;
+        }
+        offset += size;
+    }
+
+    hdr.size = offset;
+    hdr.crc = FTI_MetaBinTableCrc(&hdr, ranks);
+    if (fseek(fd, 0, SEEK_SET) != 0 ||
+     fwrite(&hdr, sizeof(FTIT_metaHeader), 1, fd) != 1 ||
+     fwrite(ranks, sizeof(FTIT_metaRank), groupSize, fd) != groupSize) {
+        FTI_Print("unable to write the metadata rank table.", FTI_WARN);
+        goto error;
+    }
+
+    free(ranks);
+    free(section);
+    if (fclose(fd) != 0) {
+        FTI_Print("unable to close the metadata file.", FTI_WARN);
+        return FTI_NSCS;
+    }
+    return FTI_SCES;
+
+error:
+    free(ranks);
+    free(section);
+    fclose(fd);
+    return FTI_NSCS;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      It writes the RSed file checksums to a binary metadata file.
+  @param      FTI_Topo        Topology metadata.
+  @param      fn              Path of the metadata file.
+  @param      checksums       Checksums of the group members.
+  @return     integer         FTI_SCES if successful.
+
+  Only the rank table and the header are rewritten.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_WriteRSedChecksumBin(FTIT_topology* FTI_Topo, const char* fn,
+        char* checksums) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    fclose(mb.fd);
+    mb.fd = NULL;
+
+    int i;
+    for (i = 0; i < mb.hdr.groupSize && i < FTI_Topo->groupSize; i++) {
+        strncpy(mb.ranks[i].rsChecksum,
+         checksums + (i * MD5_DIGEST_STRING_LENGTH), MD5_DIGEST_STRING_LENGTH);
+        mb.ranks[i].rsChecksum[MD5_DIGEST_STRING_LENGTH - 1] = '\0';
+    }
+    mb.hdr.crc = FTI_MetaBinTableCrc(&mb.hdr, mb.ranks);
+
+    int res = FTI_SCES;
+    FILE* fd = fopen(fn, "r+b");
+    if (fd == NULL ||
+     fwrite(&mb.hdr, sizeof(FTIT_metaHeader), 1, fd) != 1 ||
+     fwrite(mb.ranks, sizeof(FTIT_metaRank), mb.hdr.groupSize, fd) !=
+     mb.hdr.groupSize) {
+        FTI_Print("unable to update the metadata rank table.", FTI_WARN);
+        res = FTI_NSCS;
+    }
+    if (fd != NULL && fclose(fd) != 0) {
+        res = FTI_NSCS;
+    }
+
+    FTI_MetaBinClose(&mb);
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      It gets the checksums from a binary metadata file.
+  @param      FTI_Topo        Topology metadata.
+  @param      fn              Path of the metadata file.
+  @param      checksum        Pointer to fill the checkpoint checksum.
+  @param      ptnerChecksum   Pointer to fill the ptner file checksum.
+  @param      rsChecksum      Pointer to fill the RS file checksum.
+  @return     integer         FTI_SCES if successful.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_GetChecksumsBin(FTIT_topology* FTI_Topo, const char* fn,
+        char* checksum, char* ptnerChecksum, char* rsChecksum) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (mb.hdr.groupSize != FTI_Topo->groupSize) {
+        FTI_Print("metadata file does not match the group size.", FTI_WARN);
+        FTI_MetaBinClose(&mb);
+        return FTI_NSCS;
+    }
+
+    int ptner = (FTI_Topo->groupRank + FTI_Topo->groupSize - 1) %
+     FTI_Topo->groupSize;
+    strncpy(checksum, mb.ranks[FTI_Topo->groupRank].checksum,
+     MD5_DIGEST_STRING_LENGTH);
+    strncpy(ptnerChecksum, mb.ranks[ptner].checksum,
+     MD5_DIGEST_STRING_LENGTH);
+    strncpy(rsChecksum, mb.ranks[FTI_Topo->groupRank].rsChecksum,
+     MD5_DIGEST_STRING_LENGTH);
+
+    FTI_MetaBinClose(&mb);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Loads the postprocessing metadata from a binary file.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      fn              Path of the metadata file.
+  @return     integer         FTI_SCES if successful.
+
+  Binary counterpart of FTI_LoadMetaPostprocessing. Only the section of
+  the process is read for the file name.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_LoadMetaPostprocessingBin(FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, const char* fn) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (FTI_MetaBinLoadRank(&mb, FTI_Topo->groupRank) != FTI_SCES) {
+        FTI_MetaBinClose(&mb);
+        return FTI_NSCS;
+    }
+
+    FTIT_metaRank* rank = &mb.ranks[FTI_Topo->groupRank];
+    snprintf(FTI_Exec->ckptMeta.ckptFile, FTI_BUFS, "%s",
+     mb.strings + rank->fileName);
+
+    // update head's ckptId
+    FTI_Exec->ckptMeta.ckptId = mb.hdr.ckptId;
+
+    int ptner = (FTI_Topo->groupRank + FTI_Topo->groupSize - 1) %
+     FTI_Topo->groupSize;
+    FTI_Exec->ckptMeta.fs = rank->fs;
+    FTI_Exec->ckptMeta.pfs = mb.ranks[ptner].fs;
+    FTI_Exec->ckptMeta.maxFs = mb.hdr.maxFs;
+    FTI_Exec->ckptMeta.l3Code = mb.hdr.l3Code;
+
+    FTI_MetaBinClose(&mb);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Loads the recovery metadata of one level from a binary file.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      level           Level of the metadata file.
+  @param      fn              Path of the metadata file.
+  @param      meta            Metadata to fill.
+  @return     integer         FTI_SCES if successful.
+
+  Binary counterpart of the loop body of FTI_LoadMetaRecovery.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_LoadMetaRecoveryBin(FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt, int level,
+        const char* fn, FTIT_metadata* meta) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (mb.hdr.groupSize != FTI_Topo->groupSize ||
+     FTI_MetaBinLoadRank(&mb, FTI_Topo->groupRank) != FTI_SCES) {
+        FTI_MetaBinClose(&mb);
+        return FTI_NSCS;
+    }
+
+    FTI_Ckpt[level].recoIsDcp = mb.hdr.isDcp;
+    FTI_Exec->ckptId = mb.hdr.ckptId;
+
+    FTIT_metaRank* rank = &mb.ranks[FTI_Topo->groupRank];
+    snprintf(meta->ckptFile, FTI_BUFS, "%s", mb.strings + rank->fileName);
+    meta->fs = rank->fs;
+    FTI_Exec->dcpInfoPosix.FileSize = meta->fs;
+
+    int ptner = (FTI_Topo->groupRank + FTI_Topo->groupSize - 1) %
+     FTI_Topo->groupSize;
+    meta->pfs = mb.ranks[ptner].fs;
+    meta->maxFs = mb.hdr.maxFs;
+    meta->l3Code = mb.hdr.l3Code;
+
+    FTI_MetaBinClose(&mb);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Loads the dCP metadata from a binary file.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      fn              Path of the metadata file.
+  @return     integer         FTI_SCES if successful.
+
+  Binary counterpart of FTI_LoadMetaDcp.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_LoadMetaDcpBin(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        const char* fn) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (FTI_MetaBinLoadRank(&mb, FTI_Topo->groupRank) != FTI_SCES) {
+        FTI_MetaBinClose(&mb);
+        return FTI_NSCS;
+    }
+
+    int k;
+    for (k = 0; k < mb.hdr.nbLayer && k < MAX_STACK_SIZE; k++) {
+        FTI_Exec->dcpInfoPosix.LayerSize[k] = mb.layers[k].size;
+        snprintf(&FTI_Exec->dcpInfoPosix.LayerHash[k*MD5_DIGEST_STRING_LENGTH],
+         MD5_DIGEST_STRING_LENGTH, "%s", mb.layers[k].hash);
+        int j;
+        for (j = 0; j < mb.hdr.nbVar && j < FTI_BUFS; j++) {
+            FTI_Exec->dcpInfoPosix.datasetInfo[k][j].varID = mb.vars[j].id;
+            FTI_Exec->dcpInfoPosix.datasetInfo[k][j].varSize =
+             mb.vars[j].size;
+        }
+    }
+
+    FTI_MetaBinClose(&mb);
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Loads the metadata of the protected datasets from a binary
+  file.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      fn              Path of the metadata file.
+  @return     integer         FTI_SCES if successful.
+
+  Binary counterpart of FTI_LoadMetaDataset.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_LoadMetaDatasetBin(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_keymap* FTI_Data, const char* fn) {
+    FTIT_metabin mb;
+    if (FTI_MetaBinOpen(&mb, fn) != FTI_SCES) {
+        return FTI_NSCS;
+    }
+    if (FTI_MetaBinLoadRank(&mb, FTI_Topo->groupRank) != FTI_SCES) {
+        FTI_MetaBinClose(&mb);
+        return FTI_NSCS;
+    }
+
+    int k;
+    for (k = 0; k < mb.hdr.nbVar && k < FTI_Conf->maxVarId; k++) {
+        FTIT_dataset data; FTI_InitDataset(FTI_Exec, &data, mb.vars[k].id);
+
+        data.sizeStored = mb.vars[k].size;
+        data.filePos = mb.vars[k].pos;
+        data.codec = mb.vars[k].codec;
+        strncpy(data.idChar, mb.strings + mb.vars[k].idChar, FTI_BUFS);
+
+        FTI_Exec->ckptSize = FTI_Exec->ckptSize + data.size;
+
+        data.recovered = true;
+
+        FTI_Data->push_back(FTI_Data, &data, data.id);
+    }
+
+    // Save number of variables in metadata
+    FTI_Exec->nbVarStored = k;
+
+    FTI_MetaBinClose(&mb);
+    return FTI_SCES;
+}
@@ -0,0 +1,116 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   meta-bin.h
+ */
+
+#ifndef FTI_SRC_META_BIN_H_
+#define FTI_SRC_META_BIN_H_
+
+#include "interface.h"
+
+/** Metadata file formats ('Advanced:meta_format') **/
+#define FTI_META_INI 0
+#define FTI_META_BIN 1
+
+#define FTI_META_MAGIC "FTIMETA"
+#define FTI_META_VERSION 1
+/** Size of the checksum strings in the rank table **/
+#define FTI_META_CSLEN 40
+
+/** @typedef    FTIT_metaHeader
+ *  @brief      Header of a binary metadata file.
+ *
+ *  The header is followed by the rank table (one FTIT_metaRank per group
+ *  member) and by one section per rank. A section holds the variable
+ *  index (FTIT_metaVar), the dCP layers (FTIT_metaLayer), the dimensions
+ *  of the variables (uint64_t) and the strings of the rank.
+ */
+typedef struct FTIT_metaHeader {
+    char        magic[8];       /**< FTI_META_MAGIC                       */
+    uint64_t    maxFs;          /**< Largest checkpoint file of the group */
+    uint64_t    size;           /**< Size of the metadata file            */
+    uint32_t    version;        /**< Format version                       */
+    uint32_t    groupSize;      /**< Number of entries in the rank table  */
+    uint32_t    nbVar;          /**< Variables per rank                   */
+    uint32_t    nbLayer;        /**< dCP layers per rank (0 if full)      */
+    int32_t     ckptId;         /**< Checkpoint ID                        */
+    uint32_t    isDcp;          /**< 1 for dCP checkpoints                */
+    uint32_t    crc;            /**< CRC32 of the header and rank table   */
+    uint32_t    l3Code;         /**< Code of the L3 files (0 if unknown)  */
+} FTIT_metaHeader;
+
+/** Rank table entry **/
+typedef struct FTIT_metaRank {
+    uint64_t    fs;                             /**< Checkpoint file size */
+    uint64_t    offset;                         /**< Section of the rank  */
+    uint32_t    nbDims;                         /**< Dimensions stored    */
+    uint32_t    strSize;                        /**< Size of the strings  */
+    uint32_t    fileName;                       /**< Ckpt. file name      */
+    uint32_t    crc;                            /**< CRC32 of the section */
+    char        checksum[FTI_META_CSLEN];       /**< Ckpt. file checksum  */
+    char        rsChecksum[FTI_META_CSLEN];     /**< RS file checksum     */
+} FTIT_metaRank;
+
+/** Variable index entry, strings are offsets in the rank strings **/
+typedef struct FTIT_metaVar {
+    uint64_t    size;           /**< Size stored in the checkpoint file   */
+    uint64_t    pos;            /**< Position in the checkpoint file      */
+    int32_t     id;             /**< Variable ID                          */
+    int32_t     typeId;         /**< Primitive type ID (-1 if complex)    */
+    int32_t     typeSize;       /**< Size of the type                     */
+    uint32_t    ndims;          /**< Number of dimensions                 */
+    uint32_t    dims;           /**< Index of the first dimension         */
+    uint32_t    name;           /**< Variable name                        */
+    uint32_t    idChar;         /**< Variable string ID                   */
+    uint32_t    codec;          /**< Codec of the variable (0 if raw)     */
+} FTIT_metaVar;
+
+/** dCP layer entry **/
+typedef struct FTIT_metaLayer {
+    uint64_t    size;                           /**< Layer size           */
+    char        hash[FTI_META_CSLEN];           /**< Layer hash           */
+} FTIT_metaLayer;
+
+/** Reader of a binary metadata file **/
+typedef struct FTIT_metabin {
+    FILE*               fd;
+    FTIT_metaHeader     hdr;
+    FTIT_metaRank*      ranks;      /**< Rank table                       */
+    void*               section;    /**< Section of the loaded rank       */
+    FTIT_metaVar*       vars;       /**< Variables of the loaded rank     */
+    FTIT_metaLayer*     layers;     /**< dCP layers of the loaded rank    */
+    uint64_t*           dims;       /**< Dimensions of the loaded rank    */
+    char*               strings;    /**< Strings of the loaded rank       */
+} FTIT_metabin;
+
+bool FTI_MetaBinIsBinary(const char* fn);
+int FTI_MetaBinOpen(FTIT_metabin* mb, const char* fn);
+int FTI_MetaBinLoadRank(FTIT_metabin* mb, int rank);
+void FTI_MetaBinClose(FTIT_metabin* mb);
+
+int FTI_WriteMetadataBin(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_checkpoint* FTI_Ckpt, const char* fn, int64_t* fs,
+        int64_t mfs, char* fnl, char* checksums, int* allVarIDs,
+        int* allRanks, uint64_t* allCounts,
+        int* allVarTypeIDs, int* allVarTypeSizes, int* allVarCodecs,
+        int64_t* allVarSizes, uint64_t* allLayerSizes, char* allLayerHashes,
+        int64_t *allVarPositions, char *allNames, char *allCharIds);
+int FTI_WriteRSedChecksumBin(FTIT_topology* FTI_Topo, const char* fn,
+        char* checksums);
+int FTI_GetChecksumsBin(FTIT_topology* FTI_Topo, const char* fn,
+        char* checksum, char* ptnerChecksum, char* rsChecksum);
+int FTI_LoadMetaPostprocessingBin(FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, const char* fn);
+int FTI_LoadMetaRecoveryBin(FTIT_execution* FTI_Exec,
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt, int level,
+        const char* fn, FTIT_metadata* meta);
+int FTI_LoadMetaDcpBin(FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        const char* fn);
+int FTI_LoadMetaDatasetBin(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_keymap* FTI_Data, const char* fn);
+
+#endif  // FTI_SRC_META_BIN_H_
@@ -76,6 +76,11 @@ int FTI_GetChecksums(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(str, FTI_BUFS, "Getting FTI metadata file (%s)...", mfn);
     FTI_Print(str, FTI_DBUG);
 
+    if (FTI_MetaBinIsBinary(mfn)) {
+        return FTI_GetChecksumsBin(FTI_Topo, mfn, checksum, ptnerChecksum,
+         rsChecksum);
+    }
+
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, mfn, FTI_INI_OPEN) != FTI_SCES) {
         FTI_Print("Iniparser failed to parse the metadata file.", FTI_WARN);
@@ -144,6 +149,12 @@ int FTI_WriteRSedChecksum(FTIT_configuration* FTI_Conf,
     snprintf(fileName, FTI_BUFS, "%s/sector%d-group%d.fti", FTI_Conf->mTmpDir,
      FTI_Topo->sectorID, groupID);
 
+    if (FTI_MetaBinIsBinary(fileName)) {
+        int res = FTI_WriteRSedChecksumBin(FTI_Topo, fileName, checksums);
+        free(checksums);
+        return res;
+    }
+
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, fileName, FTI_INI_OPEN) != FTI_SCES) {
         FTI_Print("Temporary metadata file could NOT be parsed", FTI_WARN);
@@ -204,6 +215,9 @@ int FTI_LoadMetaPostprocessing(FTIT_configuration* FTI_Conf,
     snprintf(str, FTI_BUFS, "Getting FTI metadata file (%s)...", metaFileName);
     FTI_Print(str, FTI_DBUG);
 
+    if (FTI_MetaBinIsBinary(metaFileName))
+      return FTI_LoadMetaPostprocessingBin(FTI_Exec, FTI_Topo, metaFileName);
+
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, metaFileName, FTI_INI_OPEN) != FTI_SCES)
       return FTI_NSCS;
@@ -223,6 +237,7 @@ int FTI_LoadMetaPostprocessing(FTIT_configuration* FTI_Conf,
     FTI_Exec->ckptMeta.pfs = ini.getLong(&ini, str);
 
     FTI_Exec->ckptMeta.maxFs = ini.getLong(&ini, "0:Ckpt_file_maxs");
+    FTI_Exec->ckptMeta.l3Code = ini.getInt(&ini, "ckpt_info:l3_code");
 
     ini.clear(&ini);
 
@@ -286,6 +301,14 @@ int FTI_LoadMetaRecovery(FTIT_configuration* FTI_Conf,
          metaFileName);
         FTI_Print(str, FTI_DBUG);
 
+        if (FTI_MetaBinIsBinary(metaFileName)) {
+            if (FTI_LoadMetaRecoveryBin(FTI_Exec, FTI_Topo, FTI_Ckpt, i,
+             metaFileName, &meta) == FTI_SCES) {
+                FTI_Exec->mqueue.push(&FTI_Exec->mqueue, meta);
+            }
+            continue;
+        }
+
         if (FTI_Iniparser(&ini, metaFileName, FTI_INI_OPEN) != FTI_SCES)
           continue;
 
@@ -312,6 +335,7 @@ int FTI_LoadMetaRecovery(FTIT_configuration* FTI_Conf,
         meta.pfs = ini.getLong(&ini, str);
 
         meta.maxFs = ini.getLong(&ini, "0:Ckpt_file_maxs");
+        meta.l3Code = ini.getInt(&ini, "ckpt_info:l3_code");
 
         FTI_Exec->mqueue.push(&FTI_Exec->mqueue, meta);
 
@@ -356,13 +380,16 @@ int FTI_LoadMetaDcp(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(str, FTI_BUFS, "Getting FTI metadata file (%s)...", metaFileName);
     FTI_Print(str, FTI_DBUG);
 
+    if (FTI_MetaBinIsBinary(metaFileName))
+      return FTI_LoadMetaDcpBin(FTI_Exec, FTI_Topo, metaFileName);
+
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, metaFileName, FTI_INI_OPEN) != FTI_SCES)
       return FTI_NSCS;
 
     int k; for (k = 0; k < MAX_STACK_SIZE; k++) {
         snprintf(str, FTI_BUFS, "%d:dcp_layer%d_size", FTI_Topo->groupRank, k);
-        uint32_t LayerSize = ini.getLong(&ini, str);
+        int64_t LayerSize = ini.getLong(&ini, str);
         if (LayerSize == -1) {
             // No more variables
             break;
@@ -383,12 +410,12 @@ int FTI_LoadMetaDcp(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             FTI_Exec->dcpInfoPosix.datasetInfo[k][j].varID = varID;
             snprintf(str, FTI_BUFS, "%d:dcp_layer%d_var%d_size",
              FTI_Topo->groupRank, k, j);
-            int32_t varSize = ini.getLong(&ini, str);
+            int64_t varSize = ini.getLong(&ini, str);
             if (varID < 0) {
                 break;
             }
             FTI_Exec->dcpInfoPosix.datasetInfo[k][j].varSize =
-             (uint32_t) varSize;
+             (uint64_t) varSize;
         }
     }
 
@@ -433,6 +460,10 @@ int FTI_LoadMetaDataset(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(str, FTI_BUFS, "Getting FTI metadata file (%s)...", metaFileName);
     FTI_Print(str, FTI_DBUG);
 
+    if (FTI_MetaBinIsBinary(metaFileName))
+      return FTI_LoadMetaDatasetBin(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Data,
+       metaFileName);
+
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, metaFileName, FTI_INI_OPEN) != FTI_SCES)
       return FTI_NSCS;
@@ -453,6 +484,11 @@ int FTI_LoadMetaDataset(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         snprintf(str, FTI_BUFS, "%d:Var%d_pos", FTI_Topo->groupRank, k);
         data.filePos = ini.getLong(&ini, str);
 
+        // missing in metadata written before the codec stage
+        snprintf(str, FTI_BUFS, "%d:Var%d_codec", FTI_Topo->groupRank, k);
+        data.codec = ini.getInt(&ini, str);
+        if (data.codec == -1) data.codec = FTI_CODEC_NONE;
+
         snprintf(str, FTI_BUFS, "%d:Var%d_idChar", FTI_Topo->groupRank, k);
         strncpy(data.idChar, ini.getString(&ini, str), FTI_BUFS);
 
@@ -460,7 +496,7 @@ int FTI_LoadMetaDataset(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
         data.recovered = true;
 
-        FTI_Data->push_back(&data, data.id);
+        FTI_Data->push_back(FTI_Data, &data, data.id);
     }
 
     // Save number of variables in metadata
@@ -665,6 +701,7 @@ int FTI_WriteCkptMetaData(FTIT_configuration* FTI_Conf,
   @param      fnl             Pointer to the list of checkpoint names.
   @param      checksums       Checksums array.
   @param      allVarIDs       IDs of vars from all processes in group.
+  @param      allVarCodecs    Codecs of vars from all processes in group.
   @param      allVarSizes     Sizes of vars from all processes in group.
   @param      allLayerSizes   Sizes of all layers used in dcp.
   @param      allLayerHashes  Hashes of all layers used in dcp.
@@ -672,17 +709,20 @@ int FTI_WriteCkptMetaData(FTIT_configuration* FTI_Conf,
   @return     integer         FTI_SCES if successful.
 
   This function should be executed only by one process per group. It
-  writes the metadata file used to recover in case of failure.
+  writes the metadata file used to recover in case of failure, in the
+  format selected by 'meta_format' (see meta-bin.c for the binary one).
+  The variable sizes are the decoded sizes, the size of an encoded
+  variable in the file is given by its frames (see codec.c).
 
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt, int32_t* fs,
-        int32_t mfs, char* fnl, char* checksums, int* allVarIDs,
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt, int64_t* fs,
+        int64_t mfs, char* fnl, char* checksums, int* allVarIDs,
         int* allRanks, uint64_t* allCounts,
-        int* allVarTypeIDs, int* allVarTypeSizes,
-        int32_t* allVarSizes, uint32_t* allLayerSizes, char* allLayerHashes,
-        int32_t *allVarPositions, char *allNames, char *allCharIds) {
+        int* allVarTypeIDs, int* allVarTypeSizes, int* allVarCodecs,
+        int64_t* allVarSizes, uint64_t* allLayerSizes, char* allLayerHashes,
+        int64_t *allVarPositions, char *allNames, char *allCharIds) {
     // no metadata files for FTI-FF
     if (FTI_Conf->ioMode == FTI_IO_FTIFF) { return FTI_SCES; }
 
@@ -691,6 +731,15 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(fn, FTI_BUFS, "%s/sector%d-group%d.fti",
      FTI_Conf->mTmpDir, FTI_Topo->sectorID, FTI_Topo->groupID);
 
+    if (FTI_Conf->metaFormat == FTI_META_BIN) {
+        MKDIR(FTI_Conf->mTmpDir, 0777);
+        return FTI_WriteMetadataBin(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt,
+         fn, fs, mfs, fnl, checksums, allVarIDs, allRanks, allCounts,
+         allVarTypeIDs, allVarTypeSizes, allVarCodecs, allVarSizes,
+         allLayerSizes, allLayerHashes, allVarPositions, allNames,
+         allCharIds);
+    }
+
     // To bypass iniparser bug while empty dict.
     FTIT_iniparser ini;
     if (FTI_Iniparser(&ini, fn, FTI_INI_CREATE) != FTI_SCES) {
@@ -713,6 +762,10 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(val, FTI_BUFS, "%d", FTI_Exec->ckptMeta.ckptId);
     ini.set(&ini, "ckpt_info:ckpt_id", val);
 
+    // add the code of the L3 files
+    snprintf(val, FTI_BUFS, "%d", FTI_L3Code(FTI_Conf));
+    ini.set(&ini, "ckpt_info:l3_code", val);
+
     // Add metadata to dictionary
     int i;
     for (i = 0; i < FTI_Topo->groupSize; i++) {
@@ -722,10 +775,10 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         snprintf(key, FTI_BUFS, "%d:Ckpt_file_name", i);
         ini.set(&ini, key, val);
         snprintf(key, FTI_BUFS, "%d:Ckpt_file_size", i);
-        snprintf(val, FTI_BUFS, "%u", fs[i]);
+        snprintf(val, FTI_BUFS, "%ld", fs[i]);
         ini.set(&ini, key, val);
         snprintf(key, FTI_BUFS, "%d:Ckpt_file_maxs", i);
-        snprintf(val, FTI_BUFS, "%u", mfs);
+        snprintf(val, FTI_BUFS, "%ld", mfs);
         ini.set(&ini, key, val);
         strncpy(val, checksums + (i * MD5_DIGEST_STRING_LENGTH),
          MD5_DIGEST_STRING_LENGTH);
@@ -752,12 +805,18 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
             // Save size of variable
             snprintf(key, FTI_BUFS, "%d:Var%d_size", i, j);
-            snprintf(val, FTI_BUFS, "%d",
+            snprintf(val, FTI_BUFS, "%ld",
              allVarSizes[i * FTI_Exec->nbVar + j]);
             ini.set(&ini, key, val);
 
-            snprintf(key, FTI_BUFS, "%d:Var%d_pos", i, j);
+            // Save codec of variable
+            snprintf(key, FTI_BUFS, "%d:Var%d_codec", i, j);
             snprintf(val, FTI_BUFS, "%d",
+                    allVarCodecs[i * FTI_Exec->nbVar + j]);
+            ini.set(&ini, key, val);
+
+            snprintf(key, FTI_BUFS, "%d:Var%d_pos", i, j);
+            snprintf(val, FTI_BUFS, "%ld",
              allVarPositions[i * FTI_Exec->nbVar + j]);
             ini.set(&ini, key, val);
 
@@ -790,7 +849,7 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
              FTI_Conf->dcpInfoPosix.StackSize) + 1;
             for (j=0; j < nbLayer; j++) {
                 snprintf(key, FTI_BUFS, "%d:dcp_layer%d_size", i, j);
-                snprintf(val, FTI_BUFS, "%u", allLayerSizes[i * nbLayer + j]);
+                snprintf(val, FTI_BUFS, "%lu", allLayerSizes[i * nbLayer + j]);
                 ini.set(&ini, key, val);
 
                 snprintf(key, FTI_BUFS, "%d:dcp_layer%d_hash", i, j);
@@ -808,7 +867,7 @@ int FTI_WriteMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                     // Save size of variable
                     snprintf(key, FTI_BUFS, "%d:dcp_layer%d_var%d_size",
                      i, j, k);
-                    snprintf(val, FTI_BUFS, "%d",
+                    snprintf(val, FTI_BUFS, "%ld",
                      allVarSizes[i * FTI_Exec->nbVar + k]);
                     ini.set(&ini, key, val);
                 }
@@ -846,8 +905,13 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     // metadata is created before for FTI-FF
     if (FTI_Conf->ioMode == FTI_IO_FTIFF) { return FTI_SCES; }
 
-    FTI_Exec->ckptMeta.fs = (FTI_Ckpt[FTI_Exec->ckptMeta.level].isDcp) ?
-     FTI_Exec->dcpInfoPosix.FileSize : FTI_Exec->ckptSize;
+    if (FTI_Ckpt[FTI_Exec->ckptMeta.level].isDcp) {
+        FTI_Exec->ckptMeta.fs = FTI_Exec->dcpInfoPosix.FileSize;
+    } else if (FTI_Exec->encodedSize > 0) {
+        FTI_Exec->ckptMeta.fs = FTI_Exec->encodedSize;
+    } else {
+        FTI_Exec->ckptMeta.fs = FTI_Exec->ckptSize;
+    }
 
 #ifdef ENABLE_HDF5
     if (FTI_Conf->ioMode == FTI_IO_HDF5) {
@@ -881,9 +945,9 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     }
 #endif
 
-    int32_t fileSizes[FTI_BUFS];
-    MPI_Allgather(&FTI_Exec->ckptMeta.fs, 1, MPI_INT32_T,
-            fileSizes, 1, MPI_INT32_T, FTI_Exec->groupComm);
+    int64_t fileSizes[FTI_BUFS];
+    MPI_Allgather(&FTI_Exec->ckptMeta.fs, 1, MPI_INT64_T,
+            fileSizes, 1, MPI_INT64_T, FTI_Exec->groupComm);
 
     // update partner file size:
     if (FTI_Exec->ckptMeta.level == 2) {
@@ -892,16 +956,20 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTI_Exec->ckptMeta.pfs = fileSizes[ptnerGroupRank];
     }
 
-    int32_t mfs = 0;  // Max file size in group
+    int64_t mfs = 0;  // Max file size in group
     int i;
     for (i = 0; i < FTI_Topo->groupSize; i++) {
         if (fileSizes[i] > mfs) {
             mfs = fileSizes[i];  // Search max. size
         }
     }
+    // the L3 codes work on words or units of packets, the encoded files
+    // must not end in the middle of one
+    int64_t ws = FTI_L3Alignment(FTI_Conf);
+    mfs = ((mfs + ws - 1) / ws) * ws;
     FTI_Exec->ckptMeta.maxFs = mfs;
     char str[FTI_BUFS];  // For console output
-    snprintf(str, FTI_BUFS, "Max. file size in group %u.", mfs);
+    snprintf(str, FTI_BUFS, "Max. file size in group %ld.", mfs);
     FTI_Print(str, FTI_DBUG);
 
     char* ckptFileNames = NULL;
@@ -936,11 +1004,12 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     int* allVarIDs = NULL;
     int* allVarTypeIDs = NULL;
     int* allVarTypeSizes = NULL;
-    int32_t* allVarSizes = NULL;
-    int32_t *allVarPositions = NULL;
+    int* allVarCodecs = NULL;
+    int64_t* allVarSizes = NULL;
+    int64_t *allVarPositions = NULL;
 
     // for posix dcp
-    uint32_t* allLayerSizes = NULL;
+    uint64_t* allLayerSizes = NULL;
     char* allLayerHashes = NULL;
     char* allCharIds = NULL;
     char* allNames = NULL;
@@ -957,15 +1026,16 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         allVarIDs = talloc(int, FTI_Topo->groupSize * FTI_Exec->nbVar);
         allVarTypeIDs = talloc(int, FTI_Topo->groupSize * FTI_Exec->nbVar);
         allVarTypeSizes = talloc(int, FTI_Topo->groupSize * FTI_Exec->nbVar);
-        allVarSizes = talloc(int32_t, FTI_Topo->groupSize * FTI_Exec->nbVar);
-        allVarPositions = talloc(int32_t,
+        allVarCodecs = talloc(int, FTI_Topo->groupSize * FTI_Exec->nbVar);
+        allVarSizes = talloc(int64_t, FTI_Topo->groupSize * FTI_Exec->nbVar);
+        allVarPositions = talloc(int64_t,
          FTI_Topo->groupSize * FTI_Exec->nbVar);
         allCharIds = (char *)malloc(sizeof(char)*FTI_BUFS*
           FTI_Exec->nbVar*FTI_Topo->groupSize);
         allNames = (char *)malloc(sizeof(char)*FTI_BUFS*
           FTI_Exec->nbVar*FTI_Topo->groupSize);
         if (FTI_Ckpt[FTI_Exec->ckptMeta.level].isDcp) {
-            allLayerSizes = talloc(uint32_t,
+            allLayerSizes = talloc(uint64_t,
              FTI_Topo->groupSize * nbLayer);
             allLayerHashes = talloc(char,
              FTI_Topo->groupSize * nbLayer * MD5_DIGEST_STRING_LENGTH);
@@ -977,15 +1047,17 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     uint64_t* myCounts = talloc(uint64_t, 32 * FTI_Exec->nbVar);
     int* myVarTypeIDs = talloc(int, FTI_Exec->nbVar);
     int* myVarTypeSizes = talloc(int, FTI_Exec->nbVar);
-    int32_t* myVarSizes = talloc(int32_t, FTI_Exec->nbVar);
-    int32_t* myVarPositions = talloc(int32_t, FTI_Exec->nbVar);
+    int* myVarCodecs = talloc(int, FTI_Exec->nbVar);
+    int64_t* myVarSizes = talloc(int64_t, FTI_Exec->nbVar);
+    int64_t* myVarPositions = talloc(int64_t, FTI_Exec->nbVar);
     char *ArrayOfIdChars = (char *)malloc(FTI_Exec->nbVar *
      sizeof(char*) *FTI_BUFS);
     char *ArrayOfNames = (char *)malloc(FTI_Exec->nbVar *
      sizeof(char*) *FTI_BUFS);
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
 
     for (i = 0; i < FTI_Exec->nbVar; i++) {
         int typeID = data[i].type->id - FTI_Exec->datatypes.primitive_offset;
@@ -993,6 +1065,7 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         myVarTypeIDs[i] = (typeID < FTI_Exec->datatypes.nprimitives) ?
           typeID : -1;
         myVarTypeSizes[i] = data[i].type->size;
+        myVarCodecs[i] = data[i].codec;
         myVarSizes[i] =  data[i].size;
         myVarIDs[i] =  data[i].id;
         myRanks[i] =  data[i].attribute.dim.ndims;
@@ -1012,6 +1085,9 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     // Gather variables Type Sizes
     MPI_Gather(myVarTypeSizes, FTI_Exec->nbVar, MPI_INT, allVarTypeSizes,
             FTI_Exec->nbVar,     MPI_INT, 0, FTI_Exec->groupComm);
+    // Gather variables codecs
+    MPI_Gather(myVarCodecs, FTI_Exec->nbVar, MPI_INT, allVarCodecs,
+     FTI_Exec->nbVar, MPI_INT, 0, FTI_Exec->groupComm);
     // Gather variables Ranks
     MPI_Gather(myRanks, FTI_Exec->nbVar, MPI_INT, allRanks, FTI_Exec->nbVar,
      MPI_INT, 0, FTI_Exec->groupComm);
@@ -1019,11 +1095,11 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     MPI_Gather(myCounts, 32*FTI_Exec->nbVar, MPI_INT64_T,
             allCounts, 32*FTI_Exec->nbVar, MPI_INT64_T, 0, FTI_Exec->groupComm);
     // Gather variables sizes
-    MPI_Gather(myVarSizes, FTI_Exec->nbVar, MPI_INT32_T, allVarSizes,
-     FTI_Exec->nbVar, MPI_INT32_T, 0, FTI_Exec->groupComm);
+    MPI_Gather(myVarSizes, FTI_Exec->nbVar, MPI_INT64_T, allVarSizes,
+     FTI_Exec->nbVar, MPI_INT64_T, 0, FTI_Exec->groupComm);
     // Gather variables file positions
-    MPI_Gather(myVarPositions, FTI_Exec->nbVar, MPI_INT32_T, allVarPositions,
-     FTI_Exec->nbVar, MPI_INT32_T, 0, FTI_Exec->groupComm);
+    MPI_Gather(myVarPositions, FTI_Exec->nbVar, MPI_INT64_T, allVarPositions,
+     FTI_Exec->nbVar, MPI_INT64_T, 0, FTI_Exec->groupComm);
     // Gather all variable idchars
     MPI_Gather(ArrayOfIdChars, FTI_Exec->nbVar*FTI_BUFS, MPI_CHAR,
       allCharIds, FTI_Exec->nbVar*FTI_BUFS, MPI_CHAR, 0, FTI_Exec->groupComm);
@@ -1034,8 +1110,8 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     if (FTI_Ckpt[FTI_Exec->ckptMeta.level].isDcp) {
         // Gather dcp layer sizes
-        MPI_Gather(FTI_Exec->dcpInfoPosix.LayerSize, nbLayer, MPI_UINT32_T,
-         allLayerSizes, nbLayer, MPI_UINT32_T, 0, FTI_Exec->groupComm);
+        MPI_Gather(FTI_Exec->dcpInfoPosix.LayerSize, nbLayer, MPI_UINT64_T,
+         allLayerSizes, nbLayer, MPI_UINT64_T, 0, FTI_Exec->groupComm);
         // Gather dcp layer hashes
         MPI_Gather(FTI_Exec->dcpInfoPosix.LayerHash,
          nbLayer * MD5_DIGEST_STRING_LENGTH, MPI_CHAR, allLayerHashes,
@@ -1047,6 +1123,7 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     free(myCounts);
     free(myVarTypeIDs);
     free(myVarTypeSizes);
+    free(myVarCodecs);
     free(myVarSizes);
     free(myVarPositions);
     free(ArrayOfIdChars);
@@ -1057,12 +1134,13 @@ int FTI_CreateMetadata(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         int res = FTI_Try(FTI_WriteMetadata(FTI_Conf, FTI_Exec, FTI_Topo,
          FTI_Ckpt, fileSizes, mfs, ckptFileNames, checksums, allVarIDs,
          allRanks, allCounts,
-         allVarTypeIDs, allVarTypeSizes,
+         allVarTypeIDs, allVarTypeSizes, allVarCodecs,
          allVarSizes, allLayerSizes, allLayerHashes, allVarPositions,
           allNames, allCharIds), "write the metadata.");
         free(allVarIDs);
         free(allVarTypeIDs);
         free(allVarTypeSizes);
+        free(allVarCodecs);
         free(allVarSizes);
         free(allCharIds);
         free(allNames);
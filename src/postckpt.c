@@ -60,115 +60,268 @@ int FTI_Local(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     return FTI_SCES;
 }
 
+/** Source of the data sent to the partner **/
+typedef struct FTIT_ptnerSrc {
+    FILE*           fd;             /**< Local checkpoint file, or NULL       */
+    FTIT_dataset*   data;           /**< Protected datasets, if no file       */
+    int             nbVar;          /**< Number of datasets                   */
+    int             cur;            /**< Dataset holding the next byte        */
+} FTIT_ptnerSrc;
+
 /*-------------------------------------------------------------------------*/
 /**
-  @brief      It sends Ckpt file.
+  @brief      Returns the size of the chunks of an L2 transfer.
   @param      FTI_Conf        Configuration metadata.
-  @param      FTI_Exec        Execution metadata.
-  @param      FTI_Ckpt        Checkpoint metadata.
-  @param      destination     destination group rank
-  @param      postFlag        0 if postckpt done by approc, > 0 if by head
-  @return     integer         FTI_SCES if successful.
+  @param      size            Size of the file to transfer.
+  @return     integer         The chunk size.
 
-  This function sends ckpt file to partner process. Partner should call
-  FTI_RecvPtner to receive this file.
+  Small files are sent in blocks of 'Advanced:block_size', larger ones in
+  FTI_L2_CHUNKS chunks of at most FTI_L2_MAX_CHUNK bytes. Both sides of a
+  transfer know the size of the file, so they compute the same chunks.
 
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_SendCkpt(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_checkpoint* FTI_Ckpt, int destination, int postFlag) {
-    char lfn[FTI_BUFS], str[FTI_BUFS];
-    snprintf(lfn, FTI_BUFS, "%s/%s", FTI_Conf->lTmpDir,
-     FTI_Exec->ckptMeta.ckptFile);
+static int FTI_PtnerChunk(FTIT_configuration* FTI_Conf, int64_t size) {
+    int64_t chunk = (size + FTI_L2_CHUNKS - 1) / FTI_L2_CHUNKS;
+    chunk = ((chunk + FTI_Conf->blockSize - 1) / FTI_Conf->blockSize) *
+     FTI_Conf->blockSize;
+    if (chunk > FTI_L2_MAX_CHUNK) chunk = FTI_L2_MAX_CHUNK;
+    if (chunk < FTI_Conf->blockSize) chunk = FTI_Conf->blockSize;
+    return (int) chunk;
+}
 
-    // PostFlag is set to 0 if Post-processing is inline and set to
-    // processes nodeID if Post-processing done by head
-    if (postFlag) {
-        snprintf(str, FTI_BUFS,
-         "L2 trying to access process's %d ckpt. file (%s).", postFlag, lfn);
-    } else {
-        snprintf(str, FTI_BUFS,
-         "L2 trying to access local ckpt. file (%s).", lfn);
-    }
-    FTI_Print(str, FTI_DBUG);
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Selects the protected datasets as source of the L2 copy.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Data        Dataset metadata.
+  @param      src             The source of the transfer.
+  @return     integer         FTI_SCES if the datasets can be sent.
+
+  Only possible if the checkpoint file is the concatenation of the
+  datasets in host memory, i.e. without codec and metadata in the file.
 
-    FILE* lfd = fopen(lfn, "rb");
-    if (lfd == NULL) {
-        FTI_Print("FTI failed to open L2 Ckpt. file.", FTI_DBUG);
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_PtnerFromMemory(FTIT_execution* FTI_Exec,
+        FTIT_keymap* FTI_Data, FTIT_ptnerSrc* src) {
+    FTIT_dataset* data;
+    if (FTI_Exec->encodedSize > 0 ||
+     FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES) {
         return FTI_NSCS;
     }
-
-    char* buffer = talloc(char, FTI_Conf->blockSize);
-    int32_t toSend = FTI_Exec->ckptMeta.fs;  // remaining data to send
-    while (toSend > 0) {
-        int sendSize = (toSend > FTI_Conf->blockSize) ?
-         FTI_Conf->blockSize : toSend;
-        int bytes;
-        FREAD(FTI_NSCS, bytes, buffer, sizeof(char), sendSize, lfd, "p",
-         buffer);
-        MPI_Send(buffer, bytes, MPI_CHAR, destination, FTI_Conf->generalTag,
-         FTI_Exec->groupComm);
-        toSend -= bytes;
+    int64_t pos = 0;
+    int i;
+    for (i = 0; i < FTI_Exec->nbVar; i++) {
+        if (data[i].isDevicePtr || data[i].filePos != pos) {
+            return FTI_NSCS;
+        }
+        pos += data[i].size;
+    }
+    if (pos != FTI_Exec->ckptMeta.fs) {
+        return FTI_NSCS;
     }
+    src->data = data;
+    src->nbVar = FTI_Exec->nbVar;
+    src->cur = 0;
+    return FTI_SCES;
+}
 
-    free(buffer);
-    fclose(lfd);
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the next chunk to send to the partner.
+  @param      src             The source of the transfer.
+  @param      buffer          Staging buffer of the chunk.
+  @param      pos             Position of the chunk in the file.
+  @param      size            Size of the chunk.
+  @return     char*           The chunk, NULL on error.
 
-    return FTI_SCES;
+  Chunks of the file are read into the buffer. With the datasets as
+  source, a chunk within one dataset is sent from the dataset itself,
+  the others are gathered into the buffer.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static char* FTI_PtnerFill(FTIT_ptnerSrc* src, char* buffer, int64_t pos,
+        int size) {
+    if (src->fd != NULL) {
+        if (fread(buffer, 1, size, src->fd) != (size_t) size) {
+            return NULL;
+        }
+        return buffer;
+    }
+
+    FTIT_dataset* data = src->data;
+    while (src->cur < src->nbVar &&
+     data[src->cur].filePos + data[src->cur].size <= pos) {
+        src->cur++;
+    }
+    if (src->cur == src->nbVar) {
+        return NULL;
+    }
+    int64_t off = pos - data[src->cur].filePos;
+    if (off + size <= data[src->cur].size) {
+        return (char*) data[src->cur].ptr + off;
+    }
+    int done = 0;
+    int i = src->cur;
+    while (done < size && i < src->nbVar) {
+        int64_t len = data[i].size - off;
+        if (len > size - done) len = size - done;
+        memcpy(buffer + done, (char*) data[i].ptr + off, len);
+        done += len;
+        off = 0;
+        i++;
+    }
+    return (done == size) ? buffer : NULL;
 }
 
 /*-------------------------------------------------------------------------*/
 /**
-  @brief      It receives Ptner file.
+  @brief      Exchanges the checkpoint files with the partners.
   @param      FTI_Conf        Configuration metadata.
   @param      FTI_Exec        Execution metadata.
-  @param      FTI_Ckpt        Checkpoint metadata.
+  @param      FTI_Data        Dataset metadata, NULL to read the file.
+  @param      destination     destination group rank
   @param      source          souce group rank
   @param      postFlag        0 if postckpt done by approc, > 0 if by head
   @return     integer         FTI_SCES if successful.
 
-  This function receives ckpt file from partner process aand saves it as
-  Ptner file. Partner should call FTI_SendCkpt to send file.
+  The ckpt. file is sent to the destination while the file of the source
+  is received and saved as Ptner file. Both directions use two buffers
+  and nonblocking messages, so reading the next chunk, sending, receiving
+  and writing the previous chunk overlap. On a local I/O error, the
+  transfer is completed, so that the partners do not block, and the
+  error is returned.
 
  **/
 /*-------------------------------------------------------------------------*/
-int FTI_RecvPtner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_checkpoint* FTI_Ckpt, int source, int postFlag) {
+static int FTI_ExchangePtner(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data, int destination,
+        int source, int postFlag) {
+    char lfn[FTI_BUFS], pfn[FTI_BUFS], str[FTI_BUFS];
+    snprintf(lfn, FTI_BUFS, "%s/%s", FTI_Conf->lTmpDir,
+     FTI_Exec->ckptMeta.ckptFile);
+
     // heads need to use ckptFile to get ckptId and rank
     int ckptId, rank;
     sscanf(FTI_Exec->ckptMeta.ckptFile, "Ckpt%d-Rank%d.%s", &ckptId, &rank,
      FTI_Conf->suffix);
-
-    char pfn[FTI_BUFS], str[FTI_BUFS];
     snprintf(pfn, FTI_BUFS, "%s/Ckpt%d-Pcof%d.%s", FTI_Conf->lTmpDir, ckptId,
      rank, FTI_Conf->suffix);
+
+    int res = FTI_SCES;
+    FTIT_ptnerSrc src = {0};
+    if (FTI_Data == NULL ||
+     FTI_PtnerFromMemory(FTI_Exec, FTI_Data, &src) != FTI_SCES) {
+        // PostFlag is set to 0 if Post-processing is inline and set to
+        // processes nodeID if Post-processing done by head
+        if (postFlag) {
+            snprintf(str, FTI_BUFS,
+             "L2 trying to access process's %d ckpt. file (%s).", postFlag,
+             lfn);
+        } else {
+            snprintf(str, FTI_BUFS,
+             "L2 trying to access local ckpt. file (%s).", lfn);
+        }
+        FTI_Print(str, FTI_DBUG);
+        src.fd = fopen(lfn, "rb");
+        if (src.fd == NULL) {
+            FTI_Print("FTI failed to open L2 Ckpt. file.", FTI_DBUG);
+            res = FTI_NSCS;
+        }
+    } else {
+        FTI_Print("L2 sending the protected datasets.", FTI_DBUG);
+    }
+
     snprintf(str, FTI_BUFS, "L2 trying to access Ptner file (%s).", pfn);
     FTI_Print(str, FTI_DBUG);
-
     FILE* pfd = fopen(pfn, "wb");
     if (pfd == NULL) {
         FTI_Print("FTI failed to open L2 ptner file.", FTI_DBUG);
-        return FTI_NSCS;
+        res = FTI_NSCS;
     }
 
-    char* buffer = talloc(char, FTI_Conf->blockSize);
-    uint32_t toRecv = FTI_Exec->ckptMeta.pfs;
-    // remaining data to receive
-    while (toRecv > 0) {
-        int recvSize = (toRecv > FTI_Conf->blockSize) ?
-         FTI_Conf->blockSize : toRecv;
-        MPI_Recv(buffer, recvSize, MPI_CHAR, source, FTI_Conf->generalTag,
-         FTI_Exec->groupComm, MPI_STATUS_IGNORE);
-        size_t wbytes;
-        FWRITE(FTI_NSCS, wbytes, buffer, sizeof(char), recvSize, pfd, "p",
-         buffer);
-        toRecv -= recvSize;
+    int sendChunk = FTI_PtnerChunk(FTI_Conf, FTI_Exec->ckptMeta.fs);
+    int recvChunk = FTI_PtnerChunk(FTI_Conf, FTI_Exec->ckptMeta.pfs);
+    char* sendBuf[2];
+    char* recvBuf[2];
+    MPI_Request sendReq[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+    MPI_Request recvReq[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+    int k;
+    for (k = 0; k < 2; k++) {
+        sendBuf[k] = talloc(char, sendChunk);
+        recvBuf[k] = talloc(char, recvChunk);
     }
 
-    free(buffer);
-    fclose(pfd);
+    int64_t toSend = FTI_Exec->ckptMeta.fs;  // remaining data to send
+    int64_t toRecv = FTI_Exec->ckptMeta.pfs;  // remaining data to receive
+    int64_t posted = 0;  // data for which a receive is posted
+    for (k = 0; k < 2 && posted < toRecv; k++) {
+        int size = (toRecv - posted > recvChunk) ? recvChunk :
+         toRecv - posted;
+        MPI_Irecv(recvBuf[k], size, MPI_CHAR, source, FTI_Conf->generalTag,
+         FTI_Exec->groupComm, &recvReq[k]);
+        posted += size;
+    }
 
-    return FTI_SCES;
+    int64_t sent = 0, recvd = 0;
+    int sendIdx = 0, recvIdx = 0;
+    while (sent < toSend || recvd < toRecv) {
+        if (sent < toSend) {
+            int slot = sendIdx % 2;
+            int size = (toSend - sent > sendChunk) ? sendChunk :
+             toSend - sent;
+            // the buffer is free once the send two chunks ago completed
+            MPI_Wait(&sendReq[slot], MPI_STATUS_IGNORE);
+            char* chunk = sendBuf[slot];
+            if (res == FTI_SCES) {
+                chunk = FTI_PtnerFill(&src, sendBuf[slot], sent, size);
+                if (chunk == NULL) {
+                    FTI_Print("FTI failed to read L2 Ckpt. file.", FTI_EROR);
+                    chunk = sendBuf[slot];
+                    res = FTI_NSCS;
+                }
+            }
+            MPI_Isend(chunk, size, MPI_CHAR, destination,
+             FTI_Conf->generalTag, FTI_Exec->groupComm, &sendReq[slot]);
+            sent += size;
+            sendIdx++;
+        }
+        if (recvd < toRecv) {
+            int slot = recvIdx % 2;
+            int size = (toRecv - recvd > recvChunk) ? recvChunk :
+             toRecv - recvd;
+            MPI_Wait(&recvReq[slot], MPI_STATUS_IGNORE);
+            if (res == FTI_SCES &&
+             fwrite(recvBuf[slot], 1, size, pfd) != (size_t) size) {
+                FTI_Print("FTI failed to write L2 ptner file.", FTI_EROR);
+                res = FTI_NSCS;
+            }
+            recvd += size;
+            recvIdx++;
+            if (posted < toRecv) {
+                size = (toRecv - posted > recvChunk) ? recvChunk :
+                 toRecv - posted;
+                MPI_Irecv(recvBuf[slot], size, MPI_CHAR, source,
+                 FTI_Conf->generalTag, FTI_Exec->groupComm, &recvReq[slot]);
+                posted += size;
+            }
+        }
+    }
+    MPI_Waitall(2, sendReq, MPI_STATUSES_IGNORE);
+
+    for (k = 0; k < 2; k++) {
+        free(sendBuf[k]);
+        free(recvBuf[k]);
+    }
+    if (src.fd != NULL) {
+        fclose(src.fd);
+    }
+    if (pfd != NULL && fclose(pfd) != 0) {
+        res = FTI_NSCS;
+    }
+    return res;
 }
 
 /*-------------------------------------------------------------------------*/
@@ -178,16 +331,20 @@ int FTI_RecvPtner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
   @param      FTI_Exec        Execution metadata.
   @param      FTI_Topo        Topology metadata.
   @param      FTI_Ckpt        Checkpoint metadata.
+  @param      FTI_Data        Dataset metadata, NULL if not in memory.
   @return     integer         FTI_SCES if successful.
 
   This function copies the checkpoint files into the partner node. It
   follows a ring, where the ring size is the group size given in the FTI
-  configuration file.
+  configuration file. All the processes send and receive at the same
+  time. With 'Advanced:l2_from_memory', the application processes send
+  the protected datasets instead of reading back the checkpoint file.
 
  **/
 /*-------------------------------------------------------------------------*/
 int FTI_Ptner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt) {
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data) {
     FTI_Print("Starting checkpoint post-processing L2", FTI_DBUG);
     int startProc, endProc;
     if (FTI_Topo->amIaHead) {  // post-processing for every process in the node
@@ -197,42 +354,427 @@ int FTI_Ptner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         startProc = 0;
         endProc = 1;
     }
+    // the files of the other I/O modes are not the plain datasets
+    if (!FTI_Conf->l2FromMemory || FTI_Topo->amIaHead ||
+     (FTI_Conf->ioMode != FTI_IO_POSIX && FTI_Conf->ioMode != FTI_IO_MPI &&
+      FTI_Conf->ioMode != FTI_IO_IME && FTI_Conf->ioMode != FTI_IO_IOURING)) {
+        FTI_Data = NULL;
+    }
 
     int source = FTI_Topo->left;  // receive Ckpt file from this process
     int destination = FTI_Topo->right;  // send Ckpt file to this process
-    int i;
+    int i, res = FTI_SCES;
     for (i = startProc; i < endProc; i++) {
         if (FTI_Topo->amIaHead) {
-            int res = FTI_Try(FTI_LoadMetaPostprocessing(FTI_Conf, FTI_Exec,
-             FTI_Topo, FTI_Ckpt, i), "load temporary metadata.");
-            if (res != FTI_SCES) {
+            if (FTI_Try(FTI_LoadMetaPostprocessing(FTI_Conf, FTI_Exec,
+             FTI_Topo, FTI_Ckpt, i), "load temporary metadata.") !=
+             FTI_SCES) {
                 return FTI_NSCS;
             }
         }
-        if (FTI_Topo->groupRank % 2) {  // first send, then receive
-            int res = FTI_SendCkpt(FTI_Conf, FTI_Exec, FTI_Ckpt, destination,
-             i);
-            if (res != FTI_SCES) {
-                return FTI_NSCS;
+        // the partners wait for the next files, even after an error
+        if (FTI_ExchangePtner(FTI_Conf, FTI_Exec, FTI_Data, destination,
+         source, i) != FTI_SCES) {
+            res = FTI_NSCS;
+        }
+    }
+    return res;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the code of the L3 files written with this setup.
+  @param      FTI_Conf        Configuration metadata.
+  @return     integer         The code, as stored in the metadata.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_L3Code(FTIT_configuration* FTI_Conf) {
+    return FTI_L3_CODE(FTI_Conf->l3Code, FTI_Conf->l3WordSize);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Returns the alignment of the L3 files.
+  @param      FTI_Conf        Configuration metadata.
+  @return     integer         The alignment in bytes.
+
+  The encoded files must not end in the middle of a word or, with the
+  Cauchy code, in the middle of a unit of packets.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int64_t FTI_L3Alignment(FTIT_configuration* FTI_Conf) {
+    if (FTI_Conf->l3Code == FTI_L3_CAUCHY) {
+        return FTI_Conf->l3WordSize * FTI_L3_PACKET;
+    }
+    return FTI_Conf->l3WordSize / 8;
+}
+
+/* number of ones in the bit matrix of a field element */
+static int FTI_L3Ones(int e, int w) {
+    int ones = 0, x, b;
+    for (x = 0; x < w; x++) {
+        for (b = 0; b < w; b++) {
+            ones += (e >> b) & 1;
+        }
+        e = galois_single_multiply(e, 2, w);
+    }
+    return ones;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Builds the coding matrix of a group.
+  @param      k               Group size.
+  @param      code            The L3 code.
+  @return     int*            The k x k matrix, to be freed by the caller.
+
+  The matrix is the Cauchy matrix 1 / (i ^ (k + j)) over GF(2^w). For
+  the Cauchy code, its columns and rows are divided by the factor that
+  minimizes the number of ones of the bit matrix, which is the number of
+  XORs of the encoding. This keeps every square sub-matrix invertible.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int* FTI_L3Matrix(int k, int code) {
+    int w = FTI_L3_WORD(code);
+    int* matrix = talloc(int, k * k);
+    int i, j, l;
+    for (i = 0; i < k; i++) {
+        for (j = 0; j < k; j++) {
+            matrix[i * k + j] = galois_single_divide(1, i ^ (k + j), w);
+        }
+    }
+    if (FTI_L3_FAMILY(code) != FTI_L3_CAUCHY) {
+        return matrix;
+    }
+    // the first row becomes ones, encoded with XORs only
+    for (j = 0; j < k; j++) {
+        int factor = matrix[j];
+        for (i = 0; i < k; i++) {
+            matrix[i * k + j] = galois_single_divide(matrix[i * k + j],
+             factor, w);
+        }
+    }
+    for (i = 1; i < k; i++) {
+        int* row = matrix + i * k;
+        int best = 0, bestOnes = 0;
+        for (j = 0; j < k; j++) {
+            bestOnes += FTI_L3Ones(row[j], w);
+        }
+        for (l = 0; l < k; l++) {
+            int ones = 0;
+            for (j = 0; j < k; j++) {
+                ones += FTI_L3Ones(galois_single_divide(row[j], row[l], w),
+                 w);
             }
-            res = FTI_RecvPtner(FTI_Conf, FTI_Exec, FTI_Ckpt, source, i);
-            if (res != FTI_SCES) {
-                return FTI_NSCS;
+            if (ones < bestOnes) {
+                bestOnes = ones;
+                best = row[l];
             }
-        } else {  // first receive, then send
-            int res = FTI_RecvPtner(FTI_Conf, FTI_Exec, FTI_Ckpt, source, i);
-            if (res != FTI_SCES) {
-                return FTI_NSCS;
+        }
+        if (best != 0) {
+            for (j = 0; j < k; j++) {
+                row[j] = galois_single_divide(row[j], best, w);
             }
-            res = FTI_SendCkpt(FTI_Conf, FTI_Exec, FTI_Ckpt, destination, i);
-            if (res != FTI_SCES) {
-                return FTI_NSCS;
+        }
+    }
+    return matrix;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Prepares the task computing a block from a stripe.
+  @param      task            The task.
+  @param      code            The L3 code.
+  @param      row             Matrix row of the computed block.
+  @param      k               Group size.
+  @param      bs              Block size.
+  @param      nbThreads       Threads sharing the task.
+  @return     integer         Number of slices of a block.
+
+  The RS code multiplies the words of the blocks by the factors of the
+  row. The Cauchy code turns the row into a bit matrix and works on
+  units of w packets with a smart XOR schedule, a slice is one unit.
+  The block size must be a multiple of the unit.
+
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_L3InitTask(FTIT_rsencTask* task, int code, int* row, int k, int bs,
+        int nbThreads) {
+    task->row = row;
+    task->groupSize = k;
+    task->bs = bs;
+    task->w = FTI_L3_WORD(code);
+    task->schedule = NULL;
+    task->packetSize = 0;
+
+    bool nonZero = false;
+    int j;
+    for (j = 0; j < k; j++) {
+        nonZero |= (row[j] != 0);
+    }
+    if (FTI_L3_FAMILY(code) == FTI_L3_CAUCHY && nonZero) {
+        int* bitmatrix = jerasure_matrix_to_bitmatrix(k, 1, task->w, row);
+        task->schedule = jerasure_smart_bitmatrix_to_schedule(k, 1, task->w,
+         bitmatrix);
+        free(bitmatrix);
+        task->packetSize = FTI_L3_PACKET;
+        task->sliceSize = task->w * FTI_L3_PACKET;
+        return bs / task->sliceSize;
+    }
+    // slices are multiple of 4KB to keep the SIMD regions aligned
+    task->sliceSize = ((bs / nbThreads + 4095) / 4096) * 4096;
+    if (task->sliceSize > bs || task->sliceSize == 0) {
+        task->sliceSize = bs;
+    }
+    return (bs + task->sliceSize - 1) / task->sliceSize;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Frees the schedule of a task.
+  @param      task            The task.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_L3FreeTask(FTIT_rsencTask* task) {
+    if (task->schedule != NULL) {
+        jerasure_free_schedule(task->schedule);
+        task->schedule = NULL;
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Encodes one slice of the current stripe.
+  @param      arg             The encoding task (FTIT_rsencTask).
+  @param      idx             Index of the slice.
+  @return     void.
+
+  Computes the slice of the coding block as the sum, over the group
+  members, of their data multiplied by the factor of the encoding matrix.
+  With the Cauchy code, a slice is a unit of packets and the sum is done
+  by the XOR schedule. Slices are independent, so they can be encoded by
+  different threads. The L3 decoding uses it with the rows of the
+  inverted matrix.
+
+ **/
+/*-------------------------------------------------------------------------*/
+void FTI_RSencSlice(void* arg, int idx) {
+    FTIT_rsencTask* task = (FTIT_rsencTask*) arg;
+    int lo = idx * task->sliceSize;
+    int len = task->bs - lo;
+    if (len > task->sliceSize) len = task->sliceSize;
+
+    char* coding = task->coding + lo;
+    int i;
+    if (task->schedule != NULL) {
+        // same as jerasure_do_scheduled_operations, without the counters
+        // shared by the threads
+        int** op;
+        for (op = task->schedule; (*op)[0] >= 0; op++) {
+            char* src = ((*op)[0] < task->groupSize) ? task->stripe +
+             (size_t) (*op)[0] * task->bs + lo : coding;
+            char* dst = ((*op)[2] < task->groupSize) ? task->stripe +
+             (size_t) (*op)[2] * task->bs + lo : coding;
+            src += (size_t) (*op)[1] * task->packetSize;
+            dst += (size_t) (*op)[3] * task->packetSize;
+            if ((*op)[4]) {
+                galois_region_xor(src, dst, task->packetSize);
+            } else {
+                memcpy(dst, src, task->packetSize);
+            }
+        }
+        return;
+    }
+
+    int init = 0;
+    for (i = 0; i < task->groupSize; i++) {
+        int matVal = task->row[i];
+        char* data = task->stripe + (size_t) i * task->bs + lo;
+        // First copy or xor any data that does not need
+        // to be multiplied by a factor
+        if (matVal == 1) {
+            if (init == 0) {
+                memcpy(coding, data, len);
+            } else {
+                galois_region_xor(data, coding, len);
+            }
+            init = 1;
+        }
+        // Then the data that needs to be multiplied by a factor
+        if (matVal != 0 && matVal != 1) {
+            switch (task->w) {
+                case 8:
+                    galois_w08_region_multiply(data, matVal, len, coding,
+                     init);
+                    break;
+                case 32:
+                    galois_w32_region_multiply(data, matVal, len, coding,
+                     init);
+                    break;
+                default:
+                    galois_w16_region_multiply(data, matVal, len, coding,
+                     init);
             }
+            init = 1;
         }
     }
+    if (init == 0) {
+        memset(coding, 0x0, len);
+    }
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads a block and posts its exchange within the group.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      lfd             Checkpoint file.
+  @param      stripe          Stripe buffer receiving the blocks.
+  @param      bytes           Number of bytes to read.
+  @param      reqs            Requests of the exchange.
+  @return     integer         FTI_SCES if successful.
+
+  Each member sends its block to all the other members of the group, the
+  requests are completed by the caller.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_RSencPostBlock(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo, FILE* lfd,
+        char* stripe, int bytes, MPI_Request* reqs) {
+    int bs = FTI_Conf->blockSize;
+    char* myData = stripe + (size_t) FTI_Topo->groupRank * bs;
+
+    // the last block is zero padded for all the members
+    if (bytes < bs) {
+        bzero(stripe, (size_t) FTI_Topo->groupSize * bs);
+    }
+    size_t read = fread(myData, sizeof(char), bytes, lfd);
+    if (ferror(lfd) || read != bytes) {
+        FTI_Print("FTI failed to read L3 checkpoint file.", FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    int n = 0, cnt;
+    for (cnt = 1; cnt < FTI_Topo->groupSize; cnt++) {
+        int src = (FTI_Topo->groupRank + cnt) % FTI_Topo->groupSize;
+        int dest = (FTI_Topo->groupRank + FTI_Topo->groupSize - cnt) %
+         FTI_Topo->groupSize;
+        MPI_Irecv(stripe + (size_t) src * bs, bs, MPI_CHAR, src,
+         FTI_Conf->generalTag, FTI_Exec->groupComm, &reqs[n++]);
+        MPI_Isend(myData, bytes, MPI_CHAR, dest, FTI_Conf->generalTag,
+         FTI_Exec->groupComm, &reqs[n++]);
+    }
     return FTI_SCES;
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Computes the RS encoded file of a checkpoint file.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      lfd             Checkpoint file (padded to maxFs).
+  @param      efd             Encoded file.
+  @param      maxFs           Maximum file size in the group.
+  @param      mdContext       Checksum of the encoded file.
+  @return     integer         FTI_SCES if successful.
+
+  The files are processed in stripes of one block per group member. Two
+  stripe buffers are used: the blocks of the next stripe are exchanged
+  while the current stripe is encoded. The encoding of a stripe is split
+  in slices among 'l3_threads' threads.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_RSencFile(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo, FILE* lfd,
+        FILE* efd, int64_t maxFs, MD5_CTX* mdContext) {
+    int bs = FTI_Conf->blockSize;
+    int groupSize = FTI_Topo->groupSize;
+    int nbReqs = 2 * (groupSize - 1);
+    int64_t nbBlocks = (maxFs + bs - 1) / bs;
+
+    int code = FTI_L3Code(FTI_Conf);
+    int* matrix = FTI_L3Matrix(groupSize, code);
+    // the fields are lazily initialized, do it before starting threads
+    galois_init_default_field(FTI_Conf->l3WordSize);
+    galois_init_default_field(32);
+
+    char* stripe[2];
+    stripe[0] = talloc(char, (size_t) groupSize * bs);
+    stripe[1] = talloc(char, (size_t) groupSize * bs);
+    char* coding = talloc(char, bs);
+    MPI_Request* reqs = talloc(MPI_Request, nbReqs > 0 ? nbReqs : 1);
+    bzero(stripe[0], (size_t) groupSize * bs);
+    bzero(stripe[1], (size_t) groupSize * bs);
+
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, FTI_Conf->l3Threads);
+
+    FTIT_rsencTask task;
+    int nbSlices = FTI_L3InitTask(&task, code,
+     &matrix[FTI_Topo->groupRank * groupSize], groupSize, bs,
+     pool.nbWorkers + 1);
+    task.coding = coding;
+
+    int res = FTI_SCES;
+    int64_t blk = 0;
+    if (nbBlocks > 0) {
+        int bytes = (maxFs < bs) ? maxFs : bs;
+        res = FTI_RSencPostBlock(FTI_Conf, FTI_Exec, FTI_Topo, lfd,
+         stripe[0], bytes, reqs);
+        if (res == FTI_SCES) {
+            MPI_Waitall(nbReqs, reqs, MPI_STATUSES_IGNORE);
+        }
+    }
+
+    for (blk = 0; blk < nbBlocks && res == FTI_SCES; blk++) {
+        int64_t pos = blk * bs;
+        int remBsize = ((maxFs - pos) < bs) ? (maxFs - pos) : bs;
+
+        task.stripe = stripe[blk % 2];
+        FTI_ThreadPoolSubmit(&pool, nbSlices, FTI_RSencSlice, &task);
+
+        // Exchange the next stripe while the current one is encoded
+        bool hasNext = (blk + 1 < nbBlocks);
+        if (hasNext) {
+            int bytes = ((maxFs - pos - bs) < bs) ? (maxFs - pos - bs) : bs;
+            res = FTI_RSencPostBlock(FTI_Conf, FTI_Exec, FTI_Topo, lfd,
+             stripe[(blk + 1) % 2], bytes, reqs);
+            if (res == FTI_SCES) {
+                MPI_Waitall(nbReqs, reqs, MPI_STATUSES_IGNORE);
+            }
+        }
+
+        FTI_ThreadPoolWait(&pool);
+        if (res != FTI_SCES) break;
+
+        // Writting encoded checkpoints
+        size_t written = fwrite(coding, sizeof(char), remBsize, efd);
+        if (ferror(efd) || written != remBsize) {
+            FTI_Print("FTI failed to write encoded ckpt. file.", FTI_EROR);
+            res = FTI_NSCS;
+            break;
+        }
+        MD5_Update(mdContext, coding, remBsize);
+    }
+
+    FTI_ThreadPoolFinalize(&pool);
+    FTI_L3FreeTask(&task);
+    free(reqs);
+    free(coding);
+    free(stripe[1]);
+    free(stripe[0]);
+    free(matrix);
+
+    return res;
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It performs RS encoding with the ckpt. files in to the group.
@@ -245,6 +787,7 @@ int FTI_Ptner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
   This function performs the Reed-Solomon encoding for a given group. The
   checkpoint files are padded to the maximum size of the largest checkpoint
   file in the group +- the extra space to be a multiple of block size.
+  The encoding itself is done by FTI_RSencFile.
 
  **/
 /*-------------------------------------------------------------------------*/
@@ -285,7 +828,7 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTI_Print(str, FTI_DBUG);
 
         // all files in group must have the same size
-        int32_t maxFs = FTI_Exec->ckptMeta.maxFs;  // max file size in group
+        int64_t maxFs = FTI_Exec->ckptMeta.maxFs;  // max file size in group
 
         // determine file size in order to write at the end of the elongated
         // file (i.e. write at the end of file after 'truncate(..., maxFs)'.
@@ -339,107 +882,15 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             return FTI_NSCS;
         }
 
-        int bs = FTI_Conf->blockSize;
-        char* myData = talloc(char, bs);
-        char* coding = talloc(char, bs);
-        char* data = talloc(char, 2 * bs);
-        int* matrix = talloc(int, FTI_Topo->groupSize* FTI_Topo->groupSize);
-
-        int i;
-        for (i = 0; i < FTI_Topo->groupSize; i++) {
-            int j;
-            for (j = 0; j < FTI_Topo->groupSize; j++) {
-                matrix[i * FTI_Topo->groupSize + j] = galois_single_divide(1,
-                 i ^ (FTI_Topo->groupSize + j), FTI_Conf->l3WordSize);
-            }
-        }
-
-
-
-        int remBsize = bs;
-        int32_t ps = ((maxFs / bs)) * bs;
-        if (ps < maxFs) {
-            ps = ps + bs;
-        }
-
         // for MD5 checksum
         MD5_CTX mdContext;
         MD5_Init(&mdContext);
 
-        // For each block
-        int32_t pos = 0;
-        while (pos < ps) {
-            if ((maxFs - pos) < bs) {
-                remBsize = maxFs - pos;
-            }
-
-            // Reading checkpoint files
-            bzero(coding, bs);
-            bzero(myData, bs);
-            bzero(data, 2*bs);
-            size_t bytes;
-            FREAD(FTI_NSCS, bytes, myData, sizeof(char), remBsize, lfd,
-             "ppppf", data, matrix, coding, myData, efd);
-            int dest = FTI_Topo->groupRank;
-            i = FTI_Topo->groupRank;
-            int offset = 0;
-            int init = 0;
-            int cnt = 0;
-
-            // For each encoding
-            MPI_Request reqSend, reqRecv;
-            // used between iterations in while loop
-            while (cnt < FTI_Topo->groupSize) {
-                if (cnt == 0) {
-                    memcpy(&(data[offset * bs]), myData, sizeof(char) * bytes);
-                } else {
-                    MPI_Wait(&reqSend, MPI_STATUS_IGNORE);
-                    MPI_Wait(&reqRecv, MPI_STATUS_IGNORE);
-                }
-
-                // At every loop *but* the last one we send the data
-                if (cnt != FTI_Topo->groupSize - 1) {
-                    dest = (dest + FTI_Topo->groupSize - 1) %
-                     FTI_Topo->groupSize;
-                    int src = (i + 1) % FTI_Topo->groupSize;
-                    MPI_Isend(myData, bytes, MPI_CHAR, dest,
-                     FTI_Conf->generalTag, FTI_Exec->groupComm, &reqSend);
-                    MPI_Irecv(&(data[(1 - offset) * bs]), bs,
-                     MPI_CHAR, src, FTI_Conf->generalTag,
-                      FTI_Exec->groupComm, &reqRecv);
-                }
-
-                int matVal = matrix[FTI_Topo->groupRank *
-                 FTI_Topo->groupSize + i];
-                // First copy or xor any data that does not need
-                // to be multiplied by a factor
-                if (matVal == 1) {
-                    if (init == 0) {
-                        memcpy(coding, &(data[offset * bs]), bs);
-                        init = 1;
-                    } else {
-                        galois_region_xor(&(data[offset * bs]), coding, bs);
-                    }
-                }
-
-                // Then the data that needs to be multiplied by a factor
-                if (matVal != 0 && matVal != 1) {
-                    galois_w16_region_multiply(&(data[offset * bs]), matVal,
-                     bs, coding, init);
-                    init = 1;
-                }
-
-                i = (i + 1) % FTI_Topo->groupSize;
-                offset = 1 - offset;
-                cnt++;
-            }
-
-            // Writting encoded checkpoints
-            fwrite(coding, sizeof(char), remBsize, efd);
-            MD5_Update(&mdContext, coding, remBsize);
-
-            // Next block
-            pos = pos + bs;
+        if (FTI_RSencFile(FTI_Conf, FTI_Exec, FTI_Topo, lfd, efd, maxFs,
+         &mdContext) != FTI_SCES) {
+            fclose(lfd);
+            fclose(efd);
+            return FTI_NSCS;
         }
 
         // create checksum hex-string
@@ -447,7 +898,7 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         MD5_Final(hash, &mdContext);
 
         char checksum[MD5_DIGEST_STRING_LENGTH];
-        int ii = 0;
+        int i, ii = 0;
         for (i = 0; i < MD5_DIGEST_LENGTH; i++) {
             snprintf(&checksum[ii], sizeof(char[3]), "%02x", hash[i]);
             ii+=2;
@@ -468,6 +919,8 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             FTIFFMeta->ckptId = ckptId;
             FTIFFMeta->maxFs = maxFs;
             FTIFFMeta->ckptSize = FTI_Exec->ckptMeta.fs;
+            FTIFFMeta->version = FTIFF_VERSION;
+            FTIFFMeta->l3Code = FTI_L3Code(FTI_Conf);
             strncpy(FTIFFMeta->checksum, checksum, MD5_DIGEST_STRING_LENGTH);
 
             // get hash of meta data
@@ -481,10 +934,6 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                  "FTI_RSenc - failed to allocate %d bytes for 'buffer_ser'",
                   FTI_dbvarstructsize);
                 FTI_Print(str, FTI_EROR);
-                free(data);
-                free(matrix);
-                free(coding);
-                free(myData);
                 fclose(lfd);
                 fclose(efd);
                 errno = 0;
@@ -494,10 +943,6 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
                 FTI_Print("FTI_RSenc - failed to serialize 'currentdbvar'",
                  FTI_EROR);
                 free(buffer_ser);
-                free(data);
-                free(matrix);
-                free(coding);
-                free(myData);
                 fclose(lfd);
                 fclose(efd);
                 errno = 0;
@@ -505,18 +950,14 @@ int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             }
             size_t wBytes = 0;
             FWRITE(FTI_NSCS, wBytes, buffer_ser, FTI_filemetastructsize, 1,
-             efd, "ppppf", data, matrix, coding, myData, lfd);
+             efd, "pf", buffer_ser, lfd);
             free(buffer_ser);
         }
 
-        free(data);
-        free(matrix);
-        free(coding);
-        free(myData);
         fclose(lfd);
         fclose(efd);
 
-        int32_t fs = FTI_Exec->ckptMeta.fs;  // ckpt file size
+        int64_t fs = FTI_Exec->ckptMeta.fs;  // ckpt file size
 
         if (truncate(lfn, fs) == -1) {
             FTI_Print("Error with re-truncate on checkpoint file", FTI_WARN);
@@ -563,6 +1004,7 @@ int FTI_Flush(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     snprintf(str, FTI_BUFS,
      "Starting checkpoint post-processing L4 for level %d", level);
     FTI_Print(str, FTI_DBUG);
+    double t0 = MPI_Wtime();
 
     if (!FTI_Exec->h5SingleFile) {
         if (!((FTI_Conf->dcpPosix || FTI_Conf->dcpFtiff) &&
@@ -588,6 +1030,7 @@ int FTI_Flush(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 #endif
         case FTI_IO_FTIFF:
         case FTI_IO_IME:
+        case FTI_IO_IOURING:
     case FTI_IO_POSIX:
             FTI_FlushPosix(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt, level);
             break;
@@ -601,6 +1044,7 @@ int FTI_Flush(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 #endif
     }
     //}
+    FTI_Exec->metrics.flushTime += MPI_Wtime() - t0;
 return FTI_SCES;
 }
 
@@ -654,6 +1098,7 @@ int FTI_ArchiveL4Ckpt(FTIT_configuration* FTI_Conf, FTIT_execution *FTI_Exec,
             return FTI_NSCS;
     }
     if ((FTI_Conf->ioMode == FTI_IO_POSIX) ||
+        (FTI_Conf->ioMode == FTI_IO_IOURING) ||
         (FTI_Conf->ioMode == FTI_IO_FTIFF) ||
         (FTI_Conf->ioMode == FTI_IO_HDF5)) {
         // if ( (FTI_Topo->nbHeads == 0) || (FTI_Ckpt[4].isInline &&
@@ -719,6 +1164,8 @@ int FTI_ArchiveL4Ckpt(FTIT_configuration* FTI_Conf, FTIT_execution *FTI_Exec,
   @return     integer         FTI_SCES if successful.
 
   This function flushes the local checkpoint files in to the PFS.
+  The files of all the processes handled are copied at once by the
+  transfer engine (see FTI_TransferFiles).
 
  **/
 /*-------------------------------------------------------------------------*/
@@ -735,79 +1182,62 @@ int FTI_FlushPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         endProc = 1;
     }
 
+    FTIT_transfer* jobs = talloc(FTIT_transfer, endProc - startProc);
     for (proc = startProc; proc < endProc; proc++) {
         if (FTI_Topo->amIaHead) {
             int res = FTI_Try(FTI_LoadMetaPostprocessing(FTI_Conf, FTI_Exec,
              FTI_Topo, FTI_Ckpt, proc), "load temporary metadata.");
             if (res != FTI_SCES) {
+                free(jobs);
                 return FTI_NSCS;
             }
         }
         char str[FTI_BUFS];
         snprintf(str, FTI_BUFS, "Post-processing for proc %d started.", proc);
         FTI_Print(str, FTI_DBUG);
-        char lfn[FTI_BUFS], gfn[FTI_BUFS];
+        FTIT_transfer* job = &jobs[proc - startProc];
         if ( FTI_Ckpt[4].isDcp ) {
-            snprintf(gfn, FTI_BUFS, "%s/%s", FTI_Ckpt[4].dcpDir,
+            snprintf(job->dst, FTI_BUFS, "%s/%s", FTI_Ckpt[4].dcpDir,
              FTI_Exec->ckptMeta.ckptFile);
         } else {
-            snprintf(gfn, FTI_BUFS, "%s/%s", FTI_Conf->gTmpDir,
+            snprintf(job->dst, FTI_BUFS, "%s/%s", FTI_Conf->gTmpDir,
              FTI_Exec->ckptMeta.ckptFile);
         }
         snprintf(str, FTI_BUFS, "Global temporary file name for proc %d: %s",
-         proc, gfn);
+         proc, job->dst);
         FTI_Print(str, FTI_DBUG);
-        FILE* gfd = fopen(gfn, "wb");
-
-        if (gfd == NULL) {
-            FTI_Print("L4 cannot open ckpt. file in the PFS.", FTI_EROR);
-            return FTI_NSCS;
-        }
 
         if (level == 0) {
             if ( FTI_Ckpt[4].isDcp ) {
-                snprintf(lfn, FTI_BUFS, "%s/%s", FTI_Ckpt[1].dcpDir,
+                snprintf(job->src, FTI_BUFS, "%s/%s", FTI_Ckpt[1].dcpDir,
                  FTI_Exec->ckptMeta.ckptFile);
             } else {
-                snprintf(lfn, FTI_BUFS, "%s/%s", FTI_Conf->lTmpDir,
+                snprintf(job->src, FTI_BUFS, "%s/%s", FTI_Conf->lTmpDir,
                  FTI_Exec->ckptMeta.ckptFile);
             }
         } else {
-            snprintf(lfn, FTI_BUFS, "%s/%s", FTI_Ckpt[level].dir,
+            snprintf(job->src, FTI_BUFS, "%s/%s", FTI_Ckpt[level].dir,
              FTI_Exec->ckptMeta.ckptFile);
         }
-        snprintf(str, FTI_BUFS, "Local file name for proc %d: %s", proc, lfn);
+        snprintf(str, FTI_BUFS, "Local file name for proc %d: %s", proc,
+         job->src);
         FTI_Print(str, FTI_DBUG);
-        // Open local file
-        FILE* lfd = fopen(lfn, "rb");
-        if (lfd == NULL) {
-            FTI_Print("L4 cannot open the checkpoint file.", FTI_EROR);
-            fclose(gfd);
-            return FTI_NSCS;
-        }
 
-        char *readData = talloc(char, FTI_Conf->transferSize);
-        int32_t bSize = FTI_Conf->transferSize;
-        int32_t fs = FTI_Exec->ckptMeta.fs;
-        snprintf(str, FTI_BUFS, "Local file size for proc %d: %d", proc, fs);
+        job->fs = FTI_Exec->ckptMeta.fs;
+        snprintf(str, FTI_BUFS, "Local file size for proc %d: %lu", proc,
+         job->fs);
         FTI_Print(str, FTI_DBUG);
-        int32_t pos = 0;
-        // Checkpoint files exchange
-        while (pos < fs) {
-            if ((fs - pos) < FTI_Conf->transferSize)
-                bSize = fs - pos;
+    }
 
-            size_t bytes;
-            FREAD(FTI_NSCS, bytes, readData, sizeof(char), bSize, lfd, "pf",
-             readData, gfd);
-            size_t wBytes = 0;
-            FWRITE(FTI_NSCS, wBytes, readData, sizeof(char), bytes, gfd, "pf",
-             readData, lfd);
-            pos = pos + bytes;
-        }
-        free(readData);
-        fclose(lfd);
-        fclose(gfd);
+    // Checkpoint files exchange, the files of the node are copied in parallel
+    int res = FTI_TransferFiles(FTI_Conf, jobs, endProc - startProc);
+    for (proc = startProc; proc < endProc; proc++) {
+        FTI_Exec->metrics.flushBytes += jobs[proc - startProc].fs;
+    }
+    free(jobs);
+    if (res != FTI_SCES) {
+        FTI_Print("L4 cannot copy the ckpt. files in to the PFS.", FTI_EROR);
+        return FTI_NSCS;
     }
     return FTI_SCES;
 }
@@ -913,9 +1343,9 @@ int FTI_FlushMPI(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
         char* readData = talloc(char, FTI_Conf->transferSize);
         int32_t bSize = FTI_Conf->transferSize;
-        int32_t fs = FTI_Exec->ckptMeta.fs;
+        int64_t fs = FTI_Exec->ckptMeta.fs;
 
-        int32_t pos = 0;
+        int64_t pos = 0;
         // Checkpoint files exchange
         while (pos < fs) {
             if ((fs - pos) < FTI_Conf->transferSize) {
@@ -934,6 +1364,7 @@ int FTI_FlushMPI(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         }
         free(readData);
         fclose(lfd);
+        FTI_Exec->metrics.flushBytes += fs;
     }
     free(localFileNames);
     free(allFileSizes);
@@ -970,7 +1401,7 @@ int FTI_FlushSionlib(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     }
     int nbProc = endProc - startProc;
 
-    int32_t* localFileSizes = talloc(int32_t, nbProc);
+    int64_t* localFileSizes = talloc(int64_t, nbProc);
     char* localFileNames = talloc(char, FTI_BUFS * nbProc);
     int* splitRanks = talloc(int, nbProc);  // rank of process in FTI_COMM_WORLD
     for (proc = startProc; proc < endProc; proc++) {
@@ -1077,9 +1508,9 @@ int FTI_FlushSionlib(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
         char *readData = talloc(char, FTI_Conf->transferSize);
         int32_t bSize = FTI_Conf->transferSize;
-        int32_t fs = FTI_Exec->ckptMeta.fs;
+        int64_t fs = FTI_Exec->ckptMeta.fs;
 
-        int32_t pos = 0;
+        int64_t pos = 0;
         // Checkpoint files exchange
         while (pos < fs) {
             if ((fs - pos) < FTI_Conf->transferSize)
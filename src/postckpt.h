@@ -8,12 +8,51 @@
 #ifndef FTI_SRC_POSTCKPT_H_
 #define FTI_SRC_POSTCKPT_H_
 
+/** Number of chunks of an L2 transfer, unless they are too large **/
+#define FTI_L2_CHUNKS 8
+
+/** Maximum size of the chunks of an L2 transfer **/
+#define FTI_L2_MAX_CHUNK (16 * 1024 * 1024)
+
+/** L3 code families ('Advanced:l3_code') **/
+#define FTI_L3_RS 0
+#define FTI_L3_CAUCHY 1
+
+/** L3 code as stored in the metadata, 0 for files of older versions **/
+#define FTI_L3_CODE(family, w) (((family) << 6) | (w))
+#define FTI_L3_FAMILY(code) ((code) >> 6)
+#define FTI_L3_WORD(code) ((code) & 0x3f)
+
+/** Packet size of the Cauchy code, a unit of w packets is encoded at once **/
+#define FTI_L3_PACKET 2048
+
+/** Arguments of the L3 encoding tasks **/
+typedef struct FTIT_rsencTask {
+    char*       stripe;         /**< Blocks of all the group members      */
+    char*       coding;         /**< Computed block                       */
+    int*        row;            /**< Matrix row of the computed block     */
+    int         groupSize;      /**< Number of blocks in the stripe       */
+    int         bs;             /**< Block size                           */
+    int         sliceSize;      /**< Bytes computed per task              */
+    int         w;              /**< Word size of the code                */
+    int**       schedule;       /**< XOR schedule of the Cauchy code      */
+    int         packetSize;     /**< Packet size of the Cauchy code       */
+} FTIT_rsencTask;
+
 int FTI_Local(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt);
 int FTI_Ptner(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
-        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt);
+        FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
+        FTIT_keymap* FTI_Data);
 int FTI_RSenc(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt);
+void FTI_RSencSlice(void* arg, int idx);
+int FTI_L3Code(FTIT_configuration* FTI_Conf);
+int64_t FTI_L3Alignment(FTIT_configuration* FTI_Conf);
+int* FTI_L3Matrix(int k, int code);
+int FTI_L3InitTask(FTIT_rsencTask* task, int code, int* row, int k, int bs,
+        int nbThreads);
+void FTI_L3FreeTask(FTIT_rsencTask* task);
 int FTI_Flush(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt, int level);
 int FTI_FlushPosix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
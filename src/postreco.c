@@ -38,6 +38,136 @@
 #include <time.h>
 
 #include "postreco.h"
+
+/** Arguments of the L3 decoding tasks **/
+typedef struct FTIT_decodeTask {
+    FTIT_rsencTask  target[2];      /**< Erased files of this member          */
+    int             nbSlices;       /**< Slices per erased file               */
+} FTIT_decodeTask;
+
+/** File of this member holding a block of the surviving stripe **/
+typedef struct FTIT_decodeSrc {
+    FILE*           fd;
+    int             slot;           /**< Position of the block in the stripe  */
+    int64_t         size;           /**< Bytes of the file that were encoded  */
+    int64_t         tail;           /**< FTI-FF file size, -1 if none         */
+} FTIT_decodeSrc;
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Decodes one slice of the erased files of this member.
+  @param      arg             The decoding task (FTIT_decodeTask).
+  @param      idx             Index of the slice.
+  @return     void.
+ **/
+/*-------------------------------------------------------------------------*/
+static void FTI_DecodeSlice(void* arg, int idx) {
+    FTIT_decodeTask* task = (FTIT_decodeTask*) arg;
+    FTI_RSencSlice(&task->target[idx / task->nbSlices],
+     idx % task->nbSlices);
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads a block of a surviving file as it was encoded.
+  @param      src             The surviving file.
+  @param      block           Buffer of the block.
+  @param      pos             Position of the block.
+  @param      bs              Block size.
+  @param      maxFs           Maximum file size in the group.
+  @return     integer         FTI_SCES if successful.
+
+  At encoding, the checkpoint files were padded with zeros to maxFs and,
+  with FTI-FF, the file size was stored at the end. The padding is added
+  here, so the surviving files are read but never modified.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_DecodeReadBlock(FTIT_decodeSrc* src, char* block,
+        int64_t pos, int bs, int64_t maxFs) {
+    bzero(block, bs);
+    if (pos < src->size) {
+        size_t bytes = (src->size - pos < bs) ? src->size - pos : bs;
+        if (fread(block, sizeof(char), bytes, src->fd) != bytes) {
+            return FTI_NSCS;
+        }
+    }
+    if (src->tail >= 0) {
+        off_t fs = (off_t) src->tail;
+        int64_t at = maxFs - sizeof(off_t);
+        int b;
+        for (b = 0; b < sizeof(off_t); b++) {
+            if (at + b >= pos && at + b < pos + bs) {
+                block[at + b - pos] = ((char*) &fs)[b];
+            }
+        }
+    }
+    return FTI_SCES;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief      Reads the surviving blocks and posts their exchange.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      srcs            Surviving files of this member.
+  @param      nbSrcs          Number of surviving files of this member.
+  @param      owner           Group rank holding each block of the stripe.
+  @param      needy           TRUE for the members with erased files.
+  @param      stripe          Stripe buffer receiving the blocks.
+  @param      pos             Position of the blocks.
+  @param      maxFs           Maximum file size in the group.
+  @param      reqs            Requests of the exchange.
+  @param      nbReqs          Number of requests posted.
+  @return     integer         FTI_SCES if successful.
+
+  The blocks are only sent to the members that have erased files. On a
+  read error, the exchange is still posted so that the others progress.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int FTI_DecodePostBlock(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_decodeSrc* srcs, int nbSrcs, int* owner, bool* needy,
+        char* stripe, int64_t pos, int64_t maxFs, MPI_Request* reqs,
+        int* nbReqs) {
+    int bs = FTI_Conf->blockSize;
+    int k = FTI_Topo->groupSize;
+    int me = FTI_Topo->groupRank;
+    int res = FTI_SCES;
+    int i, j;
+
+    *nbReqs = 0;
+    for (i = 0; i < nbSrcs; i++) {
+        if (FTI_DecodeReadBlock(&srcs[i], stripe + (size_t) srcs[i].slot * bs,
+         pos, bs, maxFs) != FTI_SCES) {
+            FTI_Print("R3 cannot read the surviving files.", FTI_EROR);
+            res = FTI_NSCS;
+        }
+    }
+    // messages between two members are matched in the order of the slots
+    if (needy[me]) {
+        for (j = 0; j < k; j++) {
+            if (owner[j] != me) {
+                MPI_Irecv(stripe + (size_t) j * bs, bs, MPI_CHAR, owner[j],
+                 FTI_Conf->generalTag, FTI_Exec->groupComm,
+                 &reqs[(*nbReqs)++]);
+            }
+        }
+    }
+    for (i = 0; i < nbSrcs; i++) {
+        for (j = 0; j < k; j++) {
+            if (needy[j] && j != me) {
+                MPI_Isend(stripe + (size_t) srcs[i].slot * bs, bs, MPI_CHAR,
+                 j, FTI_Conf->generalTag, FTI_Exec->groupComm,
+                 &reqs[(*nbReqs)++]);
+            }
+        }
+    }
+    return res;
+}
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief      It recovers a set of ckpt. files using RS decoding.
@@ -49,7 +179,13 @@
   @return     integer         FTI_SCES if successful.
 
   This function tries to recover the L3 ckpt. files missing using the
-  RS decoding.
+  RS decoding. The first groupSize surviving files form the stripe from
+  which every erased file is computed: an erased checkpoint file with
+  its row of the inverted matrix, an erased encoded file with the product
+  of its encoding row and the inverted matrix. Only the members with
+  erased files receive the blocks, and only they write. The blocks of
+  the next stripe are exchanged while the current one is decoded by
+  'l3_threads' threads.
 
  **/
 /*-------------------------------------------------------------------------*/
@@ -58,7 +194,7 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     int ckptId, rank;
     sscanf(FTI_Exec->ckptMeta.ckptFile, "Ckpt%d-Rank%d.%s", &ckptId, &rank,
      FTI_Conf->suffix);
-    char fn[FTI_BUFS], efn[FTI_BUFS];
+    char fn[FTI_BUFS], efn[FTI_BUFS], str[FTI_BUFS];
     snprintf(efn, FTI_BUFS, "%s/Ckpt%d-RSed%d.%s", FTI_Ckpt[3].dir, ckptId,
      rank, FTI_Conf->suffix);
     snprintf(fn, FTI_BUFS, "%s/%s", FTI_Ckpt[3].dir,
@@ -66,35 +202,34 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 
     int bs = FTI_Conf->blockSize;
     int k = FTI_Topo->groupSize;
-    int m = k;
-
-    int32_t fs = FTI_Exec->ckptMeta.fs;
-
-    char** data = talloc(char*, k);
-    char** coding = talloc(char*, m);
-    char* dataTmp = talloc(char, FTI_Conf->blockSize* k);
+    int me = FTI_Topo->groupRank;
+    // the files of older versions were encoded with the default code
+    int code = (FTI_Exec->ckptMeta.l3Code > 0) ? FTI_Exec->ckptMeta.l3Code :
+     FTI_L3_CODE(FTI_L3_RS, FTI_WORD);
+    int w = FTI_L3_WORD(code);
+    int64_t fs = FTI_Exec->ckptMeta.fs;
+    int64_t maxFs = FTI_Exec->ckptMeta.maxFs;
+    int64_t nbBlocks = (maxFs + bs - 1) / bs;
+
+    int* matrix = FTI_L3Matrix(k, code);
+    int* tmpmat = talloc(int, k * k);
+    int* decMatrix = talloc(int, k * k);
     int* dm_ids = talloc(int, k);
-    int* decMatrix = talloc(int, k* k);
-    int* tmpmat = talloc(int, k* k);
-    int* matrix = talloc(int, k* k);
-    int i, j;
-    for (i = 0; i < FTI_Topo->groupSize; i++) {
-        for (j = 0; j < FTI_Topo->groupSize; j++) {
-            matrix[i * FTI_Topo->groupSize + j] = galois_single_divide(1,
-             i ^ (FTI_Topo->groupSize + j), FTI_Conf->l3WordSize);
-        }
-    }
-    for (i = 0; i < m; i++) {
-        coding[i] = talloc(char, FTI_Conf->blockSize);
-        data[i] = talloc(char, FTI_Conf->blockSize);
-    }
+    int* owner = talloc(int, k);
+    int* rows = talloc(int, 2 * k);
+    bool* needy = talloc(bool, k);
+    int i, j, l;
     j = 0;
     for (i = 0; j < k; i++) {
         if (erased[i] == 0) {
             dm_ids[j] = i;
+            owner[j] = i % k;
             j++;
         }
     }
+    for (i = 0; i < k; i++) {
+        needy[i] = erased[i] || erased[i + k];
+    }
     // Building the matrix
     for (i = 0; i < k; i++) {
         if (dm_ids[i] < k) {
@@ -110,250 +245,192 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     }
 
     // Inversing the matrix
-    if (jerasure_invert_matrix(tmpmat, decMatrix, k,
-     FTI_Conf->l3WordSize) < 0) {
+    int res = FTI_SCES;
+    if (jerasure_invert_matrix(tmpmat, decMatrix, k, w) < 0) {
         FTI_Print("Error inversing matrix", FTI_DBUG);
-
-        for (i = 0; i < m; i++) {
-            free(coding[i]);
-            free(data[i]);
-        }
-        free(tmpmat);
-        free(dm_ids);
-        free(decMatrix);
-        free(matrix);
-        free(data);
-        free(dataTmp);
-        free(coding);
-
-        return FTI_NSCS;
+        res = FTI_NSCS;
     }
 
-    FILE *fd, *efd;
-    int32_t maxFs = FTI_Exec->ckptMeta.maxFs;
-    int32_t ps = ((maxFs / FTI_Conf->blockSize)) * FTI_Conf->blockSize;
-    if (ps < maxFs) {
-        ps = ps + FTI_Conf->blockSize;  // Calculating padding size
+    // Rows giving the erased files of this member from the stripe
+    FTIT_decodeTask task;
+    int nbTargets = 0;
+    if (res == FTI_SCES && erased[me]) {
+        memcpy(rows, decMatrix + me * k, k * sizeof(int));
+        task.target[nbTargets++].row = rows;
     }
-    if (erased[FTI_Topo->groupRank] == 0) {  // Resize and open files
-        // determine file size in order to write at the end of the
-        // elongated and padded file (i.e. write at the end of file
-        // after 'truncate(.., maxFs)'
-        struct stat st_;
-        if (FTI_Conf->ioMode == FTI_IO_FTIFF) {
-            stat(fn, &st_);
-        }
-
-        if (truncate(fn, maxFs) == -1) {
-            FTI_Print("Error with truncate on checkpoint file", FTI_DBUG);
-
-            for (i = 0; i < m; i++) {
-                free(coding[i]);
-                free(data[i]);
+    if (res == FTI_SCES && erased[me + k]) {
+        for (j = 0; j < k; j++) {
+            int val = 0;
+            for (l = 0; l < k; l++) {
+                val ^= galois_single_multiply(matrix[me * k + l],
+                 decMatrix[l * k + j], w);
             }
-
-            free(tmpmat);
-            free(dm_ids);
-            free(decMatrix);
-            free(matrix);
-            free(data);
-            free(dataTmp);
-            free(coding);
-
-            return FTI_NSCS;
+            rows[k + j] = val;
         }
+        task.target[nbTargets++].row = rows + k;
+    }
 
-        // after truncation we need to write the filesize into the file
-        // in order to have the same file as at the state we performed
-        // the encoding. In order to do so, we need to determine the
-        // file size with stat, before the truncation!
-        if (FTI_Conf->ioMode == FTI_IO_FTIFF) {
-            int lftmp_ = open(fn, O_RDWR);
-            if (lftmp_ == -1) {
-                FTI_Print("FTI_RSenc: (FTIFF) Unable to open file!", FTI_EROR);
-                return FTI_NSCS;
-            }
-            if (lseek(lftmp_, -sizeof(off_t), SEEK_END) == -1) {
-                FTI_Print("FTI_RSenc: (FTIFF) Unable to seek in file!",
-                 FTI_EROR);
-                return FTI_NSCS;
+    // Open the files, the surviving ones are only read
+    FTIT_decodeSrc srcs[2];
+    int nbSrcs = 0;
+    FILE *fd = NULL, *efd = NULL;
+    for (j = 0; j < k && res == FTI_SCES; j++) {
+        if (dm_ids[j] != me && dm_ids[j] != me + k) {
+            continue;
+        }
+        bool isData = (dm_ids[j] == me);
+        FTIT_decodeSrc* src = &srcs[nbSrcs++];
+        src->slot = j;
+        src->tail = -1;
+        src->size = maxFs;
+        src->fd = fopen(isData ? fn : efn, "rb");
+        if (src->fd == NULL) {
+            nbSrcs--;
+            res = FTI_NSCS;
+            break;
+        }
+        if (isData) {
+            struct stat st_;
+            if (fstat(fileno(src->fd), &st_) == 0 && st_.st_size < maxFs) {
+                src->size = st_.st_size;
             }
-            if (write(lftmp_, &st_.st_size, sizeof(off_t)) == -1) {
-                FTI_Print("FTI_RSenc: (FTIFF) Unable to write meta data"
-                " in file!", FTI_EROR);
-                return FTI_NSCS;
+            // the size was stored at the end of the padded file
+            if (FTI_Conf->ioMode == FTI_IO_FTIFF) {
+                src->tail = st_.st_size;
             }
-            close(lftmp_);
         }
-        fd = fopen(fn, "rb");
-    } else {
+    }
+    if (res == FTI_SCES && erased[me]) {
         fd = fopen(fn, "wb");
+        res = (fd == NULL) ? FTI_NSCS : res;
     }
-
-    if (erased[FTI_Topo->groupRank + FTI_Topo->groupSize] == 0) {
-        efd = fopen(efn, "rb");
-    } else {
+    if (res == FTI_SCES && erased[me + k]) {
         efd = fopen(efn, "wb");
+        res = (efd == NULL) ? FTI_NSCS : res;
     }
-    if (fd == NULL) {
-        FTI_Print("R3 cannot open checkpoint file.", FTI_DBUG);
-
-        if (efd) {
-            fclose(efd);
-        }
-        for (i = 0; i < m; i++) {
-            free(coding[i]);
-            free(data[i]);
-        }
-        free(tmpmat);
-        free(dm_ids);
-        free(decMatrix);
-        free(matrix);
-        free(data);
-        free(dataTmp);
-        free(coding);
-
-        return FTI_NSCS;
+    // all the members take part in the exchanges
+    int allRes;
+    MPI_Allreduce(&res, &allRes, 1, MPI_INT, MPI_SUM, FTI_Exec->groupComm);
+    if (allRes != FTI_SCES) {
+        FTI_Print("R3 cannot open the checkpoint files.", FTI_DBUG);
+        res = FTI_NSCS;
+        nbBlocks = 0;
     }
 
-    if (efd == NULL) {
-        FTI_Print("R3 cannot open encoded ckpt. file.", FTI_DBUG);
-
-        fclose(fd);
-
-        for (i = 0; i < m; i++) {
-            free(coding[i]);
-            free(data[i]);
-        }
-        free(tmpmat);
-        free(dm_ids);
-        free(decMatrix);
-        free(matrix);
-        free(data);
-        free(dataTmp);
-        free(coding);
-
-        return FTI_NSCS;
+    // the fields are lazily initialized, do it before starting threads
+    galois_init_default_field(w);
+    galois_init_default_field(32);
+
+    char* stripe[2];
+    stripe[0] = talloc(char, (size_t) k * bs);
+    stripe[1] = talloc(char, (size_t) k * bs);
+    char* decoded[2];
+    decoded[0] = talloc(char, bs);
+    decoded[1] = talloc(char, bs);
+    MPI_Request* reqs = talloc(MPI_Request, 3 * k);
+    int nbReqs;
+
+    FTIT_threadpool pool;
+    FTI_ThreadPoolInit(&pool, (nbTargets > 0) ? FTI_Conf->l3Threads : 1);
+
+    task.nbSlices = 0;
+    for (i = 0; i < nbTargets; i++) {
+        task.nbSlices = FTI_L3InitTask(&task.target[i], code,
+         task.target[i].row, k, bs, pool.nbWorkers + 1);
+        task.target[i].coding = decoded[i];
     }
 
-    // Main loop, block by block
-    int32_t pos = 0;
-    int remBsize = bs;
-
     MD5_CTX md5ctxRS;
     MD5_Init(&md5ctxRS);
-    while (pos < ps) {
-        if ((maxFs - pos) < bs) {
-            remBsize = maxFs - pos;
-        }
-
-        // Reading the data
-        if (erased[FTI_Topo->groupRank] == 0) {
-            bzero(data[FTI_Topo->groupRank], bs);
-            fread(data[FTI_Topo->groupRank] + 0, sizeof(char), remBsize, fd);
-
-            if (ferror(fd)) {
-                FTI_Print("R3 cannot from the ckpt. file.", FTI_DBUG);
-
-                fclose(fd);
-                fclose(efd);
-
-                for (i = 0; i < m; i++) {
-                    free(coding[i]);
-                    free(data[i]);
-                }
-                free(tmpmat);
-                free(dm_ids);
-                free(decMatrix);
-                free(matrix);
-                free(data);
-                free(dataTmp);
-                free(coding);
-
-                return FTI_NSCS;
-            }
+    int64_t blk;
+    if (nbBlocks > 0) {
+        if (FTI_DecodePostBlock(FTI_Conf, FTI_Exec, FTI_Topo, srcs, nbSrcs,
+         owner, needy, stripe[0], 0, maxFs, reqs, &nbReqs) != FTI_SCES) {
+            res = FTI_NSCS;
         }
+        MPI_Waitall(nbReqs, reqs, MPI_STATUSES_IGNORE);
+    }
+    for (blk = 0; blk < nbBlocks; blk++) {
+        int64_t pos = blk * bs;
+        int remBsize = ((maxFs - pos) < bs) ? (maxFs - pos) : bs;
 
-        if (erased[FTI_Topo->groupRank + FTI_Topo->groupSize] == 0) {
-            bzero(coding[FTI_Topo->groupRank], bs);
-            fread(coding[FTI_Topo->groupRank] + 0, sizeof(char), remBsize, efd);
-
-            if (ferror(efd)) {
-                FTI_Print("R3 cannot from the encoded ckpt. file.", FTI_DBUG);
-
-                fclose(fd);
-                fclose(efd);
-
-                for (i = 0; i < m; i++) {
-                    free(coding[i]);
-                    free(data[i]);
-                }
-                free(tmpmat);
-                free(dm_ids);
-                free(decMatrix);
-                free(matrix);
-                free(data);
-                free(dataTmp);
-                free(coding);
-
-                return FTI_NSCS;
-            }
+        for (i = 0; i < nbTargets; i++) {
+            task.target[i].stripe = stripe[blk % 2];
         }
-
-        MPI_Allgather(data[FTI_Topo->groupRank] + 0, bs, MPI_CHAR, dataTmp, bs,
-         MPI_CHAR, FTI_Exec->groupComm);
-        for (i = 0; i < k; i++) {
-            memcpy(data[i] + 0, &(dataTmp[i * bs]), sizeof(char) * bs);
+        if (nbTargets > 0) {
+            FTI_ThreadPoolSubmit(&pool, nbTargets * task.nbSlices,
+             FTI_DecodeSlice, &task);
         }
 
-        MPI_Allgather(coding[FTI_Topo->groupRank] + 0, bs, MPI_CHAR, dataTmp,
-         bs, MPI_CHAR, FTI_Exec->groupComm);
-        for (i = 0; i < k; i++) {
-            memcpy(coding[i] + 0, &(dataTmp[i * bs]), sizeof(char) * bs);
+        // Exchange the next stripe while the current one is decoded
+        if (blk + 1 < nbBlocks) {
+            if (FTI_DecodePostBlock(FTI_Conf, FTI_Exec, FTI_Topo, srcs,
+             nbSrcs, owner, needy, stripe[(blk + 1) % 2], pos + bs, maxFs,
+             reqs, &nbReqs) != FTI_SCES) {
+                res = FTI_NSCS;
+            }
+            MPI_Waitall(nbReqs, reqs, MPI_STATUSES_IGNORE);
         }
 
-        // Decoding the lost data work
-        if (erased[FTI_Topo->groupRank]) {
-            jerasure_matrix_dotprod(k, FTI_Conf->l3WordSize,
-             decMatrix + (FTI_Topo->groupRank * k), dm_ids,
-             FTI_Topo->groupRank, data, coding, bs);
+        if (nbTargets > 0) {
+            FTI_ThreadPoolWait(&pool);
         }
-
-        MPI_Allgather(data[FTI_Topo->groupRank] + 0, bs, MPI_CHAR,
-         dataTmp, bs, MPI_CHAR, FTI_Exec->groupComm);
-        for (i = 0; i < k; i++) {
-            memcpy(data[i] + 0, &(dataTmp[i * bs]), sizeof(char) * bs);
+        if (res != FTI_SCES) {
+            continue;
         }
 
-        // Finally, re-encode any erased encoded checkpoint file
-        if (erased[FTI_Topo->groupRank + k]) {
-            jerasure_matrix_dotprod(k, FTI_Conf->l3WordSize,
-             matrix + (FTI_Topo->groupRank * k), NULL, FTI_Topo->groupRank + k,
-              data, coding, bs);
+        // Writing the erased files
+        i = 0;
+        if (erased[me] && fwrite(decoded[i++], sizeof(char), remBsize, fd) !=
+         remBsize) {
+            res = FTI_NSCS;
         }
-        if (erased[FTI_Topo->groupRank]) {
-            fwrite(data[FTI_Topo->groupRank] + 0, sizeof(char), remBsize, fd);
+        if (erased[me + k]) {
+            MD5_Update(&md5ctxRS, decoded[i], remBsize);
+            if (fwrite(decoded[i], sizeof(char), remBsize, efd) != remBsize) {
+                res = FTI_NSCS;
+            }
         }
-        if (erased[FTI_Topo->groupRank + k]) {
-            MD5_Update(&md5ctxRS, coding[FTI_Topo->groupRank], remBsize);
-            fwrite(coding[FTI_Topo->groupRank] + 0, sizeof(char),
-             remBsize, efd);
+        if (res != FTI_SCES) {
+            FTI_Print("R3 cannot write the recovered files.", FTI_EROR);
         }
-
-        pos = pos + bs;
     }
     unsigned char hashRS[MD5_DIGEST_LENGTH];
     MD5_Final(hashRS, &md5ctxRS);
 
+    FTI_ThreadPoolFinalize(&pool);
+    for (i = 0; i < nbTargets; i++) {
+        FTI_L3FreeTask(&task.target[i]);
+    }
+    free(reqs);
+    free(decoded[1]);
+    free(decoded[0]);
+    free(stripe[1]);
+    free(stripe[0]);
+    free(needy);
+    free(rows);
+    free(owner);
+    free(dm_ids);
+    free(decMatrix);
+    free(tmpmat);
+    free(matrix);
 
     // Closing files
-    fclose(fd);
-    fclose(efd);
+    for (i = 0; i < nbSrcs; i++) {
+        fclose(srcs[i].fd);
+    }
+    if (fd != NULL && fclose(fd) != 0) {
+        res = FTI_NSCS;
+    }
+    if (efd != NULL && fclose(efd) != 0) {
+        res = FTI_NSCS;
+    }
+    if (res != FTI_SCES) {
+        return FTI_NSCS;
+    }
 
     // FTI-FF: if file ckpt file deleted, determine fs from recovered file
-    if (FTI_Conf->ioMode == FTI_IO_FTIFF && erased[FTI_Topo->groupRank]) {
-        char str[FTI_BUFS];
-
+    if (FTI_Conf->ioMode == FTI_IO_FTIFF && erased[me]) {
         int ifd = open(fn, O_RDONLY);
         if (ifd == -1) {
             snprintf(str, FTI_BUFS,
@@ -382,15 +459,14 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
             return FTI_NSCS;
         }
 
-        fs = (int32_t) fs_;
+        fs = (int64_t) fs_;
         FTI_Exec->ckptMeta.fs = fs;
 
         close(ifd);
     }
 
     // FTI-FF: if encoded file deleted, append meta data to encoded file
-    if (FTI_Conf->ioMode == FTI_IO_FTIFF && erased[FTI_Topo->groupRank + k]) {
-        char str[FTI_BUFS];
+    if (FTI_Conf->ioMode == FTI_IO_FTIFF && erased[me + k]) {
         FTIFF_metaInfo *FTIFFMeta = malloc(sizeof(FTIFF_metaInfo));
 
         // get timestamp
@@ -402,6 +478,8 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIFFMeta->ptFs = -1;
         FTIFFMeta->maxFs = maxFs;
         FTIFFMeta->ckptSize = fs;
+        FTIFFMeta->version = FTIFF_VERSION;
+        FTIFFMeta->l3Code = code;
 
         char checksum[MD5_DIGEST_STRING_LENGTH];
         int ii = 0;
@@ -442,36 +520,12 @@ int FTI_Decode(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         free(buffer_ser);
     }
 
-    if (truncate(fn, fs) == -1) {
+    // the recovered file was written with the padding of the encoding
+    if (erased[me] && truncate(fn, fs) == -1) {
         FTI_Print("R3 cannot re-truncate checkpoint file.", FTI_WARN);
-
-        for (i = 0; i < m; i++) {
-            free(coding[i]);
-            free(data[i]);
-        }
-        free(tmpmat);
-        free(dm_ids);
-        free(decMatrix);
-        free(matrix);
-        free(data);
-        free(dataTmp);
-        free(coding);
-
         return FTI_NSCS;
     }
 
-    for (i = 0; i < m; i++) {
-        free(coding[i]);
-        free(data[i]);
-    }
-    free(tmpmat);
-    free(dm_ids);
-    free(decMatrix);
-    free(matrix);
-    free(data);
-    free(dataTmp);
-    free(coding);
-
     return FTI_SCES;
 }
 
@@ -536,7 +590,7 @@ int FTI_RecoverL1(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 /*-------------------------------------------------------------------------*/
 int FTI_SendCkptFileL2(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_checkpoint* FTI_Ckpt, int destination, int ptner) {
-    int32_t toSend;  // remaining data to send
+    int64_t toSend;  // remaining data to send
     char filename[FTI_BUFS], str[FTI_BUFS];
     if (ptner) {  // if want to send Ptner file
         int ckptId, rank;
@@ -600,7 +654,7 @@ int FTI_SendCkptFileL2(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
 /*-------------------------------------------------------------------------*/
 int FTI_RecvCkptFileL2(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_checkpoint* FTI_Ckpt, int source, int ptner) {
-    int32_t toRecv;  // remaining data to receive
+    int64_t toRecv;  // remaining data to receive
     char filename[FTI_BUFS], str[FTI_BUFS];
     if (ptner) {  // if want to receive Ptner file
         int ckptId, rank;
@@ -908,6 +962,7 @@ int FTI_RecoverL4(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         case FTI_IO_FTIFF:
         case FTI_IO_HDF5:
         case FTI_IO_IME:
+        case FTI_IO_IOURING:
         case FTI_IO_POSIX:
             return FTI_RecoverL4Posix(FTI_Conf, FTI_Exec, FTI_Topo, FTI_Ckpt);
         case FTI_IO_MPI:
@@ -1000,65 +1055,18 @@ int FTI_RecoverL4Posix(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
          FTI_Exec->ckptMeta.ckptFile);
     }
 
-    FILE* gfd = fopen(gfn, "rb");
-    if (gfd == NULL) {
-        FTI_Print("R4 cannot open the ckpt. file in the PFS.", FTI_WARN);
-        return FTI_NSCS;
-    }
-
     MKDIR(FTI_Conf->lTmpDir, 0777);
-    FILE* lfd = fopen(lfn, "wb");
-    if (lfd == NULL) {
-        FTI_Print("R4 cannot open the local ckpt. file.", FTI_WARN);
-        fclose(gfd);
-        return FTI_NSCS;
-    }
-
-    char *readData = talloc(char, FTI_Conf->transferSize);
-    int32_t bSize = FTI_Conf->transferSize;
-    int32_t fs = FTI_Exec->ckptMeta.fs;
 
     // Checkpoint files transfer from PFS
-    int32_t pos = 0;
-    while (pos < fs) {
-        if ((fs - pos) < FTI_Conf->transferSize) {
-            bSize = fs - pos;
-        }
-
-        size_t bytes = fread(readData, sizeof(char), bSize, gfd);
-
-        if (ferror(gfd)) {
-            FTI_Print("R4 cannot read from the ckpt. file in the PFS.",
-             FTI_DBUG);
-
-            free(readData);
-
-            fclose(gfd);
-            fclose(lfd);
-
-            return  FTI_NSCS;
-        }
-
-        fwrite(readData, sizeof(char), bytes, lfd);
-        if (ferror(lfd)) {
-            FTI_Print("R4 cannot write to the local ckpt. file.", FTI_DBUG);
-
-            free(readData);
-
-            fclose(gfd);
-            fclose(lfd);
-
-            return  FTI_NSCS;
-        }
-
-        pos = pos + bytes;
+    FTIT_transfer job;
+    strncpy(job.src, gfn, FTI_BUFS);
+    strncpy(job.dst, lfn, FTI_BUFS);
+    job.fs = FTI_Exec->ckptMeta.fs;
+    if (FTI_TransferFile(FTI_Conf, &job) != FTI_SCES) {
+        FTI_Print("R4 cannot copy the ckpt. file from the PFS.", FTI_WARN);
+        return FTI_NSCS;
     }
 
-    free(readData);
-
-    fclose(gfd);
-    fclose(lfd);
-
     return FTI_SCES;
 }
 
@@ -1122,10 +1130,10 @@ int FTI_RecoverL4Mpi(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
     }
 
     // collect chunksizes of other ranks
-    int32_t* chunkSizes = talloc(int32_t,
+    int64_t* chunkSizes = talloc(int64_t,
      FTI_Topo->nbApprocs*FTI_Topo->nbNodes);
-    MPI_Allgather(&FTI_Exec->ckptMeta.fs, 1, MPI_INT32_T, chunkSizes, 1,
-     MPI_INT32_T, FTI_COMM_WORLD);
+    MPI_Allgather(&FTI_Exec->ckptMeta.fs, 1, MPI_INT64_T, chunkSizes, 1,
+     MPI_INT64_T, FTI_COMM_WORLD);
 
     MPI_Offset offset = 0;
     // set file offset
@@ -1143,10 +1151,10 @@ int FTI_RecoverL4Mpi(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         return FTI_NSCS;
     }
 
-    int32_t fs = FTI_Exec->ckptMeta.fs;
+    int64_t fs = FTI_Exec->ckptMeta.fs;
     char *readData = talloc(char, FTI_Conf->transferSize);
     int32_t bSize = FTI_Conf->transferSize;
-    int32_t pos = 0;
+    int64_t pos = 0;
     // Checkpoint files transfer from PFS
     while (pos < fs) {
         if ((fs - pos) < FTI_Conf->transferSize) {
@@ -1307,10 +1315,10 @@ int FTI_RecoverL4Sionlib(FTIT_configuration* FTI_Conf,
 
     // Checkpoint files transfer from PFS
     while (!sion_feof(sid)) {
-        int32_t fs = FTI_Exec->ckptMeta.fs;
+        int64_t fs = FTI_Exec->ckptMeta.fs;
         char *readData = talloc(char, FTI_Conf->transferSize);
         int32_t bSize = FTI_Conf->transferSize;
-        int32_t pos = 0;
+        int64_t pos = 0;
         // Checkpoint files transfer from PFS
         while (pos < fs) {
             if ((fs - pos) < FTI_Conf->transferSize) {
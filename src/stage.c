@@ -108,6 +108,16 @@ static uint8_t *status;
  **/
 static MPI_Win stageWin;
 
+/** 
+ * @brief status field arrays of the ranks of the node.
+ *
+ * 'statusFields[source]' is the address of the status field array of
+ * 'source' in the shared memory window. It is queried once at
+ * initialization so that the head can update the status of a request
+ * from its staging thread without calling MPI.
+ **/
+static uint8_t **statusFields;
+
 /** 
  * @brief pointer to FTI_Conf->stagingEnabled (set in 'FTI_InitStage'). 
  **/
@@ -224,11 +234,20 @@ int FTI_InitStage(FTIT_execution *FTI_Exec, FTIT_configuration *FTI_Conf,
         memset(status, 0x0, win_size);
     }
 
+    statusFields = talloc(uint8_t*, FTI_Topo->nodeSize);
+    int i;
+    for (i = 0; i < FTI_Topo->nodeSize; i++) {
+        MPI_Aint qsize;
+        int qdisp;
+        MPI_Win_shared_query(stageWin, i, &qsize, &qdisp, &statusFields[i]);
+    }
+
     // create stage directory
     snprintf(FTI_Conf->stageDir, FTI_BUFS, "%s/stage", FTI_Conf->localDir);
     if (mkdir(FTI_Conf->stageDir, 0777) == -1) {
         if (errno != EEXIST) {
             FTI_DISABLE_STAGING;
+            free(statusFields);
             MPI_Win_free(&stageWin);
             MPI_Comm_free(&FTI_Exec->nodeComm);
             free(FTI_Exec->stageInfo);
@@ -292,6 +311,8 @@ void FTI_FinalizeStage(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
     // free idxRequest field array
     free(idxRequest);
 
+    free(statusFields);
+
     // free window
     // NOTE: this also releases the ressources for the status field array
     MPI_Win_free(&stageWin);
@@ -814,14 +835,49 @@ int FTI_AsyncStage(char *lpath, char *rpath, FTIT_configuration *FTI_Conf,
     return FTI_SCES;
 }
 
+/*-------------------------------------------------------------------------*/
+/**            
+  @brief      Receives a stage request from an application rank.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      integer         'source', application rank of stage request.
+  @param      job             Request received (out).
+  @return     'FTI_SCES' on success, 'FTI_NSCS' else.  
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_RecvStageRequest(FTIT_configuration* FTI_Conf,
+         FTIT_execution* FTI_Exec, int source, FTIT_StageJob* job) {
+    size_t buf_ser_size = 2*FTI_BUFS + sizeof(int);
+    void *buf_ser = malloc(buf_ser_size);
+    if (buf_ser == NULL) {
+        FTI_Print("failed to allocate memory for 'buf_ser' in"
+        " FTI_RecvStageRequest", FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    MPI_Recv(buf_ser, 1, buf_t, source, FTI_Conf->stageTag, FTI_Exec->nodeComm,
+     MPI_STATUS_IGNORE);
+
+    // set local file path
+    strncpy(job->lpath, buf_ser, FTI_BUFS);
+    strncpy(job->rpath, buf_ser+FTI_BUFS, FTI_BUFS);
+    job->lpath[FTI_BUFS-1] = '\0';
+    job->rpath[FTI_BUFS-1] = '\0';
+    job->ID = *(int*)(buf_ser+2*FTI_BUFS);
+    job->source = source;
+
+    free(buf_ser);
+
+    return FTI_SCES;
+}
+
 /*-------------------------------------------------------------------------*/
 /**            
   @brief      This function asynchronously stages the local file to the PFS.
-  @param      string          'lpath', absolute path of local file.
-  @param      string          'rpath', absolute path of remote file.
+  @param      FTI_Conf        Configuration metadata.
   @param      FTI_Exec        Execution metadata.
   @param      FTI_Topo        Topology metadata.
-  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Ckpt        Checkpoint metadata.
   @param      integer         'source', application rank of stage request.
   @return     'FTI_SCES' on success, 'FTI_NSCS' else.  
  **/
@@ -835,30 +891,35 @@ int FTI_HandleStageRequest(FTIT_configuration* FTI_Conf,
         return FTI_NSCS;
     }
 
-    char errstr[FTI_BUFS];
-
-    size_t buf_ser_size = 2*FTI_BUFS + sizeof(int);
-    void *buf_ser = malloc(buf_ser_size);
-    if (buf_ser == NULL) {
-        FTI_Print("failed to allocate memory for 'buf_ser' in"
-        " FTI_HandleStageRequest", FTI_EROR);
+    FTIT_StageJob job;
+    if (FTI_RecvStageRequest(FTI_Conf, FTI_Exec, source, &job) != FTI_SCES) {
         return FTI_NSCS;
     }
+    return FTI_ProcessStageRequest(FTI_Conf, FTI_Exec, FTI_Topo, &job);
+}
 
-    MPI_Recv(buf_ser, 1, buf_t, source, FTI_Conf->stageTag, FTI_Exec->nodeComm,
-     MPI_STATUS_IGNORE);
-
-    // set local file path
-    char lpath[FTI_BUFS];
-    char rpath[FTI_BUFS];
+/*-------------------------------------------------------------------------*/
+/**            
+  @brief      Copies the local file of a received stage request to the PFS.
+  @param      FTI_Conf        Configuration metadata.
+  @param      FTI_Exec        Execution metadata.
+  @param      FTI_Topo        Topology metadata.
+  @param      job             Request received by 'FTI_RecvStageRequest'.
+  @return     'FTI_SCES' on success, 'FTI_NSCS' else.  
 
-    strncpy(lpath, buf_ser, FTI_BUFS);
-    strncpy(rpath, buf_ser+FTI_BUFS, FTI_BUFS);
-    lpath[FTI_BUFS-1] = '\0';
-    rpath[FTI_BUFS-1] = '\0';
-    int ID = *(int*)(buf_ser+2*FTI_BUFS);
+  This function does not call MPI, the head may run it in its staging
+  thread while it serves the checkpoint requests.
+ **/
+/*-------------------------------------------------------------------------*/
+int FTI_ProcessStageRequest(FTIT_configuration* FTI_Conf,
+         FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+         FTIT_StageJob* job) {
+    char errstr[FTI_BUFS];
 
-    free(buf_ser);
+    char *lpath = job->lpath;
+    char *rpath = job->rpath;
+    int ID = job->ID;
+    int source = job->source;
 
     // init Head staging meta data
     if (FTI_InitStageRequestHead(lpath, rpath, FTI_Exec, FTI_Topo,
@@ -902,7 +963,7 @@ int FTI_HandleStageRequest(FTIT_configuration* FTI_Conf,
         FTI_SetStatusField(FTI_Exec, FTI_Topo, ID, FTI_SI_FAIL, FTI_SIF_VAL,
          source);
         FTI_Print("failed to allocate memory for 'dirc' "
-            "in 'FTI_HandleStageRequest'", FTI_EROR);
+            "in 'FTI_ProcessStageRequest'", FTI_EROR);
         return FTI_NSCS;
     }
     char *dir_name = dirname(dirc);
@@ -979,7 +1040,7 @@ int FTI_HandleStageRequest(FTIT_configuration* FTI_Conf,
         FTI_SetStatusField(FTI_Exec, FTI_Topo, ID, FTI_SI_FAIL, FTI_SIF_VAL,
          source);
         FTI_Print("failed to allocate memory for 'buf' in"
-        " 'FTI_HandleStageRequest'", FTI_EROR);
+        " 'FTI_ProcessStageRequest'", FTI_EROR);
         return FTI_NSCS;
     }
 
@@ -1165,10 +1226,8 @@ int FTI_GetStatusField(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
     const uint8_t val_mask = 0xE;
     const uint8_t avl_mask = 0x1;
 
-    int disp;
-    MPI_Aint size;
-    MPI_Win_shared_query(stageWin, source, &size, &disp, &(status));
-    uint8_t status_cpy = status[ID];
+    uint8_t *fields = statusFields[source];
+    uint8_t status_cpy = fields[ID];
 
     int query;
 
@@ -1214,10 +1273,8 @@ int FTI_SetStatusField(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
 
     int ierr = FTI_SCES;
 
-    int disp;
-    MPI_Aint size;
-    MPI_Win_shared_query(stageWin, source, &size, &disp, &(status));
-    uint8_t status_cpy = status[ID];
+    uint8_t *fields = statusFields[source];
+    uint8_t status_cpy = fields[ID];
 
     switch (val) {
         case FTI_SIF_VAL:
@@ -1241,7 +1298,7 @@ int FTI_SetStatusField(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
     }
 
     if (ierr == FTI_SCES) {
-        status[ID] = status_cpy;
+        fields[ID] = status_cpy;
     }
 
     return ierr;
@@ -1294,10 +1351,6 @@ void FTI_PrintStageStatus(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
         return;
     }
 
-    MPI_Aint qsize;
-    int qdisp;
-    MPI_Win_shared_query(stageWin, source, &qsize, &qdisp, &(status));
-
     int val;
 
     // get avl string
@@ -107,6 +107,15 @@ typedef struct FTIT_StageAppInfo {
     int ID;                         /**< ID of request                  */
 } FTIT_StageAppInfo;
 
+/** @typedef    FTIT_StageJob
+ *  @brief      Stage request received by the head.
+ */
+typedef struct FTIT_StageJob {
+    char lpath[FTI_BUFS];           /**< local file path                */
+    char rpath[FTI_BUFS];           /**< remote file path               */
+    int ID;                         /**< ID of request                  */
+    int source;                     /**< application rank in node comm. */
+} FTIT_StageJob;
 
 int FTI_GetRequestID(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo);
 int FTI_InitStage(FTIT_execution *FTI_Exec, FTIT_configuration *FTI_Conf,
@@ -122,6 +131,11 @@ int FTI_SyncStage(char* lpath, char *rpath, FTIT_execution *FTI_Exec,
 int FTI_HandleStageRequest(FTIT_configuration* FTI_Conf,
         FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
         FTIT_checkpoint* FTI_Ckpt, int source);
+int FTI_RecvStageRequest(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, int source, FTIT_StageJob* job);
+int FTI_ProcessStageRequest(FTIT_configuration* FTI_Conf,
+        FTIT_execution* FTI_Exec, FTIT_topology* FTI_Topo,
+        FTIT_StageJob* job);
 int FTI_GetStatusField(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
  int ID, FTIT_StatusField val, int source);
 int FTI_SetStatusField(FTIT_execution *FTI_Exec, FTIT_topology *FTI_Topo,
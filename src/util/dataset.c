@@ -47,6 +47,7 @@ int FTI_InitDataset(FTIT_execution* FTI_Exec, FTIT_dataset* data , int id) {
     dataNew.rank = 1;
     dataNew.h5group = FTI_Exec->H5groups[0];
     dataNew.id = id;
+    dataNew.attribute.codec = FTI_CODEC_DEFAULT;
     snprintf(dataNew.name, sizeof(dataNew.name), "Dataset_%d", id);
     memcpy(data, &dataNew, sizeof(FTIT_dataset));
     return FTI_SCES;
@@ -89,7 +89,7 @@ typedef struct FTIT_iniparser {
     char        file[FTI_BUFS]; /**< Path to corresponding file            */
     char*       (*getString)(struct FTIT_iniparser*, const char*);
     int         (*getInt)(struct FTIT_iniparser*, const char*);
-    int         (*getLong)(struct FTIT_iniparser*, const char*);
+    int64_t     (*getLong)(struct FTIT_iniparser*, const char*);
     int         (*set)(struct FTIT_iniparser*, const char*,
                                  const char*);
     int         (*dump)(struct FTIT_iniparser*);
@@ -172,7 +172,7 @@ int FTI_IniparserGetInt(FTIT_iniparser*, const char* key);
  
 
 --------------------------------------------------------------------------**/
-int FTI_IniparserGetLong(FTIT_iniparser*, const char* key);
+int64_t FTI_IniparserGetLong(FTIT_iniparser*, const char* key);
 
 /**--------------------------------------------------------------------------
   
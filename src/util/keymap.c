@@ -39,13 +39,84 @@
 
 #include "../interface.h"
 
+/** Number of slots of the key index at the first insertion */
+#define FTI_KEYMAP_MIN_SLOTS 64
+
+/*-------------------------------------------------------------------------*/
+/**
+    @brief      Returns the first slot probed for a key.
+    @param      self            The keymap instance.
+    @param      key             The key.
+    @return     integer         Index of the slot.
+
+    Fibonacci hashing, the number of slots is a power of two.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static inline int32_t FTI_KeyMapHash(FTIT_keymap* self, int key) {
+    return (int32_t)(((uint32_t)key * 2654435769u) &
+     (uint32_t)(self->_nbSlots - 1));
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+    @brief      Finds the slot of a key in the index.
+    @param      self            The keymap instance.
+    @param      key             The key.
+    @return     integer         Slot holding the key or the free slot
+                                where it would be inserted.
+
+    The index is never more than half full, the probing always ends on a
+    free slot.
+
+ **/
+/*-------------------------------------------------------------------------*/
+static int32_t FTI_KeyMapFind(FTIT_keymap* self, int key) {
+    int32_t mask = self->_nbSlots - 1;
+    int32_t i = FTI_KeyMapHash(self, key);
+    while (self->_slots[i].pos != -1 && self->_slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
 /*-------------------------------------------------------------------------*/
-/** 
-    @var static FTIT_keymap self  
-    Singleton instance of the key value container.
-**/
+/**
+    @brief      Resizes the key index.
+    @param      self            The keymap instance.
+    @param      nbSlots         The new number of slots, a power of two.
+    @return     integer         FTI_SCES if successful.
+
+    The entries of the previous index are inserted again.
+
+ **/
 /*-------------------------------------------------------------------------*/
-static FTIT_keymap self;
+static int FTI_KeyMapRehash(FTIT_keymap* self, int32_t nbSlots) {
+    FTIT_keymapSlot* old = self->_slots;
+    int32_t nbOld = self->_nbSlots;
+
+    FTIT_keymapSlot* slots = malloc(nbSlots * sizeof(FTIT_keymapSlot));
+    if (!slots) {
+        FTI_Print("Failed to extent keymap index", FTI_EROR);
+        return FTI_NSCS;
+    }
+    int32_t i;
+    for (i = 0; i < nbSlots; i++) {
+        slots[i].key = -1;
+        slots[i].pos = -1;
+    }
+
+    self->_slots = slots;
+    self->_nbSlots = nbSlots;
+    for (i = 0; i < nbOld; i++) {
+        if (old[i].pos != -1) {
+            self->_slots[FTI_KeyMapFind(self, old[i].key)] = old[i];
+        }
+    }
+    free(old);
+
+    return FTI_SCES;
+}
 
 int FTI_KeyMap(FTIT_keymap** instance, int32_t type_size, int32_t max_key,
      bool reset) {
@@ -54,34 +125,47 @@ int FTI_KeyMap(FTIT_keymap** instance, int32_t type_size, int32_t max_key,
         return FTI_NSCS;
     }
 
-    if (reset && self.initialized) {
-        self.clear();
+    FTIT_keymap* self = *instance;
+
+    if (self == NULL) {
+        self = calloc(1, sizeof(FTIT_keymap));
+        if (!self) {
+            FTI_Print("Failed to allocate keymap", FTI_EROR);
+            return FTI_NSCS;
+        }
+        if (pthread_rwlock_init(&self->_lock, NULL) != 0) {
+            FTI_Print("Failed to initialize keymap lock", FTI_EROR);
+            free(self);
+            return FTI_NSCS;
+        }
+        *instance = self;
     }
 
-    assert(self.initialized ==
-     false && "Only one instance of FTIT_keymap is allowed!");
-    *instance = &self;
+    if (reset && self->initialized) {
+        self->clear(self);
+    }
 
-    self._type_size = type_size;
-    self._max_key = max_key;
-    self._key = talloc(int, max_key+1);
+    if (self->initialized) {
+        FTI_Print("keymap instance is already initialized", FTI_EROR);
+        return FTI_NSCS;
+    }
 
-    int i=0; for (; i < max_key+1; i++)
-        self._key[i] = -1;
+    self->_type_size = type_size;
+    self->_max_key = max_key;
 
-    self.push_back = FTI_KeyMapPushBack;
-    self.data = FTI_KeyMapData;
-    self.get = FTI_KeyMapGet;
-    self.clear = FTI_KeyMapClear;
-    self.initialized = true;
+    self->push_back = FTI_KeyMapPushBack;
+    self->data = FTI_KeyMapData;
+    self->get = FTI_KeyMapGet;
+    self->clear = FTI_KeyMapClear;
+    self->initialized = true;
 
     return FTI_SCES;
 }
 
-int FTI_KeyMapPushBack(void* new_item, int key) {
+int FTI_KeyMapPushBack(FTIT_keymap* self, void* new_item, int key) {
     char str[FTI_BUFS];
 
-    if (!self.initialized) {
+    if (!self || !self->initialized) {
         FTI_Print("keymap not initialized", FTI_EROR);
         return FTI_NSCS;
     }
@@ -96,71 +180,97 @@ int FTI_KeyMapPushBack(void* new_item, int key) {
         return FTI_NSCS;
     }
 
-    if (key > self._max_key) {
+    if (key > self->_max_key) {
         snprintf(str, FTI_BUFS, "key is larger than 'max_key = %d' for keymap",
-         self._max_key);
+         self->_max_key);
         FTI_Print(str, FTI_EROR);
         return FTI_NSCS;
     }
 
-    if (self._key[key] != -1) {
+    pthread_rwlock_wrlock(&self->_lock);
+
+    // keep the index at most half full
+    if (2 * (self->_used + 1) > self->_nbSlots) {
+        int32_t nbSlots = (self->_nbSlots == 0) ?
+         FTI_KEYMAP_MIN_SLOTS : 2 * self->_nbSlots;
+        if (FTI_KeyMapRehash(self, nbSlots) != FTI_SCES) {
+            pthread_rwlock_unlock(&self->_lock);
+            return FTI_NSCS;
+        }
+    }
+
+    int32_t slot = FTI_KeyMapFind(self, key);
+
+    if (self->_slots[slot].pos != -1) {
+        pthread_rwlock_unlock(&self->_lock);
         snprintf(str, FTI_BUFS, "Requested key='%d' is already in use", key);
         FTI_Print(str, FTI_EROR);
         return FTI_NSCS;
     }
 
-    int32_t new_size = self._size;
-    int32_t new_used = self._used + 1;
+    int32_t new_size = self->_size;
+    int32_t new_used = self->_used + 1;
 
-    if (new_used > self._size) {
+    if (new_used > self->_size) {
         // double container size each time limit is reached except
         // new extra chunk would be larger than
-        // FTI_MAX_REALLOC * self._type_size
+        // FTI_MAX_REALLOC * self->_type_size
 
-        if (self._size == 0) {
+        if (self->_size == 0) {
             new_size = FTI_MIN_REALLOC;
         } else {
-            new_size = (self._size > FTI_MAX_REALLOC) ?
-             self._size + FTI_MAX_REALLOC : self._size * 2;
+            new_size = (self->_size > FTI_MAX_REALLOC) ?
+             self->_size + FTI_MAX_REALLOC : self->_size * 2;
         }
 
-        void* alloc = realloc(self._data, new_size * self._type_size);
+        void* alloc = realloc(self->_data,
+         (size_t)new_size * self->_type_size);
 
         if (!alloc) {
+            pthread_rwlock_unlock(&self->_lock);
             FTI_Print("Failed to extent keymap size", FTI_EROR);
             return FTI_NSCS;
         }
 
-        self._data = alloc;
+        self->_data = alloc;
     }
 
-    memcpy(self._data + self._used*self._type_size, new_item, self._type_size);
+    memcpy(self->_data + (size_t)self->_used*self->_type_size, new_item,
+     self->_type_size);
+
+    self->_slots[slot].key = key;
+    self->_slots[slot].pos = self->_used;
+    self->_used = new_used;
+    self->_size = new_size;
 
-    self._key[key] = self._used;
-    self._used = new_used;
-    self._size = new_size;
+    pthread_rwlock_unlock(&self->_lock);
 
     return FTI_SCES;
 }
 
-int FTI_KeyMapData(FTIT_dataset** data, int n) {
-    if (!self.initialized) {
+int FTI_KeyMapData(FTIT_keymap* self, FTIT_dataset** data, int n) {
+    if (!self || !self->initialized) {
         FTI_Print("keymap not initialized", FTI_EROR);
         return FTI_NSCS;
     }
 
-    if (n > self._used) {
+    pthread_rwlock_rdlock(&self->_lock);
+
+    if (n > self->_used) {
+        pthread_rwlock_unlock(&self->_lock);
         FTI_Print("keymap out of bounds", FTI_EROR);
         return FTI_NSCS;
     }
 
-    *data = self._data;
+    *data = self->_data;
+
+    pthread_rwlock_unlock(&self->_lock);
 
     return FTI_SCES;
 }
 
-int FTI_KeyMapGet(FTIT_dataset** data, int key) {
-    if (!self.initialized) {
+int FTI_KeyMapGet(FTIT_keymap* self, FTIT_dataset** data, int key) {
+    if (!self || !self->initialized) {
         FTI_Print("keymap not initialized", FTI_EROR);
         return FTI_NSCS;
     }
@@ -170,14 +280,24 @@ int FTI_KeyMapGet(FTIT_dataset** data, int key) {
         return FTI_NSCS;
     }
 
-    if (key > self._max_key) {
+    if (key > self->_max_key) {
         FTI_Print("key is larger than 'max_key' for keymap", FTI_EROR);
         return FTI_NSCS;
     }
 
-    int32_t check_pos = self._key[key];
+    pthread_rwlock_rdlock(&self->_lock);
 
-    if (check_pos > (self._used - 1)) {
+    if (self->_nbSlots == 0) {
+        // keymap is empty
+        pthread_rwlock_unlock(&self->_lock);
+        *data = NULL;
+        return FTI_SCES;
+    }
+
+    int32_t check_pos = self->_slots[FTI_KeyMapFind(self, key)].pos;
+
+    if (check_pos > (self->_used - 1)) {
+        pthread_rwlock_unlock(&self->_lock);
         FTI_Print("data location out of bounds", FTI_EROR);
         return FTI_NSCS;
     }
@@ -185,26 +305,55 @@ int FTI_KeyMapGet(FTIT_dataset** data, int key) {
     if (check_pos == -1) {
         // key not in use
         *data = NULL;
-        return FTI_SCES;
+    } else {
+        *data = self->_data + (size_t)check_pos * self->_type_size;
     }
 
-    *data = self._data + check_pos * self._type_size;
+    pthread_rwlock_unlock(&self->_lock);
 
     return FTI_SCES;
 }
 
-int FTI_KeyMapClear() {
-    if (!self.initialized) {
+int FTI_KeyMapClear(FTIT_keymap* self) {
+    if (!self || !self->initialized) {
         FTI_Print("keymap not initialized", FTI_EROR);
         return FTI_NSCS;
     }
 
-    free(self._data);
-    free(self._key);
+    pthread_rwlock_wrlock(&self->_lock);
 
-    FTIT_keymap reset = {0};
+    free(self->_data);
+    free(self->_slots);
+
+    self->initialized = false;
+    self->_type_size = 0;
+    self->_size = 0;
+    self->_used = 0;
+    self->_max_key = 0;
+    self->_data = NULL;
+    self->_slots = NULL;
+    self->_nbSlots = 0;
+
+    pthread_rwlock_unlock(&self->_lock);
+
+    return FTI_SCES;
+}
+
+int FTI_KeyMapFree(FTIT_keymap** instance) {
+    FTIT_keymap* self = *instance;
+
+    if (self == NULL) {
+        FTI_Print("keymap not allocated", FTI_EROR);
+        return FTI_NSCS;
+    }
+
+    if (self->initialized) {
+        self->clear(self);
+    }
 
-    self = reset;
+    pthread_rwlock_destroy(&self->_lock);
+    free(self);
+    *instance = NULL;
 
     return FTI_SCES;
 }
@@ -40,6 +40,8 @@
 #ifndef FTI_KEYMAP_H_
 #define FTI_KEYMAP_H_
 
+#include <pthread.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -51,6 +53,12 @@ extern "C" {
     (in number of elements) ~ 10 Mb for FTIT_dataset */
     static const size_t FTI_MAX_REALLOC = 10*1024;
 
+    /** Slot of the key index, 'pos' is -1 for a free slot */
+    typedef struct FTIT_keymapSlot {
+        int32_t key;          /**< Key of the element                        */
+        int32_t pos;          /**< Location of the element in keymap         */
+    } FTIT_keymapSlot;
+
     /**--------------------------------------------------------------------------
       
       
@@ -66,6 +74,10 @@ extern "C" {
       FTI_KeyMapGet -> get and  
       FTI_KeyMapClear -> clear.
 
+      The members take the instance as first argument. Keys are located through
+      an open addressing hash index, its size depends on the number of elements
+      and not on the value of the keys. A read-write lock protects the instance,
+      so that several threads may look up elements concurrently.
     
     --------------------------------------------------------------------------**/
     typedef struct FTIT_keymap {
@@ -75,27 +87,30 @@ extern "C" {
         int32_t    _used;        /**< Number of elements in keymap              */
         int     _max_key;     /**< Maximum value for key                     */
         void*   _data;        /**< Pointer to first element in keymap        */
-        int*    _key;         /**< Lookup table for key -> location in keymap*/
-        int     (*push_back)(void*, int);
-        int     (*data)(FTIT_dataset**, int);
-        int     (*get)(FTIT_dataset**, int);
-        int     (*clear)(void);
+        FTIT_keymapSlot* _slots; /**< Hash index key -> location in keymap   */
+        int32_t    _nbSlots;     /**< Number of slots, a power of two       */
+        pthread_rwlock_t _lock;  /**< Readers lock, writers are exclusive    */
+        int     (*push_back)(struct FTIT_keymap*, void*, int);
+        int     (*data)(struct FTIT_keymap*, FTIT_dataset**, int);
+        int     (*get)(struct FTIT_keymap*, FTIT_dataset**, int);
+        int     (*clear)(struct FTIT_keymap*);
     } FTIT_keymap;
 
     /**--------------------------------------------------------------------------
       
       
-      @brief        Initialize keymap singleton.
+      @brief        Initialize a keymap instance.
     
-      This function initialized the keymap. Only a single instance of keymap is 
-      allowed at a time. The function expects a pointer to an FTIT_keymap pointer, 
-      the size of one element of the keymap and the maximum value for the key. 
-      after the successful call, <code>*instance</code> points to the static
-      variable \ref self. The call to the function if the keymap was already 
-      initialized is erroneous and is protected by assert. 
-      
-      @param        instance[out]     <b> FTIT_keymap** </b>  Pointer to be set to
-      the static instance of the key value container.
+      This function initializes a keymap. The function expects a pointer to an
+      FTIT_keymap pointer, the size of one element of the keymap and the maximum
+      value for the key. If <code>*instance</code> is NULL, a new instance is
+      allocated. Otherwise <code>*instance</code> has to point to an instance
+      created by this function, it is reused and, if it still holds elements,
+      cleared when reset is true. Initializing an instance in use without reset
+      is erroneous.
+      
+      @param        instance[in,out]  <b> FTIT_keymap** </b>  Pointer set to
+      the instance of the key value container.
       @param        type_size[in]     <b> int32_t          </b>  Element size of container.
       @param        max_key[in]       <b> int32_t          </b>  Maximum value for Key.
       @param        reset[in]         <b> bool          </b>  if true reset key map.
@@ -119,7 +134,9 @@ extern "C" {
       The first allocation size (first insertion) is controled by variable 
       \ref FTI_MIN_REALLOC. The new item will be copied so that we are not in danger 
       for inconsistent pointer values when the passed pointer goes out of scope.
+      Pointers to elements obtained before the call may be invalidated.
       
+      @param        self[in]        <b> FTIT_keymap* </b>  Keymap instance.
       @param        new_item[in]    <b> void*   </b>  Pointer to new element.
       @param        key[in]         <b> int     </b>  Key of new element.
       @return                       \ref FTI_SCES if successful  
@@ -127,7 +144,7 @@ extern "C" {
      
     
     --------------------------------------------------------------------------**/
-    int     FTI_KeyMapPushBack(void*, int);
+    int     FTI_KeyMapPushBack(FTIT_keymap*, void*, int);
 
     /**--------------------------------------------------------------------------
       
@@ -137,6 +154,7 @@ extern "C" {
       This function requests a pointer to the first element of the keymap. The
       function checks if it contains at least n elements.
       
+      @param        self[in]    <b> FTIT_keymap*   </b>  Keymap instance.
       @param        data[out]   <b> FTIT_dataset** </b>  pointer to be set to the
       first element of keymap.
       @param        n[in]       <b> int            </b>  number of elements that
@@ -146,7 +164,7 @@ extern "C" {
      
     
     --------------------------------------------------------------------------**/
-    int     FTI_KeyMapData(FTIT_dataset**, int);
+    int     FTI_KeyMapData(FTIT_keymap*, FTIT_dataset**, int);
 
     /**--------------------------------------------------------------------------
       
@@ -157,6 +175,7 @@ extern "C" {
       The function. If no element with key was found, the passed pointer is set to NULL.
       This case is considered to be a successful call.
       
+      @param        self[in]    <b> FTIT_keymap*   </b>  Keymap instance.
       @param        data[out]   <b> FTIT_dataset** </b>  pointer to be set to the
       element with key in keymap.
       @param        key[in]     <b> int            </b>  key of requested element
@@ -165,23 +184,40 @@ extern "C" {
      
     
     --------------------------------------------------------------------------**/
-    int     FTI_KeyMapGet(FTIT_dataset**, int);
+    int     FTI_KeyMapGet(FTIT_keymap*, FTIT_dataset**, int);
 
     /**--------------------------------------------------------------------------
       
       
-      @brief        Resets the singleton instance of the keymap and frees buffers.
+      @brief        Resets a keymap instance and frees its buffers.
     
       This function frees all allocated memory in the keymap and resets all members
-      to the initial state. After the call to this function \ref FTI_KeyMap can be
-      called again safely to create a new singleton keamyp instance.
+      to the initial state. The instance itself is kept, after the call to this
+      function \ref FTI_KeyMap can be called again safely on it.
+      
+      @param        self[in]    <b> FTIT_keymap*   </b>  Keymap instance.
+      @return                       \ref FTI_SCES if successful  
+                                    \ref FTI_NSCS on failure
+     
+    
+    --------------------------------------------------------------------------**/
+    int     FTI_KeyMapClear(FTIT_keymap*);
+
+    /**--------------------------------------------------------------------------
+      
+      
+      @brief        Destroys a keymap instance.
+    
+      This function clears the keymap, releases the instance and sets
+      <code>*instance</code> to NULL.
       
+      @param        instance[in,out]  <b> FTIT_keymap** </b>  Instance.
       @return                       \ref FTI_SCES if successful  
                                     \ref FTI_NSCS on failure
      
     
     --------------------------------------------------------------------------**/
-    int     FTI_KeyMapClear(void);
+    int     FTI_KeyMapFree(FTIT_keymap**);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,229 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   metrics.c
+ *  @date   October, 2026
+ *  @brief  counters and latency histograms of the checkpoints.
+ *
+ *  Each process accounts for the checkpoints, post-processing, flushes and
+ *  recoveries it performs in FTI_Exec->metrics. The application processes
+ *  aggregate them on demand through FTI_GetMetrics, every process (heads
+ *  included) can also dump them periodically in an INI file read by a
+ *  local collector.
+ */
+
+#include <inttypes.h>
+
+#include "../interface.h"
+
+void FTI_MetricsLatency(FTIT_histogram* hist, double sec) {
+    int bin = 0;
+    double ms = sec * 1000;
+    while (ms >= 1 && bin < FTI_METRICS_BINS - 1) {
+        ms /= 2;
+        bin++;
+    }
+    hist->bins[bin]++;
+    hist->count++;
+    hist->sum += sec;
+    if (sec > hist->max) {
+        hist->max = sec;
+    }
+}
+
+void FTI_MetricsCkpt(FTIT_execution* FTI_Exec, int level, bool dcp,
+ double write, int res) {
+    FTIT_metrics* metrics = &FTI_Exec->metrics;
+    if (res != FTI_SCES || level < 1 || level > 4) {
+        metrics->failed++;
+        return;
+    }
+    metrics->ckpts[level]++;
+    FTI_MetricsLatency(&metrics->write, write);
+    // the bytes of a dCP are counted by FTI_MetricsDcp
+    if (!dcp) {
+        metrics->bytes[level] += FTI_Exec->ckptSize;
+    }
+}
+
+void FTI_MetricsDcp(FTIT_execution* FTI_Exec, uint64_t dataSize,
+ uint64_t dcpSize) {
+    FTIT_metrics* metrics = &FTI_Exec->metrics;
+    int level = FTI_Exec->ckptMeta.level;
+    if (level >= 1 && level <= 4) {
+        metrics->bytes[level] += dcpSize;
+    }
+    metrics->dcpCkpts++;
+    metrics->dcpBytes += dataSize;
+    metrics->dcpDirty += dcpSize;
+    metrics->dcpRatio = (dataSize > 0) ? (double) dcpSize / dataSize : 0;
+}
+
+/* Merges a latency histogram in another one. */
+static void FTI_MetricsMergeLatency(FTIT_histogram* in, FTIT_histogram* out) {
+    int i;
+    for (i = 0; i < FTI_METRICS_BINS; i++) {
+        out->bins[i] += in->bins[i];
+    }
+    out->count += in->count;
+    out->sum += in->sum;
+    out->max = (in->max > out->max) ? in->max : out->max;
+}
+
+/* MPI reduction operator of FTIT_metrics. */
+static void FTI_MetricsMerge(void* invec, void* inoutvec, int* len,
+ MPI_Datatype* type) {
+    FTIT_metrics* in = (FTIT_metrics*) invec;
+    FTIT_metrics* out = (FTIT_metrics*) inoutvec;
+    int i, level;
+    for (i = 0; i < *len; i++, in++, out++) {
+        out->nbProcs += in->nbProcs;
+        out->uptime = (in->uptime > out->uptime) ? in->uptime : out->uptime;
+        for (level = 1; level < 5; level++) {
+            out->ckpts[level] += in->ckpts[level];
+            out->bytes[level] += in->bytes[level];
+            FTI_MetricsMergeLatency(&in->post[level], &out->post[level]);
+        }
+        out->failed += in->failed;
+        out->dcpCkpts += in->dcpCkpts;
+        out->dcpBytes += in->dcpBytes;
+        out->dcpDirty += in->dcpDirty;
+        // averaged once all the processes are merged
+        out->dcpRatio += in->dcpRatio;
+        FTI_MetricsMergeLatency(&in->write, &out->write);
+        out->flushBytes += in->flushBytes;
+        out->flushTime += in->flushTime;
+        out->headQueue += in->headQueue;
+        out->headQueueMax = (in->headQueueMax > out->headQueueMax) ?
+         in->headQueueMax : out->headQueueMax;
+        FTI_MetricsMergeLatency(&in->recover, &out->recover);
+    }
+}
+
+int FTI_MetricsReduce(FTIT_metrics* local, FTIT_metrics* all, MPI_Comm comm) {
+    MPI_Datatype type;
+    MPI_Op op;
+    MPI_Type_contiguous(sizeof(FTIT_metrics), MPI_BYTE, &type);
+    MPI_Type_commit(&type);
+    MPI_Op_create(FTI_MetricsMerge, 1, &op);
+
+    FTIT_metrics metrics = *local;
+    metrics.nbProcs = 1;
+    int res = MPI_Allreduce(&metrics, all, 1, type, op, comm);
+    all->dcpRatio /= all->nbProcs;
+
+    MPI_Op_free(&op);
+    MPI_Type_free(&type);
+    if (res != MPI_SUCCESS) {
+        FTI_Print("Cannot aggregate the metrics.", FTI_WARN);
+        return FTI_NSCS;
+    }
+    return FTI_SCES;
+}
+
+/* Writes a latency histogram in the metrics file. */
+static void FTI_MetricsWriteLatency(FILE* fd, const char* name,
+ FTIT_histogram* hist) {
+    int i;
+    fprintf(fd, "\n[%s]\n", name);
+    fprintf(fd, "count = %" PRIu64 "\n", hist->count);
+    fprintf(fd, "sum = %.6f\n", hist->sum);
+    fprintf(fd, "mean = %.6f\n", (hist->count > 0) ?
+     hist->sum / hist->count : 0);
+    fprintf(fd, "max = %.6f\n", hist->max);
+    fprintf(fd, "bins =");
+    for (i = 0; i < FTI_METRICS_BINS; i++) {
+        fprintf(fd, " %" PRIu64, hist->bins[i]);
+    }
+    fprintf(fd, "\n");
+}
+
+int FTI_MetricsDump(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_topology* FTI_Topo, bool force) {
+    if (FTI_Conf->metricsDir[0] == '\0') {
+        return FTI_SCES;
+    }
+    double now = MPI_Wtime();
+    if (!force && now - FTI_Exec->metricsDump < FTI_Conf->metricsIntv) {
+        return FTI_SCES;
+    }
+    FTI_Exec->metricsDump = now;
+
+    char fn[FTI_BUFS], tmp[FTI_BUFS], str[FTI_BUFS];
+    snprintf(fn, FTI_BUFS, "%s/fti-metrics-%d.ini", FTI_Conf->metricsDir,
+     FTI_Topo->myRank);
+    snprintf(tmp, FTI_BUFS, "%s.tmp", fn);
+    FILE* fd = fopen(tmp, "w");
+    if (fd == NULL) {
+        snprintf(str, FTI_BUFS, "Cannot write the metrics file '%s'", tmp);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    FTIT_metrics* m = &FTI_Exec->metrics;
+    int level;
+    fprintf(fd, "[metrics]\n");
+    fprintf(fd, "rank = %d\n", FTI_Topo->myRank);
+    fprintf(fd, "node = %d\n", FTI_Topo->nodeID);
+    fprintf(fd, "head = %d\n", FTI_Topo->amIaHead);
+    fprintf(fd, "uptime = %.3f\n", now - FTI_Exec->metricsStart);
+    for (level = 1; level < 5; level++) {
+        fprintf(fd, "ckpts_l%d = %" PRIu64 "\n", level, m->ckpts[level]);
+        fprintf(fd, "bytes_l%d = %" PRIu64 "\n", level, m->bytes[level]);
+    }
+    fprintf(fd, "failed = %" PRIu64 "\n", m->failed);
+    fprintf(fd, "dcp_ckpts = %" PRIu64 "\n", m->dcpCkpts);
+    fprintf(fd, "dcp_bytes = %" PRIu64 "\n", m->dcpBytes);
+    fprintf(fd, "dcp_dirty = %" PRIu64 "\n", m->dcpDirty);
+    fprintf(fd, "dcp_ratio = %.4f\n", m->dcpRatio);
+    fprintf(fd, "flush_bytes = %" PRIu64 "\n", m->flushBytes);
+    fprintf(fd, "flush_time = %.6f\n", m->flushTime);
+    fprintf(fd, "flush_mbps = %.2f\n", (m->flushTime > 0) ?
+     m->flushBytes / (1024.0 * 1024.0) / m->flushTime : 0);
+    fprintf(fd, "head_queue = %d\n", m->headQueue);
+    fprintf(fd, "head_queue_max = %d\n", m->headQueueMax);
+    FTI_MetricsWriteLatency(fd, "write", &m->write);
+    for (level = 1; level < 5; level++) {
+        char name[16];
+        snprintf(name, sizeof(name), "post_l%d", level);
+        FTI_MetricsWriteLatency(fd, name, &m->post[level]);
+    }
+    FTI_MetricsWriteLatency(fd, "recover", &m->recover);
+
+    if (fclose(fd) != 0 || rename(tmp, fn) != 0) {
+        snprintf(str, FTI_BUFS, "Cannot write the metrics file '%s'", fn);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+    return FTI_SCES;
+}
@@ -0,0 +1,128 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   metrics.h
+ *  @date   October, 2026
+ *  @brief  counters and latency histograms of the checkpoints.
+ */
+
+#ifndef FTI_METRICS_H_
+#define FTI_METRICS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Adds a duration to a latency histogram.
+
+  @param        hist[out]   <b> FTIT_histogram* </b> Histogram to update.
+  @param        sec         <b> double </b> Duration in seconds.
+
+
+--------------------------------------------------------------------------**/
+void FTI_MetricsLatency(FTIT_histogram* hist, double sec);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Accounts the checkpoint just taken by an application process.
+
+  @param        FTI_Exec    <b> FTIT_execution* </b> Execution metadata.
+  @param        level       <b> int </b> Level of the checkpoint.
+  @param        dcp         <b> bool </b> TRUE for a dCP checkpoint.
+  @param        write       <b> double </b> Write duration (sec.).
+  @param        res         <b> int </b> Result of the checkpoint.
+
+
+--------------------------------------------------------------------------**/
+void FTI_MetricsCkpt(FTIT_execution* FTI_Exec, int level, bool dcp,
+ double write, int res);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Accounts the dCP checkpoint being taken by the process.
+
+  Must be called with the local sizes, before they are summed on the
+  application rank 0.
+
+  @param        FTI_Exec    <b> FTIT_execution* </b> Execution metadata.
+  @param        dataSize    <b> uint64_t </b> Bytes protected.
+  @param        dcpSize     <b> uint64_t </b> Bytes written by the dCP.
+
+
+--------------------------------------------------------------------------**/
+void FTI_MetricsDcp(FTIT_execution* FTI_Exec, uint64_t dataSize,
+ uint64_t dcpSize);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Aggregates the metrics of the processes of a communicator.
+
+  Collective on 'comm'. Counters, bytes and histograms are summed, the
+  longest durations and queue depths are the maxima.
+
+  @param        local[in]   <b> FTIT_metrics* </b> Metrics of the process.
+  @param        all[out]    <b> FTIT_metrics* </b> Aggregated metrics.
+  @param        comm        <b> MPI_Comm </b> Processes to aggregate.
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_MetricsReduce(FTIT_metrics* local, FTIT_metrics* all, MPI_Comm comm);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Writes the metrics file of the process if it is due.
+
+  The file '<metrics_dir>/fti-metrics-<rank>.ini' is replaced atomically,
+  at most every 'metrics_intv' seconds unless 'force' is set.
+
+  @param        FTI_Conf    <b> FTIT_configuration* </b> Configuration.
+  @param        FTI_Exec    <b> FTIT_execution* </b> Execution metadata.
+  @param        FTI_Topo    <b> FTIT_topology* </b> Topology.
+  @param        force       <b> bool </b> TRUE to write it in any case.
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_MetricsDump(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
+ FTIT_topology* FTI_Topo, bool force);
+
+#endif  // FTI_METRICS_H_
@@ -0,0 +1,155 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   threadpool.c
+ *  @date   October, 2026
+ *  @brief  methods for FTIT_threadpool, a fixed team of worker threads.
+ */
+
+#include "../interface.h"
+
+/* Executes tasks of the current batch until none is left (lock held). */
+static void FTI_ThreadPoolDrain(FTIT_threadpool* pool) {
+    while (pool->next < pool->nbTasks) {
+        int idx = pool->next++;
+        FTIT_task task = pool->task;
+        void* arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(arg, idx);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->finish);
+        }
+    }
+}
+
+static void* FTI_ThreadPoolWorker(void* arg) {
+    FTIT_threadpool* pool = (FTIT_threadpool*) arg;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stop) {
+        if (pool->next < pool->nbTasks) {
+            FTI_ThreadPoolDrain(pool);
+        } else {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+int FTI_ThreadPoolInit(FTIT_threadpool* pool, int nbThreads) {
+    if (pool == NULL) {
+        FTI_Print("thread pool context is NULL", FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    memset(pool, 0x0, sizeof(FTIT_threadpool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->finish, NULL);
+
+    if (nbThreads <= 1) return FTI_SCES;
+
+    pool->workers = talloc(pthread_t, nbThreads - 1);
+    int i;
+    for (i = 0; i < nbThreads - 1; i++) {
+        if (pthread_create(&pool->workers[i], NULL, FTI_ThreadPoolWorker,
+         pool) != 0) {
+            char str[FTI_BUFS];
+            snprintf(str, FTI_BUFS, "thread pool started %d out of %d"
+             " worker threads", i, nbThreads - 1);
+            FTI_Print(str, FTI_WARN);
+            break;
+        }
+        pool->nbWorkers++;
+    }
+
+    return FTI_SCES;
+}
+
+int FTI_ThreadPoolSubmit(FTIT_threadpool* pool, int nbTasks, FTIT_task task,
+ void* arg) {
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->nbTasks = nbTasks;
+    pool->next = 0;
+    pool->pending = nbTasks;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    return FTI_SCES;
+}
+
+int FTI_ThreadPoolWait(FTIT_threadpool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    FTI_ThreadPoolDrain(pool);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->finish, &pool->lock);
+    }
+    pool->nbTasks = 0;
+    pool->next = 0;
+    pthread_mutex_unlock(&pool->lock);
+
+    return FTI_SCES;
+}
+
+int FTI_ThreadPoolRun(FTIT_threadpool* pool, int nbTasks, FTIT_task task,
+ void* arg) {
+    FTI_ThreadPoolSubmit(pool, nbTasks, task, arg);
+    return FTI_ThreadPoolWait(pool);
+}
+
+int FTI_ThreadPoolFinalize(FTIT_threadpool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    int i;
+    for (i = 0; i < pool->nbWorkers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->nbWorkers = 0;
+
+    pthread_cond_destroy(&pool->finish);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+
+    return FTI_SCES;
+}
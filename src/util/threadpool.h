@@ -0,0 +1,144 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   threadpool.h
+ *  @date   October, 2026
+ *  @brief  methods for FTIT_threadpool, a fixed team of worker threads.
+ */
+
+#ifndef FTI_THREADPOOL_H_
+#define FTI_THREADPOOL_H_
+
+#include <pthread.h>
+
+/** Task executed by the thread pool, idx is the task index **/
+typedef void (*FTIT_task)(void* arg, int idx);
+
+/** @typedef    FTIT_threadpool
+ *  @brief      Team of worker threads executing indexed tasks.
+ *
+ *  A batch of 'nbTasks' tasks is submitted at once. The tasks are
+ *  distributed dynamically among the workers and the thread waiting for
+ *  the batch. Only one batch can be in flight at a time.
+ */
+typedef struct FTIT_threadpool {
+    int             nbWorkers;  /**< Number of worker threads             */
+    pthread_t*      workers;    /**< Worker threads                       */
+    pthread_mutex_t lock;
+    pthread_cond_t  start;      /**< Signaled when a batch is submitted   */
+    pthread_cond_t  finish;     /**< Signaled when a batch is completed   */
+    FTIT_task       task;       /**< Task of the current batch            */
+    void*           arg;        /**< Argument of the current batch        */
+    int             nbTasks;    /**< Number of tasks of the batch         */
+    int             next;       /**< Next task index to execute           */
+    int             pending;    /**< Tasks not yet completed              */
+    bool            stop;       /**< TRUE to terminate the workers        */
+} FTIT_threadpool;
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Initializes a thread pool.
+
+  Starts 'nbThreads' - 1 worker threads, the thread waiting for a batch
+  being the last member of the team. With 'nbThreads' <= 1 no thread is
+  started and batches are executed by the waiting thread.
+
+  @param        pool[out]   <b> FTIT_threadpool* </b> Pool instance.
+  @param        nbThreads   <b> int </b> Size of the team.
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_ThreadPoolInit(FTIT_threadpool* pool, int nbThreads);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Submits a batch of tasks without waiting for its completion.
+
+  @param        pool[in]    <b> FTIT_threadpool* </b> Pool instance.
+  @param        nbTasks     <b> int </b> Number of tasks.
+  @param        task        <b> FTIT_task </b> Function executed per task.
+  @param        arg         <b> void* </b> Argument passed to each task.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_ThreadPoolSubmit(FTIT_threadpool* pool, int nbTasks, FTIT_task task,
+ void* arg);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Waits for the completion of the submitted batch.
+
+  The calling thread executes pending tasks of the batch while waiting.
+
+  @param        pool[in]    <b> FTIT_threadpool* </b> Pool instance.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_ThreadPoolWait(FTIT_threadpool* pool);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Submits a batch of tasks and waits for its completion.
+
+  @param        pool[in]    <b> FTIT_threadpool* </b> Pool instance.
+  @param        nbTasks     <b> int </b> Number of tasks.
+  @param        task        <b> FTIT_task </b> Function executed per task.
+  @param        arg         <b> void* </b> Argument passed to each task.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_ThreadPoolRun(FTIT_threadpool* pool, int nbTasks, FTIT_task task,
+ void* arg);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Terminates the worker threads and releases the pool.
+
+  @param        pool[in]    <b> FTIT_threadpool* </b> Pool instance.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_ThreadPoolFinalize(FTIT_threadpool* pool);
+
+#endif  // FTI_THREADPOOL_H_
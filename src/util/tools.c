@@ -92,27 +92,11 @@ int FTI_InitExecVars(FTIT_configuration* FTI_Conf, FTIT_execution* FTI_Exec,
         FTIT_topology* FTI_Topo, FTIT_checkpoint* FTI_Ckpt,
         FTIT_injection* FTI_Inje) {
     // datablock size in file
-    FTI_filemetastructsize
-        = MD5_DIGEST_STRING_LENGTH
-        + MD5_DIGEST_LENGTH
-        + 7*sizeof(int32_t)
-        + sizeof(int);
-
-    // TODO(leobago) RS L3 only works for even file sizes.
-    // This accounts for many but clearly not all cases.
-    // This is to fix.
-    FTI_filemetastructsize += 2 - FTI_filemetastructsize%2;
-
-    FTI_dbstructsize
-        = sizeof(int)               /* numvars */
-        + sizeof(int32_t);             /* dbsize */
-
-    FTI_dbvarstructsize
-        = 2*sizeof(int)               /* numvars */
-        + 2*sizeof(bool)
-        + 2*sizeof(uintptr_t)
-        + 2*sizeof(int32_t)
-        + MD5_DIGEST_LENGTH;
+    FTIFF_layout layout;
+    FTIFF_GetLayout(&layout, FTIFF_VERSION);
+    FTI_filemetastructsize = layout.filemetasize;
+    FTI_dbstructsize = layout.dbsize;
+    FTI_dbvarstructsize = layout.dbvarsize;
 
     //
     //  init meta data variables
@@ -0,0 +1,192 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   trace.c
+ *  @date   October, 2026
+ *  @brief  timestamped spans of the FTI phases, in Chrome trace format.
+ *
+ *  Each process keeps its spans in memory and writes them at finalization
+ *  in 'fti-trace-<rank>.json', which can be opened in chrome://tracing or
+ *  Perfetto. The files of all processes are merged by
+ *  'scripts/fti_trace_merge.py'. The process id of the spans is the rank
+ *  in the global communicator, the thread id distinguishes the helper
+ *  threads (background writer, staging thread, thread pools).
+ */
+
+#include <inttypes.h>
+
+#include "../interface.h"
+
+/** State of the tracer of the process **/
+static struct {
+    bool                enabled;
+    char                fn[FTI_BUFS];   /**< Trace file of the process    */
+    int                 rank;
+    bool                head;
+    double              start;          /**< Time origin of the spans     */
+    pthread_mutex_t     lock;
+    FTIT_traceEvent*    events;
+    int                 nbEvents;
+    int                 capacity;
+    int64_t             dropped;        /**< Spans beyond the maximum     */
+    pthread_t           threads[FTI_TRACE_MAX_THREADS];
+    int                 nbThreads;
+} FTI_Trace = { .enabled = false, .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/* Index of the calling thread, 0 for the first one seen (lock held). */
+static int FTI_TraceThread() {
+    pthread_t self = pthread_self();
+    int i;
+    for (i = 0; i < FTI_Trace.nbThreads; i++) {
+        if (pthread_equal(FTI_Trace.threads[i], self)) {
+            return i;
+        }
+    }
+    if (FTI_Trace.nbThreads == FTI_TRACE_MAX_THREADS) {
+        return FTI_TRACE_MAX_THREADS - 1;
+    }
+    FTI_Trace.threads[FTI_Trace.nbThreads] = self;
+    return FTI_Trace.nbThreads++;
+}
+
+int FTI_TraceInit(const char* dir, int rank, bool head) {
+    if (dir == NULL || dir[0] == '\0') {
+        return FTI_SCES;
+    }
+    if (mkdir(dir, 0777) == -1 && errno != EEXIST) {
+        char str[FTI_BUFS];
+        snprintf(str, FTI_BUFS, "Cannot create the trace directory '%s',"
+         " tracing is disabled", dir);
+        FTI_Print(str, FTI_WARN);
+        return FTI_NSCS;
+    }
+    snprintf(FTI_Trace.fn, FTI_BUFS, "%s/fti-trace-%d.json", dir, rank);
+    FTI_Trace.rank = rank;
+    FTI_Trace.head = head;
+    FTI_Trace.nbEvents = 0;
+    FTI_Trace.capacity = 1024;
+    FTI_Trace.dropped = 0;
+    FTI_Trace.events = talloc(FTIT_traceEvent, FTI_Trace.capacity);
+    // the initializing thread is the main thread of the process
+    FTI_Trace.nbThreads = 0;
+    FTI_TraceThread();
+    FTI_Trace.start = MPI_Wtime();
+    FTI_Trace.enabled = true;
+    return FTI_SCES;
+}
+
+double FTI_TraceStart() {
+    return FTI_Trace.enabled ? MPI_Wtime() : 0;
+}
+
+void FTI_TraceSpan(const char* cat, const char* name, double t0,
+ int64_t arg) {
+    if (!FTI_Trace.enabled || t0 == 0) {
+        return;
+    }
+    double t1 = MPI_Wtime();
+
+    pthread_mutex_lock(&FTI_Trace.lock);
+    if (FTI_Trace.nbEvents == FTI_Trace.capacity) {
+        if (FTI_Trace.capacity == FTI_TRACE_MAX_EVENTS) {
+            FTI_Trace.dropped++;
+            pthread_mutex_unlock(&FTI_Trace.lock);
+            return;
+        }
+        FTI_Trace.capacity *= 2;
+        FTI_Trace.events = realloc(FTI_Trace.events,
+         sizeof(FTIT_traceEvent) * FTI_Trace.capacity);
+    }
+    FTIT_traceEvent* ev = &FTI_Trace.events[FTI_Trace.nbEvents++];
+    ev->name = name;
+    ev->cat = cat;
+    ev->ts = t0 - FTI_Trace.start;
+    ev->dur = t1 - t0;
+    ev->tid = FTI_TraceThread();
+    ev->arg = arg;
+    pthread_mutex_unlock(&FTI_Trace.lock);
+}
+
+int FTI_TraceFinalize() {
+    if (!FTI_Trace.enabled) {
+        return FTI_SCES;
+    }
+    pthread_mutex_lock(&FTI_Trace.lock);
+    FTI_Trace.enabled = false;
+    pthread_mutex_unlock(&FTI_Trace.lock);
+
+    int res = FTI_SCES;
+    FILE* fd = fopen(FTI_Trace.fn, "w");
+    if (fd == NULL) {
+        char str[FTI_BUFS];
+        snprintf(str, FTI_BUFS, "Cannot write the trace file '%s'",
+         FTI_Trace.fn);
+        FTI_Print(str, FTI_EROR);
+        res = FTI_NSCS;
+    } else {
+        int i;
+        fprintf(fd, "{\"traceEvents\":[\n");
+        fprintf(fd, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+         "\"tid\":0,\"args\":{\"name\":\"%s %d\"}}", FTI_Trace.rank,
+         FTI_Trace.head ? "head" : "rank", FTI_Trace.rank);
+        fprintf(fd, ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\","
+         "\"pid\":%d,\"tid\":0,\"args\":{\"sort_index\":%d}}",
+         FTI_Trace.rank, FTI_Trace.rank);
+        for (i = 1; i < FTI_Trace.nbThreads; i++) {
+            fprintf(fd, ",\n{\"name\":\"thread_name\",\"ph\":\"M\","
+             "\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"helper %d\"}}",
+             FTI_Trace.rank, i, i);
+        }
+        for (i = 0; i < FTI_Trace.nbEvents; i++) {
+            FTIT_traceEvent* ev = &FTI_Trace.events[i];
+            fprintf(fd, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+             "\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", ev->name,
+             ev->cat, FTI_Trace.rank, ev->tid, ev->ts * 1e6, ev->dur * 1e6);
+            if (ev->arg >= 0) {
+                fprintf(fd, ",\"args\":{\"arg\":%" PRId64 "}",
+                 ev->arg);
+            }
+            fprintf(fd, "}");
+        }
+        fprintf(fd, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":"
+         "{\"rank\":%d,\"dropped\":%" PRId64 "}}\n", FTI_Trace.rank,
+         FTI_Trace.dropped);
+        if (fclose(fd) != 0) {
+            res = FTI_NSCS;
+        }
+    }
+
+    free(FTI_Trace.events);
+    FTI_Trace.events = NULL;
+    return res;
+}
@@ -0,0 +1,120 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  @file   trace.h
+ *  @date   October, 2026
+ *  @brief  timestamped spans of the FTI phases, in Chrome trace format.
+ */
+
+#ifndef FTI_TRACE_H_
+#define FTI_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Events kept per process, the next ones are dropped **/
+#define FTI_TRACE_MAX_EVENTS (1024 * 1024)
+
+/** Threads distinguished in the trace, the next ones share the last id **/
+#define FTI_TRACE_MAX_THREADS 64
+
+/** @typedef    FTIT_traceEvent
+ *  @brief      Phase recorded by the tracer.
+ *
+ *  'name' and 'cat' must be static strings, they are not copied.
+ */
+typedef struct FTIT_traceEvent {
+    const char*     name;       /**< Phase name                           */
+    const char*     cat;        /**< Category of the phase                */
+    double          ts;         /**< Start (sec.) since the trace start   */
+    double          dur;        /**< Duration (sec.)                      */
+    int             tid;        /**< Index of the recording thread        */
+    int64_t         arg;        /**< Phase argument, -1 if none           */
+} FTIT_traceEvent;
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Starts recording the spans of this process.
+
+  Must be called at the same time on all processes (e.g. after a barrier),
+  the spans are relative to the time of the call.
+
+  @param        dir         <b> char* </b> Directory of the trace files.
+  @param        rank        <b> int </b> Rank in the global communicator.
+  @param        head        <b> bool </b> TRUE for a head process.
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_TraceInit(const char* dir, int rank, bool head);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Returns the start time of a span.
+
+  @return                       Current time, 0 if tracing is disabled.
+
+
+--------------------------------------------------------------------------**/
+double FTI_TraceStart();
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Records a span ending now. Thread safe.
+
+  @param        cat         <b> char* </b> Category (static string).
+  @param        name        <b> char* </b> Phase name (static string).
+  @param        t0          <b> double </b> Value of FTI_TraceStart.
+  @param        arg         <b> int64_t </b> Argument (id, level, size).
+
+
+--------------------------------------------------------------------------**/
+void FTI_TraceSpan(const char* cat, const char* name, double t0, int64_t arg);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Writes the trace file of this process and stops recording.
+
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_TraceFinalize();
+
+#endif  // FTI_TRACE_H_
@@ -57,7 +57,8 @@ int copyDataFromDevive(FTIT_execution* FTI_Exec, FTIT_keymap* FTI_Data) {
 #ifdef GPUSUPPORT
 
     FTIT_dataset* data;
-    if (FTI_Data->data(&data, FTI_Exec->nbVar) != FTI_SCES) return FTI_NSCS;
+    if (FTI_Data->data(FTI_Data, &data, FTI_Exec->nbVar) != FTI_SCES)
+        return FTI_NSCS;
 
     int i; for (i = 0; i < FTI_Exec->nbVar; i++) {
         if (data[i].isDevicePtr) {
@@ -0,0 +1,148 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  @file   workqueue.c
+ *  @date   October, 2026
+ *  @brief  methods for FTIT_workqueue, a FIFO of jobs run by one thread.
+ */
+
+#include "../interface.h"
+
+static void* FTI_WorkQueueWorker(void* arg) {
+    FTIT_workqueue* wq = (FTIT_workqueue*) arg;
+
+    pthread_mutex_lock(&wq->lock);
+    while (1) {
+        while (wq->head == NULL && !wq->stop) {
+            pthread_cond_wait(&wq->push, &wq->lock);
+        }
+        // pending jobs are completed before stopping
+        if (wq->head == NULL) break;
+
+        FTIT_workitem* item = wq->head;
+        wq->head = item->next;
+        if (wq->head == NULL) wq->tail = NULL;
+        pthread_mutex_unlock(&wq->lock);
+
+        item->job(item->arg);
+        free(item);
+
+        pthread_mutex_lock(&wq->lock);
+        if (--wq->pending == 0) {
+            pthread_cond_broadcast(&wq->idle);
+        }
+    }
+    pthread_mutex_unlock(&wq->lock);
+    return NULL;
+}
+
+int FTI_WorkQueueInit(FTIT_workqueue* wq, bool threaded) {
+    if (wq == NULL) {
+        FTI_Print("work queue context is NULL", FTI_WARN);
+        return FTI_NSCS;
+    }
+
+    memset(wq, 0x0, sizeof(FTIT_workqueue));
+    pthread_mutex_init(&wq->lock, NULL);
+    pthread_cond_init(&wq->push, NULL);
+    pthread_cond_init(&wq->idle, NULL);
+
+    if (!threaded) return FTI_SCES;
+
+    if (pthread_create(&wq->worker, NULL, FTI_WorkQueueWorker, wq) != 0) {
+        FTI_Print("unable to start the work queue thread, jobs will be"
+         " executed synchronously", FTI_WARN);
+        return FTI_SCES;
+    }
+    wq->threaded = true;
+
+    return FTI_SCES;
+}
+
+int FTI_WorkQueuePush(FTIT_workqueue* wq, FTIT_job job, void* arg) {
+    if (!wq->threaded) {
+        job(arg);
+        return FTI_SCES;
+    }
+
+    FTIT_workitem* item = talloc(FTIT_workitem, 1);
+    item->job = job;
+    item->arg = arg;
+    item->next = NULL;
+
+    pthread_mutex_lock(&wq->lock);
+    if (wq->tail == NULL) {
+        wq->head = item;
+    } else {
+        wq->tail->next = item;
+    }
+    wq->tail = item;
+    wq->pending++;
+    pthread_cond_signal(&wq->push);
+    pthread_mutex_unlock(&wq->lock);
+
+    return FTI_SCES;
+}
+
+int FTI_WorkQueuePending(FTIT_workqueue* wq) {
+    pthread_mutex_lock(&wq->lock);
+    int pending = wq->pending;
+    pthread_mutex_unlock(&wq->lock);
+    return pending;
+}
+
+int FTI_WorkQueueDrain(FTIT_workqueue* wq) {
+    pthread_mutex_lock(&wq->lock);
+    while (wq->pending > 0) {
+        pthread_cond_wait(&wq->idle, &wq->lock);
+    }
+    pthread_mutex_unlock(&wq->lock);
+
+    return FTI_SCES;
+}
+
+int FTI_WorkQueueFinalize(FTIT_workqueue* wq) {
+    if (wq->threaded) {
+        pthread_mutex_lock(&wq->lock);
+        wq->stop = true;
+        pthread_cond_signal(&wq->push);
+        pthread_mutex_unlock(&wq->lock);
+        pthread_join(wq->worker, NULL);
+        wq->threaded = false;
+    }
+
+    pthread_cond_destroy(&wq->idle);
+    pthread_cond_destroy(&wq->push);
+    pthread_mutex_destroy(&wq->lock);
+
+    return FTI_SCES;
+}
@@ -0,0 +1,139 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  FTI - A multi-level checkpointing library for C/C++/Fortran applications
+ *
+ *  Revision 1.0 : Fault Tolerance Interface (FTI)
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *  list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *  this list of conditions and the following disclaimer in the documentation
+ *  and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its contributors
+ *  may be used to endorse or promote products derived from this software without
+ *  specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  @file   workqueue.h
+ *  @date   October, 2026
+ *  @brief  methods for FTIT_workqueue, a FIFO of jobs run by one thread.
+ */
+
+#ifndef FTI_WORKQUEUE_H_
+#define FTI_WORKQUEUE_H_
+
+#include <pthread.h>
+
+/** Job executed by the work queue **/
+typedef void (*FTIT_job)(void* arg);
+
+/** Queued job **/
+typedef struct FTIT_workitem {
+    FTIT_job                job;
+    void*                   arg;
+    struct FTIT_workitem*   next;
+} FTIT_workitem;
+
+/** @typedef    FTIT_workqueue
+ *  @brief      Jobs executed in submission order by a worker thread.
+ *
+ *  Unlike FTIT_threadpool, jobs are pushed one at a time while earlier
+ *  ones are still running, so the submitting thread never waits for
+ *  them. The argument of a job is released by the job itself.
+ */
+typedef struct FTIT_workqueue {
+    pthread_t       worker;     /**< Worker thread                        */
+    bool            threaded;   /**< FALSE if jobs run in the caller      */
+    pthread_mutex_t lock;
+    pthread_cond_t  push;       /**< Signaled when a job is pushed        */
+    pthread_cond_t  idle;       /**< Signaled when the queue gets empty   */
+    FTIT_workitem*  head;       /**< Next job to execute                  */
+    FTIT_workitem*  tail;       /**< Last job pushed                      */
+    int             pending;    /**< Jobs queued or running               */
+    bool            stop;       /**< TRUE to terminate the worker         */
+} FTIT_workqueue;
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Initializes a work queue.
+
+  If 'threaded' is FALSE or the worker cannot be started, the jobs are
+  executed by the thread pushing them.
+
+  @param        wq[out]     <b> FTIT_workqueue* </b> Queue instance.
+  @param        threaded    <b> bool </b> TRUE to start the worker.
+  @return                       \ref FTI_SCES if successful.
+                                \ref FTI_NSCS on failure.
+
+
+--------------------------------------------------------------------------**/
+int FTI_WorkQueueInit(FTIT_workqueue* wq, bool threaded);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Appends a job to the queue.
+
+  @param        wq[in]      <b> FTIT_workqueue* </b> Queue instance.
+  @param        job         <b> FTIT_job </b> Function to execute.
+  @param        arg         <b> void* </b> Argument of the job.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_WorkQueuePush(FTIT_workqueue* wq, FTIT_job job, void* arg);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Returns the number of jobs queued or running.
+
+  @param        wq[in]      <b> FTIT_workqueue* </b> Queue instance.
+  @return                       Number of pending jobs.
+
+
+--------------------------------------------------------------------------**/
+int FTI_WorkQueuePending(FTIT_workqueue* wq);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Waits until all the pushed jobs are completed.
+
+  @param        wq[in]      <b> FTIT_workqueue* </b> Queue instance.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_WorkQueueDrain(FTIT_workqueue* wq);
+
+/**--------------------------------------------------------------------------
+
+
+  @brief Completes the pending jobs and terminates the worker.
+
+  @param        wq[in]      <b> FTIT_workqueue* </b> Queue instance.
+  @return                       \ref FTI_SCES if successful.
+
+
+--------------------------------------------------------------------------**/
+int FTI_WorkQueueFinalize(FTIT_workqueue* wq);
+
+#endif  // FTI_WORKQUEUE_H_
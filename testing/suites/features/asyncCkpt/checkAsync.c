@@ -0,0 +1,131 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   checkAsync.c
+ *  @date   October, 2026
+ *  @brief  FTI testing program for the background L1 checkpoints.
+ *
+ *	The program takes two L1 checkpoints and overwrites the protected
+ *	data right after each of them, while the checkpoint may still be
+ *	written in the background:
+ *	  - checkpoint 1 holds generation 1 of the data
+ *	  - checkpoint 2 holds generation 2 of the data
+ *	Without interruption, the data is recovered in the same run and must
+ *	be generation 2. With interruption, the program exits before a
+ *	background checkpoint 2 is completed. The next run must recover the
+ *	expected generation, never a mix of generations.
+ *
+ *	The program takes three arguments:
+ *	  - arg1: FTI configuration file
+ *	  - arg2: Interrupt yes/no (1/0)
+ *	  - arg3: Generation recovered after the interruption (1, 2)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../../../src/deps/iniparser/dictionary.h"
+#include "../../../../src/deps/iniparser/iniparser.h"
+#include "fti.h"
+#include "mpi.h"
+
+#define RECOVERY_FAILED 20
+#define DATA_CORRUPT 30
+#define INIT 0
+
+#define FIELD_SIZE (1200 * 1024)
+#define ARRAY_SIZE 4099
+
+double *field;
+int *iarray;
+
+void setData(int rank, int gen) {
+  int i;
+  for (i = 0; i < FIELD_SIZE; i++) field[i] = 0.25 * i + rank + gen * 1e7;
+  for (i = 0; i < ARRAY_SIZE; i++) iarray[i] = i % 17 + rank + gen * 1000;
+}
+
+/* Returns the generation of the data, -1 if the data is not consistent */
+int checkData(int rank) {
+  int i, gen = (iarray[0] - rank) / 1000;
+  for (i = 0; i < FIELD_SIZE; i++) {
+    if (field[i] != 0.25 * i + rank + gen * 1e7) return -1;
+  }
+  for (i = 0; i < ARRAY_SIZE; i++) {
+    if (iarray[i] != i % 17 + rank + gen * 1000) return -1;
+  }
+  return gen;
+}
+
+void protectData() {
+  FTI_Protect(0, field, FIELD_SIZE, FTI_DBLE);
+  FTI_Protect(1, iarray, ARRAY_SIZE, FTI_INTG);
+}
+
+int main(int argc, char *argv[]) {
+  int rank, grank, crash, expected, correct = 1;
+
+  field = (double *)malloc(sizeof(double) * FIELD_SIZE);
+  iarray = (int *)malloc(sizeof(int) * ARRAY_SIZE);
+
+  MPI_Init(&argc, &argv);
+  if (FTI_Init(argv[1], MPI_COMM_WORLD) == FTI_NREC) {
+    exit(RECOVERY_FAILED);
+  }
+
+  crash = atoi(argv[2]);
+  expected = atoi(argv[3]);
+
+  MPI_Comm_rank(FTI_COMM_WORLD, &rank);
+  MPI_Comm_rank(MPI_COMM_WORLD, &grank);
+  dictionary *ini = iniparser_load(argv[1]);
+  int nbHeads = (int)iniparser_getint(ini, "Basic:head", -1);
+  int finalTag = (int)iniparser_getint(ini, "Advanced:final_tag", 3107);
+  int nodeSize = (int)iniparser_getint(ini, "Basic:node_size", -1);
+  int headRank = grank - grank % nodeSize;
+  iniparser_freedict(ini);
+
+  if (FTI_Status() == INIT) {
+    protectData();
+    setData(rank, 1);
+    FTI_Checkpoint(1, 1);
+    setData(rank, 2);
+    FTI_Checkpoint(2, 1);
+    setData(rank, 3);
+    if (crash) {
+      if (nbHeads > 0) {
+        int value = FTI_ENDW;
+        MPI_Send(&value, 1, MPI_INT, headRank, finalTag, MPI_COMM_WORLD);
+        MPI_Barrier(MPI_COMM_WORLD);
+      }
+      MPI_Finalize();
+      exit(0);
+    }
+    if (FTI_Recover() != FTI_SCES) {
+      exit(RECOVERY_FAILED);
+    }
+    correct = (checkData(rank) == 2);
+  } else {
+    protectData();
+    if (FTI_Recover() != FTI_SCES) {
+      exit(RECOVERY_FAILED);
+    }
+    correct = (checkData(rank) == expected);
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &correct, 1, MPI_INT, MPI_LAND, FTI_COMM_WORLD);
+  if (rank == 0) {
+    printf(correct ? "[SUCCESSFUL]\n" : "[NOT SUCCESSFUL]\n");
+  }
+
+  FTI_Finalize();
+  MPI_Finalize();
+
+  free(field);
+  free(iarray);
+
+  if (correct != 1) exit(DATA_CORRUPT);
+  return 0;
+}
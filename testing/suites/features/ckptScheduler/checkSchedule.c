@@ -0,0 +1,128 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   checkSchedule.c
+ *  @date   October, 2026
+ *  @brief  FTI testing program for the checkpoint scheduler.
+ *
+ *	The program takes checkpoints of one level and checks, after each of
+ *	them, the interval returned by FTI_GetCkptSchedule:
+ *	  - with the scheduler, the cost of the level is measured and the
+ *	    interval is the Young/Daly optimum for the cost and the MTBF
+ *	  - without the scheduler, the interval is the configured one
+ *	The MTBF is then changed with FTI_SetMtbf and the interval checked
+ *	again. The intervals of the other levels must not change.
+ *
+ *	The program takes four arguments:
+ *	  - arg1: FTI configuration file
+ *	  - arg2: Checkpoint level
+ *	  - arg3: MTBF of the level in minutes
+ *	  - arg4: Scheduler enabled yes/no (1/0)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fti.h"
+#include "mpi.h"
+
+#define SCHEDULE_WRONG 30
+
+#define FIELD_SIZE (1024 * 1024)
+#define NB_CKPTS 3
+
+/* Young/Daly interval in minutes for a cost in sec. and a MTBF in min. */
+int dalyInterval(double cost, double mtbf) {
+  double m = mtbf * 60, t = m;
+  if (cost < 2 * m) {
+    double r = cost / (2 * m);
+    t = sqrt(2 * cost * m) * (1 + sqrt(r) / 3 + r / 9) - cost;
+  }
+  int minutes = rint(t / 60);
+  return (minutes < 1) ? 1 : minutes;
+}
+
+/* Checks the schedule against the configured intervals and the level */
+int checkSchedule(int *configured, int level, double mtbf, int scheduler) {
+  FTIT_schedule schedule;
+  int i, correct = (FTI_GetCkptSchedule(&schedule) == FTI_SCES);
+  for (i = 1; i < 5; i++) {
+    if (i != level) {
+      correct &= (schedule.interval[i] == configured[i]);
+      continue;
+    }
+    if (!scheduler) {
+      correct &= (schedule.interval[i] == configured[i]);
+      correct &= (schedule.cost[i] == 0);
+      continue;
+    }
+    correct &= (schedule.cost[i] > 0 && schedule.mtbf[i] == mtbf);
+    correct &= (schedule.interval[i] == dalyInterval(schedule.cost[i], mtbf));
+    // the schedule must be the same on all processes
+    double cost[2] = {schedule.cost[i], -schedule.cost[i]};
+    MPI_Allreduce(MPI_IN_PLACE, cost, 2, MPI_DOUBLE, MPI_MAX,
+                  FTI_COMM_WORLD);
+    correct &= (cost[0] == -cost[1]);
+  }
+  if (!correct) {
+    printf("L%d: interval %d min., cost %f sec., MTBF %f min.\n", level,
+           schedule.interval[level], schedule.cost[level],
+           schedule.mtbf[level]);
+  }
+  return correct;
+}
+
+int main(int argc, char *argv[]) {
+  int rank, level, scheduler, correct = 1;
+  double mtbf;
+
+  MPI_Init(&argc, &argv);
+  if (FTI_Init(argv[1], MPI_COMM_WORLD) != FTI_SCES) {
+    exit(SCHEDULE_WRONG);
+  }
+  MPI_Comm_rank(FTI_COMM_WORLD, &rank);
+
+  level = atoi(argv[2]);
+  mtbf = atof(argv[3]);
+  scheduler = atoi(argv[4]);
+
+  double *field = (double *)malloc(sizeof(double) * FIELD_SIZE);
+  int i;
+  for (i = 0; i < FIELD_SIZE; i++) field[i] = 0.5 * i + rank;
+  FTI_Protect(0, field, FIELD_SIZE, FTI_DBLE);
+
+  int configured[5];
+  FTIT_schedule schedule;
+  FTI_GetCkptSchedule(&schedule);
+  for (i = 1; i < 5; i++) configured[i] = schedule.interval[i];
+
+  for (i = 1; i <= NB_CKPTS; i++) {
+    correct &= (FTI_Checkpoint(i, level) == FTI_DONE);
+    correct &= checkSchedule(configured, level, mtbf, scheduler);
+  }
+
+  // a larger MTBF gives a longer interval
+  FTI_GetCkptSchedule(&schedule);
+  int before = schedule.interval[level];
+  correct &= (FTI_SetMtbf(level, mtbf * 100) == FTI_SCES);
+  correct &= checkSchedule(configured, level, mtbf * 100, scheduler);
+  FTI_GetCkptSchedule(&schedule);
+  if (scheduler) {
+    correct &= (schedule.interval[level] >= before);
+  }
+  correct &= (FTI_SetMtbf(5, mtbf) != FTI_SCES);
+
+  MPI_Allreduce(MPI_IN_PLACE, &correct, 1, MPI_INT, MPI_LAND, FTI_COMM_WORLD);
+  if (rank == 0) {
+    printf(correct ? "[SUCCESSFUL]\n" : "[NOT SUCCESSFUL]\n");
+  }
+
+  FTI_Finalize();
+  MPI_Finalize();
+  free(field);
+
+  if (correct != 1) exit(SCHEDULE_WRONG);
+  return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   checkCodec.c
+ *  @date   October, 2026
+ *  @brief  FTI testing program for the dataset codecs.
+ *
+ *	The program protects datasets with different codecs, checkpoints
+ *	them and checks the recovered data fields:
+ *	  - 0: smooth double field over several codec frames (default codec)
+ *	  - 1: integer array (FTI_CODEC_NONE)
+ *	  - 2: double array (FTI_CODEC_SHUFFLE)
+ *	  - 3: random bytes, not compressible (FTI_CODEC_ZLIB)
+ *
+ *	The program takes four arguments:
+ *	  - arg1: FTI configuration file
+ *	  - arg2: Interrupt yes/no (1/0)
+ *	  - arg3: Checkpoint level (1, 2, 3, 4)
+ *	  - arg4: Recover with FTI_RecoverVar yes/no (1/0)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../../../src/deps/iniparser/dictionary.h"
+#include "../../../../src/deps/iniparser/iniparser.h"
+#include "fti.h"
+#include "mpi.h"
+
+#define RECOVERY_FAILED 20
+#define DATA_CORRUPT 30
+#define INIT 0
+
+#define NB_VARS 4
+#define FIELD_SIZE (1200 * 1024)
+#define ARRAY_SIZE 4099
+#define BYTES_SIZE 70001
+
+double *field, *darray;
+int *iarray;
+unsigned char *bytes;
+
+void initData(int rank) {
+  int i;
+  for (i = 0; i < FIELD_SIZE; i++) field[i] = sin(i * 1e-4) + rank;
+  for (i = 0; i < ARRAY_SIZE; i++) iarray[i] = i % 17 + rank;
+  for (i = 0; i < ARRAY_SIZE; i++) darray[i] = 0.5 * i + rank;
+  srand(rank + 1);
+  for (i = 0; i < BYTES_SIZE; i++) bytes[i] = rand() & 0xff;
+}
+
+void protectData() {
+  FTIT_attribute attr;
+  FTI_Protect(0, field, FIELD_SIZE, FTI_DBLE);
+  FTI_Protect(1, iarray, ARRAY_SIZE, FTI_INTG);
+  FTI_Protect(2, darray, ARRAY_SIZE, FTI_DBLE);
+  FTI_Protect(3, bytes, BYTES_SIZE, FTI_CHAR);
+  attr.codec = FTI_CODEC_NONE;
+  FTI_SetAttribute(1, attr, FTI_ATTRIBUTE_CODEC);
+  attr.codec = FTI_CODEC_SHUFFLE;
+  FTI_SetAttribute(2, attr, FTI_ATTRIBUTE_CODEC);
+  attr.codec = FTI_CODEC_ZLIB;
+  FTI_SetAttribute(3, attr, FTI_ATTRIBUTE_CODEC);
+}
+
+int main(int argc, char *argv[]) {
+  int rank, grank, crash, level, recoverVar, correct = 1;
+
+  field = (double *)malloc(sizeof(double) * FIELD_SIZE);
+  darray = (double *)malloc(sizeof(double) * ARRAY_SIZE);
+  iarray = (int *)malloc(sizeof(int) * ARRAY_SIZE);
+  bytes = (unsigned char *)malloc(BYTES_SIZE);
+
+  MPI_Init(&argc, &argv);
+  if (FTI_Init(argv[1], MPI_COMM_WORLD) == FTI_NREC) {
+    exit(RECOVERY_FAILED);
+  }
+
+  crash = atoi(argv[2]);
+  level = atoi(argv[3]);
+  recoverVar = atoi(argv[4]);
+
+  MPI_Comm_rank(FTI_COMM_WORLD, &rank);
+  MPI_Comm_rank(MPI_COMM_WORLD, &grank);
+  dictionary *ini = iniparser_load(argv[1]);
+  int nbHeads = (int)iniparser_getint(ini, "Basic:head", -1);
+  int finalTag = (int)iniparser_getint(ini, "Advanced:final_tag", 3107);
+  int nodeSize = (int)iniparser_getint(ini, "Basic:node_size", -1);
+  int headRank = grank - grank % nodeSize;
+  iniparser_freedict(ini);
+
+  if (FTI_Status() == INIT) {
+    initData(rank);
+    protectData();
+    FTI_Checkpoint(1, level);
+    if (crash) {
+      if (nbHeads > 0) {
+        int value = FTI_ENDW;
+        MPI_Send(&value, 1, MPI_INT, headRank, finalTag, MPI_COMM_WORLD);
+        MPI_Barrier(MPI_COMM_WORLD);
+      }
+      MPI_Finalize();
+      exit(0);
+    }
+  } else {
+    protectData();
+    int res = FTI_SCES;
+    if (recoverVar) {
+      int i;
+      res = FTI_RecoverVarInit();
+      for (i = NB_VARS - 1; i >= 0; i--) res += FTI_RecoverVar(i);
+      res += FTI_RecoverVarFinalize();
+    } else {
+      res = FTI_Recover();
+    }
+    if (res != FTI_SCES) {
+      exit(RECOVERY_FAILED);
+    }
+
+    double *refField = field, *refDarray = darray;
+    int *refIarray = iarray;
+    unsigned char *refBytes = bytes;
+    field = (double *)malloc(sizeof(double) * FIELD_SIZE);
+    darray = (double *)malloc(sizeof(double) * ARRAY_SIZE);
+    iarray = (int *)malloc(sizeof(int) * ARRAY_SIZE);
+    bytes = (unsigned char *)malloc(BYTES_SIZE);
+    initData(rank);
+    correct &= !memcmp(field, refField, sizeof(double) * FIELD_SIZE);
+    correct &= !memcmp(iarray, refIarray, sizeof(int) * ARRAY_SIZE);
+    correct &= !memcmp(darray, refDarray, sizeof(double) * ARRAY_SIZE);
+    correct &= !memcmp(bytes, refBytes, BYTES_SIZE);
+    free(refField);
+    free(refDarray);
+    free(refIarray);
+    free(refBytes);
+
+    MPI_Allreduce(MPI_IN_PLACE, &correct, 1, MPI_INT, MPI_LAND,
+                  FTI_COMM_WORLD);
+    if (rank == 0) {
+      printf(correct ? "[SUCCESSFUL]\n" : "[NOT SUCCESSFUL]\n");
+    }
+  }
+
+  FTI_Finalize();
+  MPI_Finalize();
+
+  free(field);
+  free(darray);
+  free(iarray);
+  free(bytes);
+
+  if (correct != 1) exit(DATA_CORRUPT);
+  return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ *  Copyright (c) 2017 Leonardo A. Bautista-Gomez
+ *  All rights reserved
+ *
+ *  @file   checkMetrics.c
+ *  @date   October, 2026
+ *  @brief  FTI testing program for the checkpoint metrics.
+ *
+ *	On a first run, the program takes checkpoints of one level and checks
+ *	the metrics returned by FTI_GetMetrics for the process, the node and
+ *	the whole execution. With dCP, a quarter of the data is changed between
+ *	two checkpoints. On a restart, the program recovers the data and checks
+ *	that the recovery is accounted.
+ *
+ *	The program takes three arguments:
+ *	  - arg1: FTI configuration file
+ *	  - arg2: Checkpoint level
+ *	  - arg3: dCP checkpoints yes/no (1/0)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fti.h"
+#include "mpi.h"
+
+#define METRICS_WRONG 30
+
+#define FIELD_SIZE (256 * 1024)
+#define NB_CKPTS 3
+
+/* Checks that the histogram holds 'count' durations */
+int checkHistogram(FTIT_histogram *hist, uint64_t count) {
+  uint64_t sum = 0;
+  int i;
+  for (i = 0; i < FTI_METRICS_BINS; i++) sum += hist->bins[i];
+  return sum == count && hist->count == count &&
+         hist->sum >= 0 && hist->max <= hist->sum;
+}
+
+/* Checks the metrics of 'nbProcs' processes after the checkpoints */
+int checkCkpts(FTIT_metrics *m, int level, int dcp, int nbProcs) {
+  uint64_t bytes = (uint64_t)NB_CKPTS * FIELD_SIZE * sizeof(double) * nbProcs;
+  int i, correct = (m->nbProcs == nbProcs && m->failed == 0);
+  for (i = 1; i < 5; i++) {
+    uint64_t ckpts = (i == level) ? NB_CKPTS * nbProcs : 0;
+    correct &= (m->ckpts[i] == ckpts);
+    if (i != level) correct &= (m->bytes[i] == 0);
+  }
+  correct &= checkHistogram(&m->write, NB_CKPTS * nbProcs);
+  correct &= checkHistogram(&m->recover, 0);
+  if (dcp) {
+    correct &= (m->dcpCkpts == NB_CKPTS * nbProcs && m->dcpBytes == bytes);
+    correct &= (m->dcpDirty < m->dcpBytes && m->bytes[level] == m->dcpDirty);
+    correct &= (m->dcpRatio > 0 && m->dcpRatio < 0.5);
+  } else {
+    correct &= (m->dcpCkpts == 0 && m->bytes[level] >= bytes);
+  }
+  if (!correct) {
+    printf("%d procs: %lu ckpts, %lu bytes, %lu dCP, %lu dirty, %f ratio\n",
+           m->nbProcs, (unsigned long)m->ckpts[level],
+           (unsigned long)m->bytes[level], (unsigned long)m->dcpCkpts,
+           (unsigned long)m->dcpDirty, m->dcpRatio);
+  }
+  return correct;
+}
+
+int main(int argc, char *argv[]) {
+  int rank, nbProcs, level, dcp, correct = 1;
+  FTIT_metrics local, node, global;
+
+  MPI_Init(&argc, &argv);
+  if (FTI_Init(argv[1], MPI_COMM_WORLD) != FTI_SCES) {
+    exit(METRICS_WRONG);
+  }
+  MPI_Comm_rank(FTI_COMM_WORLD, &rank);
+  MPI_Comm_size(FTI_COMM_WORLD, &nbProcs);
+
+  level = atoi(argv[2]);
+  dcp = atoi(argv[3]);
+
+  double *field = (double *)malloc(sizeof(double) * FIELD_SIZE);
+  int i, j;
+  for (i = 0; i < FIELD_SIZE; i++) field[i] = 0.5 * i + rank;
+  FTI_Protect(0, field, FIELD_SIZE, FTI_DBLE);
+
+  if (FTI_Status() == 0) {
+    for (i = 1; i <= NB_CKPTS; i++) {
+      for (j = 0; j < FIELD_SIZE / 4; j++) field[j] += 1;
+      correct &= (FTI_Checkpoint(i, dcp ? FTI_L4_DCP : level) == FTI_DONE);
+    }
+    correct &= (FTI_GetMetrics(&local, FTI_METRICS_LOCAL) == FTI_SCES);
+    correct &= (FTI_GetMetrics(&node, FTI_METRICS_NODE) == FTI_SCES);
+    correct &= (FTI_GetMetrics(&global, FTI_METRICS_GLOBAL) == FTI_SCES);
+    correct &= checkCkpts(&local, level, dcp, 1);
+    correct &= checkCkpts(&node, level, dcp, node.nbProcs);
+    correct &= checkCkpts(&global, level, dcp, nbProcs);
+    correct &= (nbProcs % node.nbProcs == 0);
+    correct &= (local.uptime > 0 && global.uptime >= local.uptime);
+  } else {
+    correct &= (FTI_Recover() == FTI_SCES);
+    correct &= (FTI_GetMetrics(&global, FTI_METRICS_GLOBAL) == FTI_SCES);
+    correct &= checkHistogram(&global.recover, nbProcs);
+    correct &= checkHistogram(&global.write, 0);
+  }
+  correct &= (FTI_GetMetrics(&local, 3) != FTI_SCES);
+
+  MPI_Allreduce(MPI_IN_PLACE, &correct, 1, MPI_INT, MPI_LAND, FTI_COMM_WORLD);
+  if (rank == 0) {
+    printf(correct ? "[SUCCESSFUL]\n" : "[NOT SUCCESSFUL]\n");
+  }
+
+  FTI_Finalize();
+  MPI_Finalize();
+  free(field);
+
+  if (correct != 1) exit(METRICS_WRONG);
+  return 0;
+}